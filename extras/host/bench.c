@@ -0,0 +1,265 @@
+/*
+ * File      : bench.c
+ * This file is part of RT-Thread GUI Engine
+ * COPYRIGHT (C) 2006 - 2017, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2019-07-15     onelife      first version, for host build
+ */
+/* Host benchmark of framebuffer ops on the simulated display.
+ *
+ * usage: rttgui_bench [rgb565|rgb888]
+ * Mpixel/s of driver ops (new) against the one pixel a time loops they
+ * replaced (old) for hline, vline and fill_rect. Both are called by ops with
+ * bounds known at run time only, as in driver. Exit code is 0 when both draw
+ * same pixels. */
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "include/rtgui.h"
+#include "include/simulator.h"
+
+#ifndef RTGUI_USING_FRAMEBUFFER
+# error "RTGUI_USING_FRAMEBUFFER is required"
+#endif
+
+/* Private typedef -----------------------------------------------------------*/
+struct bench_case {
+    const char *name;
+    void (*run)(const struct rtgui_graphic_driver_ops *ops, rtgui_color_t *c,
+        int i);
+    rt_uint32_t pixels;                     /* per call */
+    int num;                                /* calls to cover the case */
+};
+
+/* Private define ------------------------------------------------------------*/
+#define LCD_WIDTH                   (240)
+#define LCD_HEIGHT                  (320)
+#define BENCH_MIN_NS                (40 * 1000 * 1000)
+/* best of rounds, old and new by turns, against noise of host */
+#define BENCH_ROUNDS                (7)
+#define BENCH_COLOR                 RTGUI_RGB(0x12, 0x34, 0x56)
+/* unaligned short span, for alignment head and tail */
+#define SHORT_X                     (1)
+#define SHORT_LEN                   (17)
+/* span shorter than the plain loop threshold of driver */
+#define TINY_X                      (1)
+#define TINY_LEN                    (5)
+/* as the old driver, which gets the device by call */
+#define display()                   rtgui_get_gfx_device()
+#define PIXEL(x, y)                 (display()->framebuffer + \
+                                    display()->pitch * (y) + \
+                                    _BIT2BYTE(display()->bits_per_pixel) * (x))
+
+/* Private variables ---------------------------------------------------------*/
+static rt_uint64_t _fb64[LCD_WIDTH * LCD_HEIGHT / 2];
+static rt_uint8_t *_fb = (rt_uint8_t *)_fb64;
+static rt_uint8_t _ref[sizeof(_fb64)];
+static rtgui_gfx_driver_t *_drv;
+
+/* Private functions ---------------------------------------------------------*/
+/* old ops, the one pixel a time loops replaced in driver */
+static void _old_hline16(rtgui_color_t *c, int x1, int x2, int y) {
+    rt_uint16_t pixel = rtgui_color_to_565(*c);
+    rt_uint16_t *ptr = (rt_uint16_t *)PIXEL(x1, y);
+    int x;
+
+    for (x = x1; x < x2; x++, ptr++)
+        *ptr = pixel;
+}
+
+static void _old_vline16(rtgui_color_t *c, int x , int y1, int y2) {
+    rt_uint16_t pixel = rtgui_color_to_565(*c);
+    rt_uint16_t *ptr = (rt_uint16_t *)PIXEL(x, y1);
+    int y;
+
+    for (y = y1; y < y2; y++, ptr += display()->width)
+        *ptr = pixel;
+}
+
+static void _old_rect16(rtgui_color_t *c, rtgui_rect_t *rect) {
+    rt_uint16_t pixel = rtgui_color_to_565(*c);
+    rt_uint8_t *line = PIXEL(rect->x1, rect->y1);
+    rt_uint16_t *ptr;
+    int x, y;
+
+    for (y = rect->y1; y < rect->y2; y++, line += display()->pitch)
+        for (x = rect->x1, ptr = (rt_uint16_t *)line; x < rect->x2; x++)
+            *ptr++ = pixel;
+}
+
+static void _old_hline32(rtgui_color_t *c, int x1, int x2, int y) {
+    rtgui_color_t *ptr = (rtgui_color_t *)PIXEL(x1, y);
+    int x;
+
+    for (x = x1; x < x2; x++, ptr++)
+        *ptr = *c;
+}
+
+static void _old_vline32(rtgui_color_t *c, int x, int y1, int y2) {
+    rtgui_color_t *ptr = (rtgui_color_t *)PIXEL(x, y1);
+    int y;
+
+    for (y = y1; y < y2; y++, ptr += display()->width)
+        *ptr = *c;
+}
+
+static void _old_rect32(rtgui_color_t *c, rtgui_rect_t *rect) {
+    rtgui_color_t pixel = *c;
+    rt_uint8_t *line = PIXEL(rect->x1, rect->y1);
+    rtgui_color_t *ptr;
+    int x, y;
+
+    for (y = rect->y1; y < rect->y2; y++, line += display()->pitch)
+        for (x = rect->x1, ptr = (rtgui_color_t *)line; x < rect->x2; x++)
+            *ptr++ = pixel;
+}
+
+static const struct rtgui_graphic_driver_ops _old_ops16 = {
+    RT_NULL, RT_NULL, _old_hline16, _old_vline16, RT_NULL, _old_rect16,
+};
+
+static const struct rtgui_graphic_driver_ops _old_ops32 = {
+    RT_NULL, RT_NULL, _old_hline32, _old_vline32, RT_NULL, _old_rect32,
+};
+
+/* cases, by old or driver ops */
+static void _hline(const struct rtgui_graphic_driver_ops *ops,
+    rtgui_color_t *c, int y) {
+    ops->draw_hline(c, 0, _drv->width, y);
+}
+
+static void _short(const struct rtgui_graphic_driver_ops *ops,
+    rtgui_color_t *c, int y) {
+    ops->draw_hline(c, SHORT_X, SHORT_X + SHORT_LEN, y);
+}
+
+static void _tiny(const struct rtgui_graphic_driver_ops *ops,
+    rtgui_color_t *c, int y) {
+    ops->draw_hline(c, TINY_X, TINY_X + TINY_LEN, y);
+}
+
+static void _vline(const struct rtgui_graphic_driver_ops *ops,
+    rtgui_color_t *c, int x) {
+    ops->draw_vline(c, x, 0, _drv->height);
+}
+
+static void _rect(const struct rtgui_graphic_driver_ops *ops,
+    rtgui_color_t *c, int i) {
+    rtgui_rect_t rect = { 0, 0, _drv->width, _drv->height };
+    (void)i;
+
+    ops->fill_rect(c, &rect);
+}
+
+static const struct bench_case _cases[] = {
+    { "hline", _hline, LCD_WIDTH, LCD_HEIGHT },
+    { "hline short", _short, SHORT_LEN, LCD_HEIGHT },
+    { "hline tiny", _tiny, TINY_LEN, LCD_HEIGHT },
+    { "vline", _vline, LCD_HEIGHT, LCD_WIDTH },
+    { "fill_rect", _rect, LCD_WIDTH * LCD_HEIGHT, 1 },
+    { RT_NULL },
+};
+
+static rt_uint64_t _now_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (rt_uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/* Mpixel/s of case by ops */
+static double _bench(const struct bench_case *bc,
+    const struct rtgui_graphic_driver_ops *ops, rtgui_color_t *c) {
+    rt_uint64_t start, elapsed, pixels = 0;
+    int i;
+
+    start = _now_ns();
+    do {
+        for (i = 0; i < bc->num; i++)
+            bc->run(ops, c, i);
+        pixels += (rt_uint64_t)bc->pixels * bc->num;
+        elapsed = _now_ns() - start;
+    } while (elapsed < BENCH_MIN_NS);
+    return (double)pixels * 1000.0 / elapsed;
+}
+
+/* Public functions ----------------------------------------------------------*/
+int main(int argc, char *argv[]) {
+    const struct rtgui_graphic_driver_ops *old_ops;
+    const struct bench_case *bc;
+    const char *fmt_name = (argc > 1) ? argv[1] : "rgb565";
+    rtgui_color_t color = BENCH_COLOR;
+    rt_uint8_t fmt;
+    int ret = 0;
+
+    if (!strcmp(fmt_name, "rgb565")) {
+        fmt = RTGRAPHIC_PIXEL_FORMAT_RGB565;
+        old_ops = &_old_ops16;
+    } else if (!strcmp(fmt_name, "rgb888")) {
+        fmt = RTGRAPHIC_PIXEL_FORMAT_RGB888;
+        old_ops = &_old_ops32;
+    } else {
+        fprintf(stderr, "usage: %s [rgb565|rgb888]\n", argv[0]);
+        return 2;
+    }
+
+    if ((RT_EOK != rtgui_sim_init(LCD_WIDTH, LCD_HEIGHT, fmt, _fb)) || \
+        (RT_EOK != rtgui_set_gfx_device(rt_device_find(RTGUI_SIM_LCD_NAME)))) {
+        fprintf(stderr, "sim init failed\n");
+        return 1;
+    }
+    _drv = rtgui_get_gfx_device();
+    if (!_drv->framebuffer || (_drv->framebuffer != _fb)) {
+        fprintf(stderr, "no framebuffer ops\n");
+        return 1;
+    }
+
+    printf("%s %dx%d, Mpixel/s\n", fmt_name, LCD_WIDTH, LCD_HEIGHT);
+    printf("%-12s %10s %10s %8s\n", "op", "old", "new", "speedup");
+    for (bc = _cases; bc->name; bc++) {
+        double old_rate, new_rate;
+        int i;
+
+        /* same pixels by both */
+        memset(_fb, 0x00, sizeof(_fb64));
+        for (i = 0; i < bc->num; i++) bc->run(old_ops, &color, i);
+        memcpy(_ref, _fb, sizeof(_ref));
+        memset(_fb, 0x00, sizeof(_fb64));
+        for (i = 0; i < bc->num; i++) bc->run(_drv->ops, &color, i);
+        if (memcmp(_ref, _fb, sizeof(_ref))) {
+            printf("%-12s mismatch\n", bc->name);
+            ret = 1;
+            continue;
+        }
+
+        for (old_rate = new_rate = 0.0, i = 0; i < BENCH_ROUNDS; i++) {
+            double rate;
+
+            rate = _bench(bc, old_ops, &color);
+            if (rate > old_rate) old_rate = rate;
+            rate = _bench(bc, _drv->ops, &color);
+            if (rate > new_rate) new_rate = rate;
+        }
+        printf("%-12s %10.1f %10.1f %7.2fx\n", bc->name, old_rate, new_rate,
+            new_rate / old_rate);
+    }
+    return ret;
+}
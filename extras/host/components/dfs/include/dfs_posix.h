@@ -0,0 +1,63 @@
+/*
+ * File      : rtconfig.h
+ * This file is part of RT-Thread GUI Engine
+ * COPYRIGHT (C) 2006 - 2017, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2019-07-12     onelife      first version, for host build
+ */
+/* DFS on host: POSIX file API with "/" of DFS mapped to a host directory, see
+   dfs_host_set_root(). Only calls taking a path are redirected. */
+#ifndef __DFS_POSIX_H__
+#define __DFS_POSIX_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Exported defines ----------------------------------------------------------*/
+#ifndef O_BINARY
+# define O_BINARY                           (0)
+#endif
+
+#define open(path, ...)                     dfs_host_open(path, __VA_ARGS__)
+#define stat(path, buf)                     dfs_host_stat(path, buf)
+#define opendir(path)                       dfs_host_opendir(path)
+#define unlink(path)                        dfs_host_unlink(path)
+#define mkdir(path, mode)                   dfs_host_mkdir(path, mode)
+
+/* Exported functions ------------------------------------------------------- */
+/* set host directory as root, default is current directory */
+void dfs_host_set_root(const char *dir);
+int dfs_host_open(const char *path, int flags, ...);
+int dfs_host_stat(const char *path, struct stat *buf);
+DIR *dfs_host_opendir(const char *path);
+int dfs_host_unlink(const char *path);
+int dfs_host_mkdir(const char *path, mode_t mode);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __DFS_POSIX_H__ */
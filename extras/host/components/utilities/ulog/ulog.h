@@ -0,0 +1,72 @@
+/*
+ * File      : rtconfig.h
+ * This file is part of RT-Thread GUI Engine
+ * COPYRIGHT (C) 2006 - 2017, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2019-07-12     onelife      first version, for host build
+ */
+/* Minimal ulog for host build: one line per log to stdout, filtered by LOG_LVL
+   at compile time. */
+#ifndef __ULOG_H__
+#define __ULOG_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include "include/rtthread.h"
+
+/* Exported defines ----------------------------------------------------------*/
+#define LOG_LVL_ASSERT                      (0)
+#define LOG_LVL_ERROR                       (3)
+#define LOG_LVL_WARNING                     (4)
+#define LOG_LVL_INFO                        (6)
+#define LOG_LVL_DBG                         (7)
+
+#ifndef LOG_TAG
+# define LOG_TAG                            "NO_TAG"
+#endif
+#ifndef LOG_LVL
+# define LOG_LVL                            LOG_LVL_DBG
+#endif
+
+#if (LOG_LVL >= LOG_LVL_ERROR)
+# define LOG_E(...)  ulog_output(LOG_LVL_ERROR, LOG_TAG, __VA_ARGS__)
+#else
+# define LOG_E(...)
+#endif
+#if (LOG_LVL >= LOG_LVL_WARNING)
+# define LOG_W(...)  ulog_output(LOG_LVL_WARNING, LOG_TAG, __VA_ARGS__)
+#else
+# define LOG_W(...)
+#endif
+#if (LOG_LVL >= LOG_LVL_INFO)
+# define LOG_I(...)  ulog_output(LOG_LVL_INFO, LOG_TAG, __VA_ARGS__)
+#else
+# define LOG_I(...)
+#endif
+#if (LOG_LVL >= LOG_LVL_DBG)
+# define LOG_D(...)  ulog_output(LOG_LVL_DBG, LOG_TAG, __VA_ARGS__)
+#else
+# define LOG_D(...)
+#endif
+#define LOG_RAW(...)                        rt_kprintf(__VA_ARGS__)
+#define LOG_HEX(name, width, buf, size)
+
+/* Exported functions ------------------------------------------------------- */
+void ulog_output(rt_uint32_t level, const char *tag, const char *format, ...);
+
+#endif /* __ULOG_H__ */
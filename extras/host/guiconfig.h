@@ -0,0 +1,162 @@
+/*
+ * File      : guiconfig.h
+ * This file is part of RT-Thread GUI Engine
+ * COPYRIGHT (C) 2006 - 2017, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2009-10-16     Bernard      first version
+ * 2010-02-08     Bernard      move some RTGUI options to bsp
+ * 2019-05-23     onelife      rename to "guiconfig.h"
+ * 2019-07-12     onelife      copy for host build
+ */
+
+#ifndef __GUICONFIG_H__
+#define __GUICONFIG_H__
+
+#ifndef RT_THREAD_PRIORITY_MAX
+# define RT_THREAD_PRIORITY_MAX             (32)
+#endif
+
+
+/* User Config */
+
+/* RT-Thread Device Name, registered by rtgui_sim_init() */
+#define CONFIG_GUI_DEVICE_NAME              "SIM_LCD"   // RGB565
+#define CONFIG_TOUCH_DEVICE_NAME            "SIM_TCH"
+#define CONFIG_KEY_DEVICE_NAME              "SIM_KEY"
+
+/* Color */
+#define CONFIG_USING_MONO                   (0)
+#define CONFIG_USING_RGB565                 (1)
+#define CONFIG_USING_RGB565P                (0)
+#define CONFIG_USING_RGB888                 (1)   // for benchmark
+
+/* Image Decoder */
+#define CONFIG_USING_IMAGE_XPM              (1)
+#define CONFIG_USING_IMAGE_BMP              (1)
+#define CONFIG_USING_IMAGE_JPEG             (1)
+#define CONFIG_USING_IMAGE_PNG              (0)
+
+/* Font */
+#define CONFIG_USING_FONT_12                (0)
+#define CONFIG_USING_FONT_16                (1)
+#define CONFIG_USING_FONT_HZ                (0)
+#define CONFIG_USING_FONT_FILE              (0)
+
+/* APP */
+#define CONFIG_APP_PRIORITY                 (RTGUI_SERVER_PRIORITY + (RT_THREAD_PRIORITY_MAX >> 3))
+#define CONFIG_APP_TIMESLICE                (RTGUI_SERVER_TIMESLICE)
+#define CONFIG_APP_STACK_SIZE               (3 * 512)
+
+
+/* Debug Config */
+
+#define RTGUI_LOG_LEVEL                     (LOG_LVL_WARNING)
+#define RTGUI_CASTING_CHECK
+// #define RTGUI_LOG_EVENT
+// #define RTGUI_OBJECT_TRACE
+// #define RTGUI_USING_CURSOR
+
+
+/* Event Config */
+
+#define RTGUI_MB_SIZE                       (16)
+#define RTGUI_EVENT_POOL_NUMBER             (32)
+#define RTGUI_EVENT_RESEND_DELAY            (RT_TICK_PER_SECOND / 50)
+
+
+/* System Config */
+
+#define RTGUI_SERVER_PRIORITY               ((RT_THREAD_PRIORITY_MAX >> 1) + (RT_THREAD_PRIORITY_MAX >> 3))
+#define RTGUI_SERVER_TIMESLICE              (15)
+#define RTGUI_SERVER_STACK_SIZE             (2 * 512)
+/* simulated display is in memory */
+#define RTGUI_USING_FRAMEBUFFER
+
+/* clip update allocates region data from a static arena of ARENA_SIZE bytes
+   and falls back to heap when full */
+#define RTGUI_USING_REGION_ARENA
+#define RTGUI_REGION_ARENA_SIZE             (1024)
+
+/* Screen Update Config */
+
+/* damaged rects are updated as one bounding box when more than MAX_RECTS or
+   when they cover at least MERGE_PERCENT of the bounding box */
+#define RTGUI_DAMAGE_MAX_RECTS              (4)
+#define RTGUI_DAMAGE_MERGE_PERCENT          (70)
+
+/* draw without UPDATE_BEGIN/END events to server when cursor is away from
+   the window, damage is updated when the app has no more pending event */
+#define RTGUI_USING_DIRECT_DRAWING
+
+/* ordered dither gradient fills on RGB565 display to reduce banding */
+// #define RTGUI_USING_GRADIENT_DITHER
+
+/* draw in RAM bands of BAND_HEIGHT lines for device without framebuffer */
+// #define RTGUI_USING_BAND_BUFFER
+#define RTGUI_BAND_HEIGHT                   (16)
+
+/* draw to back buffer and flip (or copy) at commit for framebuffer device */
+// #define RTGUI_USING_DOUBLE_BUFFER
+
+/* update screen in a thread, at most UPDATE_QUEUE_SIZE rects are queued */
+// #define RTGUI_USING_ASYNC_UPDATE
+#define RTGUI_UPDATE_QUEUE_SIZE             (4)
+#define RTGUI_UPDATE_PRIORITY               (RTGUI_SERVER_PRIORITY)
+#define RTGUI_UPDATE_STACK_SIZE             (512)
+
+/* in-memory display and scripted input devices, e.g. for simulator BSP */
+#define RTGUI_USING_SIMULATOR
+/* simulated display also provides mock graphic extension ops (counted) */
+// #define RTGUI_USING_SIM_EXT_OPS
+
+/* record widget drawing and replay it on repaint, see rtgui_dc_list_attach() */
+// #define RTGUI_USING_DISPLAY_LIST
+
+
+/* Color Config */
+
+#define RTGUI_BIG_ENDIAN_OUTPUT
+/* 32-bit framebuffer ops are only for RGB888 as 32-bit */
+#define RTGUI_USING_RGB888_AS_32BIT
+#ifdef RTGUI_USING_RGB888_AS_32BIT
+# define RTGUI_RGB888_PIXEL_BITS 32
+#else
+# define RTGUI_RGB888_PIXEL_BITS 24
+#endif
+
+
+/* File Operation Config */
+
+#define RTGUI_USING_DFS_FILERW
+
+
+/* External Library Config*/
+
+/* JPEG */
+#define CONFIG_JPEG_BUFFER_SIZE             (4 * 1024)
+#define CONFIG_JPEG_OUTPUT_RGB565           (1)
+
+/* LodePNG */
+#define LODEPNG_NO_COMPILE_ENCODER
+#define LODEPNG_NO_COMPILE_DISK
+#define LODEPNG_NO_COMPILE_ERROR_TEXT
+#define LODEPNG_NO_COMPILE_ALLOCATORS
+#define LODEPNG_NO_COMPILE_CPP
+
+#endif /* __GUICONFIG_H__ */
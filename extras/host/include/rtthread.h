@@ -0,0 +1,467 @@
+/*
+ * File      : rtthread.h
+ * This file is part of RT-Thread GUI Engine
+ * COPYRIGHT (C) 2006 - 2017, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2019-07-12     onelife      first version, for host build
+ */
+/* The subset of RT-Thread kernel API used by RTT-GUI, implemented on top of
+   POSIX threads by "rtthread.c". */
+#ifndef __RT_THREAD_H__
+#define __RT_THREAD_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <strings.h>
+#include <pthread.h>
+#include "rtconfig.h"
+
+/* Exported defines ----------------------------------------------------------*/
+#define RT_TRUE                             (1)
+#define RT_FALSE                            (0)
+#define RT_NULL                             (0)
+
+#define rt_inline                           static __inline
+#define RTM_EXPORT(symbol)
+#define INIT_ENV_EXPORT(fn)
+#define INIT_APP_EXPORT(fn)
+
+/* error code */
+#define RT_EOK                              (0)
+#define RT_ERROR                            (1)
+#define RT_ETIMEOUT                         (2)
+#define RT_EFULL                            (3)
+#define RT_EEMPTY                           (4)
+#define RT_ENOMEM                           (5)
+#define RT_ENOSYS                           (6)
+#define RT_EBUSY                            (7)
+#define RT_EIO                              (8)
+#define RT_EINTR                            (9)
+#define RT_EINVAL                           (10)
+
+#define RT_WAITING_FOREVER                  (-1)
+#define RT_WAITING_NO                       (0)
+
+#define RT_IPC_FLAG_FIFO                    (0x00)
+#define RT_IPC_FLAG_PRIO                    (0x01)
+
+#define RT_TIMER_FLAG_ONE_SHOT              (0x0)
+#define RT_TIMER_FLAG_PERIODIC              (0x2)
+#define RT_TIMER_FLAG_HARD_TIMER            (0x0)
+#define RT_TIMER_FLAG_SOFT_TIMER            (0x4)
+#define RT_TIMER_CTRL_SET_TIME              (0x0)
+#define RT_TIMER_CTRL_GET_TIME              (0x1)
+#define RT_TIMER_CTRL_SET_ONESHOT           (0x2)
+#define RT_TIMER_CTRL_SET_PERIODIC          (0x3)
+
+#define RT_EVENT_FLAG_AND                   (0x01)
+#define RT_EVENT_FLAG_OR                    (0x02)
+#define RT_EVENT_FLAG_CLEAR                 (0x04)
+
+#define RT_DEVICE_FLAG_RDONLY               (0x001)
+#define RT_DEVICE_FLAG_WRONLY               (0x002)
+#define RT_DEVICE_FLAG_RDWR                 (0x003)
+#define RT_DEVICE_FLAG_ACTIVATED            (0x010)
+#define RT_DEVICE_OFLAG_CLOSE               (0x000)
+#define RT_DEVICE_OFLAG_OPEN                (0x008)
+
+#define RT_DEVICE_CTRL_CURSOR_SET_POSITION  (0x10)
+#define RT_DEVICE_CTRL_CURSOR_SET_TYPE      (0x11)
+
+#define RTGRAPHIC_CTRL_RECT_UPDATE          (0)
+#define RTGRAPHIC_CTRL_POWERON              (1)
+#define RTGRAPHIC_CTRL_POWEROFF             (2)
+#define RTGRAPHIC_CTRL_GET_INFO             (3)
+#define RTGRAPHIC_CTRL_SET_MODE             (4)
+#define RTGRAPHIC_CTRL_GET_EXT              (5)
+
+void rt_assert_handler(const char *ex, const char *func, long line);
+#define RT_ASSERT(EX)                       \
+    if (!(EX)) {                            \
+        rt_assert_handler(#EX, __FUNCTION__, __LINE__); \
+    }
+
+#define rt_container_of(ptr, type, member)  \
+    ((type *)((char *)(ptr) - (unsigned long)(&((type *)0)->member)))
+#define rt_list_entry(node, type, member)   \
+    rt_container_of(node, type, member)
+#define rt_list_for_each(pos, head)         \
+    for (pos = (head)->next; pos != (head); pos = pos->next)
+#define rt_slist_entry(node, type, member)  \
+    rt_container_of(node, type, member)
+#define rt_slist_for_each(pos, head)        \
+    for (pos = (head)->next; pos != RT_NULL; pos = pos->next)
+#define RT_LIST_OBJECT_INIT(object)         { &(object), &(object) }
+
+#define rt_memcpy                           memcpy
+#define rt_memset                           memset
+#define rt_memmove                          memmove
+#define rt_memcmp                           memcmp
+#define rt_strlen                           strlen
+#define rt_strcmp                           strcmp
+#define rt_strncmp                          strncmp
+#define rt_strncpy                          strncpy
+#define rt_strcasecmp                       strcasecmp
+
+/* Exported types ------------------------------------------------------------*/
+typedef int8_t                              rt_int8_t;
+typedef int16_t                             rt_int16_t;
+typedef int32_t                             rt_int32_t;
+typedef int64_t                             rt_int64_t;
+typedef uint8_t                             rt_uint8_t;
+typedef uint16_t                            rt_uint16_t;
+typedef uint32_t                            rt_uint32_t;
+typedef uint64_t                            rt_uint64_t;
+typedef int                                 rt_bool_t;
+typedef long                                rt_base_t;
+typedef unsigned long                       rt_ubase_t;
+
+typedef rt_base_t                           rt_err_t;
+typedef rt_uint32_t                         rt_time_t;
+typedef rt_uint32_t                         rt_tick_t;
+typedef rt_base_t                           rt_flag_t;
+typedef rt_ubase_t                          rt_size_t;
+typedef rt_ubase_t                          rt_dev_t;
+typedef rt_base_t                           rt_off_t;
+
+struct rt_list_node {
+    struct rt_list_node *next;
+    struct rt_list_node *prev;
+};
+typedef struct rt_list_node rt_list_t;
+
+struct rt_slist_node {
+    struct rt_slist_node *next;
+};
+typedef struct rt_slist_node rt_slist_t;
+
+struct rt_object {
+    char name[RT_NAME_MAX];
+    rt_uint8_t type;
+    rt_uint8_t flag;
+    rt_list_t list;
+};
+typedef struct rt_object *rt_object_t;
+
+struct rt_thread {
+    struct rt_object parent;
+    rt_list_t tlist;                        /* in ready or suspend list */
+    void (*entry)(void *parameter);
+    void *parameter;
+    rt_uint8_t stat;
+    rt_uint8_t current_priority;
+    rt_uint8_t init_priority;
+    rt_err_t error;
+    rt_uint32_t event_set;
+    rt_uint8_t event_info;
+    rt_ubase_t user_data;
+    /* host */
+    pthread_t pid;
+    pthread_cond_t cond;                    /* wake up and get cpu */
+};
+typedef struct rt_thread *rt_thread_t;
+
+struct rt_ipc_object {
+    struct rt_object parent;
+    rt_list_t suspend_thread;
+};
+
+struct rt_semaphore {
+    struct rt_ipc_object parent;
+    rt_uint16_t value;
+};
+typedef struct rt_semaphore *rt_sem_t;
+
+struct rt_mutex {
+    struct rt_ipc_object parent;
+    rt_uint16_t value;
+    rt_uint8_t original_priority;
+    rt_uint8_t hold;
+    struct rt_thread *owner;
+};
+typedef struct rt_mutex *rt_mutex_t;
+
+struct rt_event {
+    struct rt_ipc_object parent;
+    rt_uint32_t set;
+};
+typedef struct rt_event *rt_event_t;
+
+struct rt_mailbox {
+    struct rt_ipc_object parent;
+    rt_ubase_t *msg_pool;
+    rt_uint16_t size;
+    rt_uint16_t entry;
+    rt_uint16_t in_offset;
+    rt_uint16_t out_offset;
+    rt_list_t suspend_sender_thread;
+};
+typedef struct rt_mailbox *rt_mailbox_t;
+
+struct rt_mempool {
+    struct rt_object parent;
+    void *start_address;
+    rt_size_t size;
+    rt_size_t block_size;
+    rt_uint8_t *block_list;
+    rt_size_t block_total_count;
+    rt_size_t block_free_count;
+    rt_list_t suspend_thread;
+};
+typedef struct rt_mempool *rt_mp_t;
+
+struct rt_timer {
+    struct rt_object parent;
+    rt_list_t row;
+    void (*timeout_func)(void *parameter);
+    void *parameter;
+    rt_tick_t init_tick;
+    rt_tick_t timeout_tick;
+};
+typedef struct rt_timer *rt_timer_t;
+
+enum rt_device_class_type {
+    RT_Device_Class_Char = 0,
+    RT_Device_Class_Block,
+    RT_Device_Class_NetIf,
+    RT_Device_Class_MTD,
+    RT_Device_Class_CAN,
+    RT_Device_Class_RTC,
+    RT_Device_Class_Sound,
+    RT_Device_Class_Graphic,
+    RT_Device_Class_I2CBUS,
+    RT_Device_Class_USBDevice,
+    RT_Device_Class_USBHost,
+    RT_Device_Class_SPIBUS,
+    RT_Device_Class_SPIDevice,
+    RT_Device_Class_SDIO,
+    RT_Device_Class_PM,
+    RT_Device_Class_Pipe,
+    RT_Device_Class_Portal,
+    RT_Device_Class_Timer,
+    RT_Device_Class_Miscellaneous,
+    RT_Device_Class_Unknown
+};
+
+typedef struct rt_device *rt_device_t;
+struct rt_device {
+    struct rt_object parent;
+    enum rt_device_class_type type;
+    rt_uint16_t flag;
+    rt_uint16_t open_flag;
+    rt_uint8_t ref_count;
+    rt_uint8_t device_id;
+    rt_err_t (*rx_indicate)(rt_device_t dev, rt_size_t size);
+    rt_err_t (*tx_complete)(rt_device_t dev, void *buffer);
+    rt_err_t (*init)(rt_device_t dev);
+    rt_err_t (*open)(rt_device_t dev, rt_uint16_t oflag);
+    rt_err_t (*close)(rt_device_t dev);
+    rt_size_t (*read)(rt_device_t dev, rt_off_t pos, void *buffer,
+        rt_size_t size);
+    rt_size_t (*write)(rt_device_t dev, rt_off_t pos, const void *buffer,
+        rt_size_t size);
+    rt_err_t (*control)(rt_device_t dev, int cmd, void *args);
+    void *user_data;
+};
+
+enum {
+    RTGRAPHIC_PIXEL_FORMAT_MONO = 0,
+    RTGRAPHIC_PIXEL_FORMAT_GRAY4,
+    RTGRAPHIC_PIXEL_FORMAT_GRAY16,
+    RTGRAPHIC_PIXEL_FORMAT_RGB332,
+    RTGRAPHIC_PIXEL_FORMAT_RGB444,
+    RTGRAPHIC_PIXEL_FORMAT_RGB565,
+    RTGRAPHIC_PIXEL_FORMAT_RGB565P,
+    RTGRAPHIC_PIXEL_FORMAT_BGR565 = RTGRAPHIC_PIXEL_FORMAT_RGB565P,
+    RTGRAPHIC_PIXEL_FORMAT_RGB666,
+    RTGRAPHIC_PIXEL_FORMAT_RGB888,
+    RTGRAPHIC_PIXEL_FORMAT_ARGB888,
+    RTGRAPHIC_PIXEL_FORMAT_ABGR888,
+    RTGRAPHIC_PIXEL_FORMAT_ARGB565,
+    RTGRAPHIC_PIXEL_FORMAT_ALPHA,
+    RTGRAPHIC_PIXEL_FORMAT_COLOR,
+    RTGRAPHIC_PIXEL_FORMAT_BGR888,
+    RTGRAPHIC_PIXEL_FORMAT_RGB8I,
+    RTGRAPHIC_PIXEL_FORMAT_RGB4I,
+    RTGRAPHIC_PIXEL_FORMAT_RGB2I,
+};
+
+struct rt_device_graphic_info {
+    rt_uint8_t pixel_format;
+    rt_uint8_t bits_per_pixel;
+    rt_uint16_t reserved;
+    rt_uint16_t width;
+    rt_uint16_t height;
+    rt_uint8_t *framebuffer;
+};
+
+struct rt_device_rect_info {
+    rt_uint16_t x;
+    rt_uint16_t y;
+    rt_uint16_t width;
+    rt_uint16_t height;
+};
+
+/* Exported functions ------------------------------------------------------- */
+rt_inline void rt_list_init(rt_list_t *l) {
+    l->next = l->prev = l;
+}
+
+rt_inline void rt_list_insert_after(rt_list_t *l, rt_list_t *n) {
+    l->next->prev = n;
+    n->next = l->next;
+    l->next = n;
+    n->prev = l;
+}
+
+rt_inline void rt_list_insert_before(rt_list_t *l, rt_list_t *n) {
+    l->prev->next = n;
+    n->prev = l->prev;
+    l->prev = n;
+    n->next = l;
+}
+
+rt_inline void rt_list_remove(rt_list_t *n) {
+    n->next->prev = n->prev;
+    n->prev->next = n->next;
+    n->next = n->prev = n;
+}
+
+rt_inline int rt_list_isempty(const rt_list_t *l) {
+    return l->next == l;
+}
+
+rt_inline void rt_slist_init(rt_slist_t *l) {
+    l->next = RT_NULL;
+}
+
+rt_inline void rt_slist_append(rt_slist_t *l, rt_slist_t *n) {
+    struct rt_slist_node *node = l;
+
+    while (node->next) node = node->next;
+    node->next = n;
+    n->next = RT_NULL;
+}
+
+rt_inline rt_slist_t *rt_slist_remove(rt_slist_t *l, rt_slist_t *n) {
+    struct rt_slist_node *node = l;
+
+    while (node->next && (node->next != n)) node = node->next;
+    if (node->next) node->next = node->next->next;
+    return l;
+}
+
+/* thread */
+rt_thread_t rt_thread_self(void);
+rt_thread_t rt_thread_create(const char *name,
+    void (*entry)(void *parameter), void *parameter, rt_uint32_t stack_size,
+    rt_uint8_t priority, rt_uint32_t tick);
+rt_err_t rt_thread_startup(rt_thread_t thread);
+rt_err_t rt_thread_delay(rt_tick_t tick);
+rt_err_t rt_thread_mdelay(rt_int32_t ms);
+rt_err_t rt_thread_yield(void);
+
+/* tick and timer */
+rt_tick_t rt_tick_get(void);
+rt_tick_t rt_tick_from_millisecond(rt_int32_t ms);
+void rt_timer_init(rt_timer_t timer, const char *name,
+    void (*timeout)(void *parameter), void *parameter, rt_tick_t time,
+    rt_uint8_t flag);
+rt_err_t rt_timer_detach(rt_timer_t timer);
+rt_err_t rt_timer_start(rt_timer_t timer);
+rt_err_t rt_timer_stop(rt_timer_t timer);
+rt_err_t rt_timer_control(rt_timer_t timer, int cmd, void *arg);
+
+/* ipc */
+rt_err_t rt_sem_init(rt_sem_t sem, const char *name, rt_uint32_t value,
+    rt_uint8_t flag);
+rt_err_t rt_sem_detach(rt_sem_t sem);
+rt_err_t rt_sem_take(rt_sem_t sem, rt_int32_t time);
+rt_err_t rt_sem_trytake(rt_sem_t sem);
+rt_err_t rt_sem_release(rt_sem_t sem);
+
+rt_err_t rt_mutex_init(rt_mutex_t mutex, const char *name, rt_uint8_t flag);
+rt_err_t rt_mutex_detach(rt_mutex_t mutex);
+rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t time);
+rt_err_t rt_mutex_release(rt_mutex_t mutex);
+
+rt_err_t rt_event_init(rt_event_t event, const char *name, rt_uint8_t flag);
+rt_err_t rt_event_detach(rt_event_t event);
+rt_err_t rt_event_send(rt_event_t event, rt_uint32_t set);
+rt_err_t rt_event_recv(rt_event_t event, rt_uint32_t set, rt_uint8_t opt,
+    rt_int32_t timeout, rt_uint32_t *recved);
+
+rt_err_t rt_mb_init(rt_mailbox_t mb, const char *name, void *msgpool,
+    rt_size_t size, rt_uint8_t flag);
+rt_err_t rt_mb_detach(rt_mailbox_t mb);
+rt_mailbox_t rt_mb_create(const char *name, rt_size_t size, rt_uint8_t flag);
+rt_err_t rt_mb_delete(rt_mailbox_t mb);
+rt_err_t rt_mb_send(rt_mailbox_t mb, rt_ubase_t value);
+rt_err_t rt_mb_send_wait(rt_mailbox_t mb, rt_ubase_t value,
+    rt_int32_t timeout);
+rt_err_t rt_mb_recv(rt_mailbox_t mb, rt_ubase_t *value, rt_int32_t timeout);
+
+rt_mp_t rt_mp_create(const char *name, rt_size_t block_count,
+    rt_size_t block_size);
+rt_err_t rt_mp_delete(rt_mp_t mp);
+void *rt_mp_alloc(rt_mp_t mp, rt_int32_t time);
+void rt_mp_free(void *block);
+
+/* scheduler */
+void rt_enter_critical(void);
+void rt_exit_critical(void);
+
+/* device */
+rt_err_t rt_device_register(rt_device_t dev, const char *name,
+    rt_uint16_t flags);
+rt_err_t rt_device_unregister(rt_device_t dev);
+rt_device_t rt_device_find(const char *name);
+rt_err_t rt_device_open(rt_device_t dev, rt_uint16_t oflag);
+rt_err_t rt_device_close(rt_device_t dev);
+rt_size_t rt_device_read(rt_device_t dev, rt_off_t pos, void *buffer,
+    rt_size_t size);
+rt_size_t rt_device_write(rt_device_t dev, rt_off_t pos, const void *buffer,
+    rt_size_t size);
+rt_err_t rt_device_control(rt_device_t dev, int cmd, void *arg);
+
+/* memory and string */
+void *rt_malloc(rt_size_t size);
+void *rt_realloc(void *ptr, rt_size_t size);
+void *rt_calloc(rt_size_t count, rt_size_t size);
+void rt_free(void *ptr);
+char *rt_strdup(const char *s);
+void rt_kprintf(const char *fmt, ...);
+int rt_snprintf(char *buf, rt_size_t size, const char *fmt, ...);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef RT_USING_DFS
+/* same as Arduino port, file API comes with the kernel */
+# include "components/dfs/include/dfs_posix.h"
+#endif
+
+#endif /* __RT_THREAD_H__ */
@@ -0,0 +1,430 @@
+/*
+ * File      : main.c
+ * This file is part of RT-Thread GUI Engine
+ * COPYRIGHT (C) 2006 - 2017, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2019-07-12     onelife      first version, for host build
+ * 2019-08-24     onelife      add display list check
+ */
+/* Host demo: GUI server and one app on the simulated display and input.
+ *
+ * usage: rttgui_host [-r root] [-s script] [-o image.ppm] [-n shapes]
+ *                    [-f frames] [-d pixels_per_ms] [-l]
+ *  -r  host directory mapped to "/" of DFS (default ".")
+ *  -s  input script for rtgui_sim_play() (default taps the button)
+ *  -o  save the screen when done
+ *  -n  time drawing of shapes (lines, rects, circles and ellipses) on the
+ *      label at first paint, e.g. to compare build with and without
+ *      RTGUI_USING_SIM_EXT_OPS
+ *  -f  time frames, each draws the shapes on the label and the bar in turn,
+ *      e.g. to compare build with and without RTGUI_USING_ASYNC_UPDATE
+ *  -d  transfer speed of the simulated display (default no delay)
+ *  -l  attach display lists to the button, the bar and the title, which
+ *      shows the clicks, and fail if the replay of button differs from its
+ *      drawing at first paint (build with RTGUI_USING_DISPLAY_LIST)
+ * Exit code is 0 when the default script clicked the button as expected. */
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "include/rtgui.h"
+#include "include/simulator.h"
+#include "include/widgets/box.h"
+#include "include/widgets/label.h"
+#include "include/widgets/button.h"
+#include "include/widgets/progress.h"
+#include "include/widgets/window.h"
+#include "include/dc.h"
+#include "include/app/app.h"
+
+/* Private define ------------------------------------------------------------*/
+#define LCD_WIDTH                   (240)
+#define LCD_HEIGHT                  (320)
+#define DEMO_CLICKS                 (3)
+#define DEMO_TIMER_MS               (20)
+#define DEMO_SETTLE_MS              (200)
+#define DEMO_SCRIPT_SIZE            (256)
+#define DEMO_FRAME_SHAPES           (100)
+#define DEMO_LIST_SIZE              (8 * 1024)
+
+/* Private variables ---------------------------------------------------------*/
+static rt_uint16_t _fb[LCD_WIDTH * LCD_HEIGHT];
+static struct rt_semaphore _shown;
+static rtgui_win_t *_win;
+static rtgui_label_t *_label;
+static rtgui_button_t *_btn;
+static rtgui_progress_t *_bar;
+static rtgui_point_t _btn_center;
+static rt_uint32_t _clicks;
+static rt_uint32_t _shapes;
+static rt_uint32_t _shapes_ms;
+static rt_uint32_t _frames;
+static rt_uint32_t _frames_ms;
+static rt_bool_t _lists;
+static const char *_replay = "not checked";
+
+/* Private functions ---------------------------------------------------------*/
+static void _draw_shapes(rtgui_widget_t *wgt) {
+    rtgui_dc_t *dc;
+    rtgui_rect_t rect;
+    int x, y, r;
+    rt_uint32_t i;
+
+    dc = rtgui_dc_begin_drawing(wgt);
+    if (!dc) return;
+    rtgui_widget_get_rect(wgt, &rect);
+    x = (rect.x1 + rect.x2) / 2;
+    y = (rect.y1 + rect.y2) / 2;
+    r = _MIN(rect.x2 - rect.x1, rect.y2 - rect.y1) / 2 - 1;
+    rect.x2--;
+    rect.y2--;
+
+    for (i = 0; i < _shapes; i++) {
+        RTGUI_DC_FC(dc) = (i & 1) ? blue : red;
+        rtgui_dc_fill_circle(dc, x, y, r);
+        rtgui_dc_fill_ellipse(dc, x, y, r, r / 2);
+        rtgui_dc_draw_circle(dc, x, y, r);
+        rtgui_dc_draw_ellipse(dc, x, y, r, r / 2);
+        rtgui_dc_draw_line(dc, rect.x1, rect.y1, rect.x2, rect.y2);
+        rtgui_dc_draw_rect(dc, &rect);
+    }
+    rtgui_dc_end_drawing(dc, RT_TRUE);
+}
+
+static void _draw_frames(void) {
+    rt_tick_t start;
+    rt_uint32_t i;
+
+    start = rt_tick_get();
+    /* label is being sent while drawing the bar, and vice versa */
+    for (i = 0; i < _frames; i++) {
+        _draw_shapes((i & 1) ? TO_WIDGET(_bar) : TO_WIDGET(_label));
+        /* end of frame, as app loop does when no pending event */
+        rtgui_gfx_commit_screen(rtgui_get_gfx_device());
+    }
+    /* till the last frame is on screen */
+    rtgui_gfx_fence_screen(rtgui_get_gfx_device(), RT_NULL);
+    _frames_ms = (rt_tick_get() - start) * 1000 / RT_TICK_PER_SECOND;
+}
+
+#ifdef RTGUI_USING_DISPLAY_LIST
+/* wipe the recorded widget and replay, the pixels should be the same */
+static const char *_check_replay(rtgui_widget_t *wgt) {
+    rtgui_gfx_driver_t *drv = rtgui_get_gfx_device();
+    rtgui_rect_t rect = wgt->extent;
+    rtgui_color_t color = black;
+    rt_uint32_t pitch, size;
+    rt_uint8_t *drawn, *replayed;
+    const char *ret;
+
+    pitch = (rect.x2 - rect.x1) * _BIT2BYTE(drv->bits_per_pixel);
+    size = pitch * (rect.y2 - rect.y1);
+    drawn = rtgui_malloc(size * 2);
+    if (!drawn) return "no mem";
+    replayed = drawn + size;
+
+    do {
+        if (RT_EOK != rtgui_gfx_read_rect(drv, &rect, drawn, pitch)) {
+            ret = "read failed";
+            break;
+        }
+        /* not by dc, so the list is still valid */
+        drv->ops->fill_rect(&color, &rect);
+        if (!rtgui_dc_list_replay(wgt)) {
+            ret = "not recorded";
+            break;
+        }
+        if (RT_EOK != rtgui_gfx_read_rect(drv, &rect, replayed, pitch)) {
+            ret = "read failed";
+            break;
+        }
+        ret = rt_memcmp(drawn, replayed, size) ? "mismatch" : "same";
+    } while (0);
+
+    rtgui_free(drawn);
+    return ret;
+}
+#endif
+
+static rt_bool_t _win_handler(void *obj, rtgui_evt_generic_t *evt) {
+    static rt_bool_t shown = RT_FALSE;
+    rt_bool_t done = RT_FALSE;
+
+    if (DEFAULT_HANDLER(obj))
+        done = DEFAULT_HANDLER(obj)(obj, evt);
+    if (IS_EVENT_TYPE(evt, PAINT) && !shown) {
+        shown = RT_TRUE;
+        if (_frames) {
+            _draw_frames();
+        } else if (_shapes) {
+            rt_tick_t start = rt_tick_get();
+
+            /* label has a single rect clip, where dc may use extension ops */
+            _draw_shapes(TO_WIDGET(_label));
+            _shapes_ms = (rt_tick_get() - start) * 1000 / RT_TICK_PER_SECOND;
+        }
+        #ifdef RTGUI_USING_DISPLAY_LIST
+            if (_lists) _replay = _check_replay(TO_WIDGET(_btn));
+        #endif
+        (void)rt_sem_release(&_shown);
+    }
+    return done;
+}
+
+static rt_bool_t _btn_handler(void *obj, rtgui_evt_generic_t *evt) {
+    rt_bool_t done = RT_FALSE;
+
+    if (DEFAULT_HANDLER(obj))
+        done = DEFAULT_HANDLER(obj)(obj, evt);
+    if (IS_EVENT_TYPE(evt, MOUSE_BUTTON) && IS_MOUSE_EVENT_BUTTON(evt, UP)) {
+        char text[16];
+
+        _clicks++;
+        rt_snprintf(text, sizeof(text), "Clicked %u", _clicks);
+        rtgui_label_set_text(_label, text);
+        if (_lists) {
+            rtgui_win_set_title(_win, text);
+            rtgui_widget_update(TO_WIDGET(_win->_title));
+        }
+        done = RT_TRUE;
+    }
+    return done;
+}
+
+static void _bar_timeout(rtgui_timer_t *timer, void *param) {
+    rt_uint16_t value = MEMBER_GETTER(progress, value)(_bar);
+    (void)timer;
+    (void)param;
+
+    MEMBER_SETTER(progress, value)(_bar, (value + 1) % PROGRESS_RANGE_DEFAULT);
+}
+
+static void _app_entry(void *param) {
+    rtgui_app_t *app;
+    rtgui_win_t *win;
+    rtgui_timer_t *timer = RT_NULL;
+    (void)param;
+
+    CREATE_APP_INSTANCE(app, RT_NULL, "HostApp");
+    if (!app) {
+        rt_kprintf("create app failed\n");
+        return;
+    }
+
+    win = CREATE_MAIN_WIN(_win_handler, "Host Demo", RTGUI_WIN_STYLE_DEFAULT);
+    if (!win) {
+        rtgui_app_uninit(app);
+        rt_kprintf("create mainwin failed\n");
+        return;
+    }
+
+    do {
+        rtgui_box_t *sizer;
+        rtgui_button_t *btn;
+
+        sizer = CREATE_BOX_INSTANCE(win, RTGUI_VERTICAL, 0);
+        if (!sizer) break;
+        _label = CREATE_LABEL_INSTANCE(win, RT_NULL, RT_NULL, "Clicked 0");
+        if (!_label) break;
+        WIDGET_TEXTALIGN_SET(_label, CENTER_HORIZONTAL);
+        WIDGET_ALIGN_SET(_label, STRETCH);
+        btn = CREATE_BUTTON_INSTANCE(win, _btn_handler, NORMAL, "Click");
+        if (!btn) break;
+        WIDGET_ALIGN_SET(btn, STRETCH);
+        _bar = CREATE_PROGRESS_INSTANCE(win, RT_NULL, RT_NULL,
+            RTGUI_HORIZONTAL, PROGRESS_RANGE_DEFAULT);
+        if (!_bar) break;
+        WIDGET_ALIGN_SET(_bar, STRETCH);
+        _win = win;
+        _btn = btn;
+        #ifdef RTGUI_USING_DISPLAY_LIST
+            if (_lists && ( \
+                (RT_EOK != rtgui_dc_list_attach(TO_WIDGET(btn),
+                    DEMO_LIST_SIZE)) || \
+                (RT_EOK != rtgui_dc_list_attach(TO_WIDGET(_bar),
+                    DEMO_LIST_SIZE)) || \
+                (RT_EOK != rtgui_dc_list_attach(TO_WIDGET(win->_title),
+                    DEMO_LIST_SIZE))))
+                rt_kprintf("attach list failed\n");
+        #endif
+        rtgui_box_layout(sizer);
+
+        _btn_center.x = (TO_WIDGET(btn)->extent.x1 + \
+            TO_WIDGET(btn)->extent.x2) / 2;
+        _btn_center.y = (TO_WIDGET(btn)->extent.y1 + \
+            TO_WIDGET(btn)->extent.y2) / 2;
+
+        timer = rtgui_timer_create(rt_tick_from_millisecond(DEMO_TIMER_MS),
+            RT_TIMER_FLAG_PERIODIC, _bar_timeout, RT_NULL);
+        if (timer) rtgui_timer_start(timer);
+
+        rtgui_win_show(win, RT_FALSE);
+        rtgui_app_run(app);
+    } while (0);
+
+    if (timer) rtgui_timer_destory(timer);
+    DELETE_WIN_INSTANCE(win);
+    rtgui_app_uninit(app);
+}
+
+/* same as RT_GUI::begin() of Arduino port */
+static rt_err_t _gui_begin(void) {
+    rt_device_t dev;
+    rt_err_t ret;
+
+    dev = rt_device_find(CONFIG_GUI_DEVICE_NAME);
+    if (!dev) return -RT_EIO;
+    ret = rtgui_set_gfx_device(dev);
+    if (RT_EOK != ret) return ret;
+    dev = rt_device_find(CONFIG_TOUCH_DEVICE_NAME);
+    if (!dev) return -RT_EIO;
+    ret = rtgui_set_touch_device(dev);
+    if (RT_EOK != ret) return ret;
+    dev = rt_device_find(CONFIG_KEY_DEVICE_NAME);
+    if (!dev) return -RT_EIO;
+    ret = rtgui_set_key_device(dev);
+    if (RT_EOK != ret) return ret;
+    return rtgui_system_init();
+}
+
+static int _fb_save(const char *name) {
+    rt_uint16_t *fb = (rt_uint16_t *)rtgui_sim_get_scanout();
+    FILE *fp;
+    rt_uint32_t i;
+
+    fp = fopen(name, "wb");
+    if (!fp) return -1;
+    fprintf(fp, "P6\n%d %d\n255\n", LCD_WIDTH, LCD_HEIGHT);
+    for (i = 0; i < LCD_WIDTH * LCD_HEIGHT; i++) {
+        rt_uint16_t p = fb[i];
+
+        #ifdef RTGUI_BIG_ENDIAN_OUTPUT
+            p = (p >> 8) | (p << 8);
+        #endif
+        fputc(((p >> 11) & 0x1f) << 3, fp);
+        fputc(((p >> 5) & 0x3f) << 2, fp);
+        fputc((p & 0x1f) << 3, fp);
+    }
+    return fclose(fp);
+}
+
+/* Public functions ----------------------------------------------------------*/
+int main(int argc, char *argv[]) {
+    static char script_buf[DEMO_SCRIPT_SIZE];
+    const char *script_name = RT_NULL;
+    const char *out_name = RT_NULL;
+    rtgui_filerw_t *script;
+    struct rtgui_sim_stat stat;
+    rt_thread_t tid;
+    int opt;
+
+    while (-1 != (opt = getopt(argc, argv, "r:s:o:n:f:d:l"))) {
+        switch (opt) {
+        case 'r':
+            dfs_host_set_root(optarg);
+            break;
+        case 's':
+            script_name = optarg;
+            break;
+        case 'o':
+            out_name = optarg;
+            break;
+        case 'n':
+            _shapes = strtoul(optarg, RT_NULL, 0);
+            break;
+        case 'f':
+            _frames = strtoul(optarg, RT_NULL, 0);
+            break;
+        case 'd':
+            rtgui_sim_set_speed(strtoul(optarg, RT_NULL, 0));
+            break;
+        case 'l':
+            _lists = RT_TRUE;
+            break;
+        default:
+            fprintf(stderr,
+                "usage: %s [-r root] [-s script] [-o image.ppm] "
+                "[-n shapes] [-f frames] [-d pixels_per_ms] [-l]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (_frames && !_shapes) _shapes = DEMO_FRAME_SHAPES;
+
+    if (RT_EOK != rtgui_sim_init(LCD_WIDTH, LCD_HEIGHT,
+        RTGRAPHIC_PIXEL_FORMAT_RGB565, (rt_uint8_t *)_fb)) {
+        fprintf(stderr, "sim init failed\n");
+        return 1;
+    }
+    if (RT_EOK != _gui_begin()) {
+        fprintf(stderr, "gui init failed\n");
+        return 1;
+    }
+
+    (void)rt_sem_init(&_shown, "shown", 0, RT_IPC_FLAG_FIFO);
+    tid = rt_thread_create("host_app", _app_entry, RT_NULL,
+        CONFIG_APP_STACK_SIZE, CONFIG_APP_PRIORITY, CONFIG_APP_TIMESLICE);
+    if (!tid || (RT_EOK != rt_thread_startup(tid))) {
+        fprintf(stderr, "create app failed\n");
+        return 1;
+    }
+    (void)rt_sem_take(&_shown, RT_WAITING_FOREVER);
+
+    if (script_name) {
+        script = rtgui_filerw_create_file(script_name, "rb");
+    } else {
+        rt_uint32_t len = 0;
+        int i;
+
+        for (i = 0; i < DEMO_CLICKS; i++)
+            len += rt_snprintf(script_buf + len, sizeof(script_buf) - len,
+                "50 down %d %d\n50 up %d %d\n", _btn_center.x,
+                _btn_center.y, _btn_center.x, _btn_center.y);
+        script = rtgui_filerw_create_mem((rt_uint8_t *)script_buf, len);
+    }
+    if (!script) {
+        fprintf(stderr, "no script %s\n", script_name);
+        return 1;
+    }
+    (void)rtgui_sim_play(script);
+    (void)rtgui_sim_wait(RT_WAITING_FOREVER);
+    rt_thread_delay(rt_tick_from_millisecond(DEMO_SETTLE_MS));
+
+    rtgui_sim_get_stat(&stat, RT_FALSE);
+    printf("clicks %u\n", _clicks);
+    printf("op calls %u, pixels %u\n", stat.op_calls, stat.op_pixels);
+    printf("updates %u, pixels %u, %u ms\n", stat.updates,
+        stat.update_pixels, stat.update_ms);
+    printf("ext calls %u, pixels %u\n", stat.ext_calls, stat.ext_pixels);
+    printf("flips %u, copies %u\n", stat.flips, stat.copies);
+    if (_frames)
+        printf("frames %u, %u ms\n", _frames, _frames_ms);
+    else if (_shapes)
+        printf("shapes %u x 6, %u ms\n", _shapes, _shapes_ms);
+    if (_lists)
+        printf("replay %s\n", _replay);
+    if (out_name && _fb_save(out_name))
+        fprintf(stderr, "save %s failed\n", out_name);
+
+    if (!script_name && (DEMO_CLICKS != _clicks)) return 1;
+    #ifdef RTGUI_USING_DISPLAY_LIST
+        if (_lists && rt_strcmp(_replay, "same")) return 1;
+    #endif
+    return 0;
+}
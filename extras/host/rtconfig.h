@@ -0,0 +1,38 @@
+/*
+ * File      : rtconfig.h
+ * This file is part of RT-Thread GUI Engine
+ * COPYRIGHT (C) 2006 - 2017, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2019-07-12     onelife      first version, for host build
+ */
+#ifndef __RT_CONFIG_H__
+#define __RT_CONFIG_H__
+
+/* Kernel */
+#define RT_NAME_MAX                         (8)
+#define RT_ALIGN_SIZE                       (8)
+#define RT_THREAD_PRIORITY_MAX              (32)
+#define RT_TICK_PER_SECOND                  (1000)
+#define RT_MAIN_THREAD_PRIORITY             (RT_THREAD_PRIORITY_MAX / 3)
+
+/* Components */
+#define RT_USING_ULOG
+#define RT_USING_DFS
+
+#endif /* __RT_CONFIG_H__ */
@@ -0,0 +1,1068 @@
+/*
+ * File      : rtthread.c
+ * This file is part of RT-Thread GUI Engine
+ * COPYRIGHT (C) 2006 - 2017, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2019-07-12     onelife      first version, for host build
+ */
+/* RT-Thread kernel subset on POSIX threads.
+ *
+ * Each rt thread is a pthread, but only the one holding the "cpu" runs, as on
+ * a single core MCU. The cpu is handed over to the highest priority ready
+ * thread when the running one blocks, yields or wakes up a higher priority
+ * thread. A thread woken up by timeout takes the cpu at the next kernel call
+ * of the running thread (there is no tick interrupt to preempt plain code).
+ * All kernel objects are guarded by one host mutex. */
+/* Includes ------------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <time.h>
+
+#include "include/rtthread.h"
+#include "include/rthw.h"
+#include "components/utilities/ulog/ulog.h"
+
+/* the redirected path calls, see dfs_posix.h */
+#undef open
+#undef stat
+#undef opendir
+#undef unlink
+#undef mkdir
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define THREAD_INIT                 (0x00)
+#define THREAD_READY                (0x01)
+#define THREAD_SUSPEND              (0x02)
+#define THREAD_RUNNING              (0x03)
+#define THREAD_CLOSE                (0x04)
+
+#define TIMER_ACTIVATED             (0x01)
+#define TIMER_PRIORITY              (0)
+
+#define DFS_PATH_MAX                (256)
+
+/* tick a is after tick b */
+#define TICK_AFTER(a, b)            ((rt_int32_t)((b) - (a)) < 0)
+
+/* Private variables ---------------------------------------------------------*/
+static pthread_mutex_t _kernel = PTHREAD_MUTEX_INITIALIZER;
+static pthread_condattr_t _cond_attr;
+static rt_list_t _ready = RT_LIST_OBJECT_INIT(_ready);
+static rt_list_t _devices = RT_LIST_OBJECT_INIT(_devices);
+static rt_list_t _timers = RT_LIST_OBJECT_INIT(_timers);
+static rt_thread_t _running;
+static rt_thread_t _timer_thread;
+static rt_base_t _irq_nest;
+static rt_uint32_t _sched_lock;
+static struct timespec _boot;
+static char _dfs_root[DFS_PATH_MAX] = ".";
+static __thread rt_thread_t _self;
+
+/* Private functions ---------------------------------------------------------*/
+static void _kernel_init(void) {
+    static rt_bool_t inited = RT_FALSE;
+
+    if (inited) return;
+    (void)pthread_condattr_init(&_cond_attr);
+    (void)pthread_condattr_setclock(&_cond_attr, CLOCK_MONOTONIC);
+    (void)clock_gettime(CLOCK_MONOTONIC, &_boot);
+    inited = RT_TRUE;
+}
+
+static void _object_init(struct rt_object *obj, const char *name) {
+    rt_strncpy(obj->name, name ? name : "", RT_NAME_MAX);
+    obj->type = 0;
+    obj->flag = 0;
+    rt_list_init(&obj->list);
+}
+
+static void _ipc_init(struct rt_ipc_object *ipc, const char *name) {
+    _object_init(&ipc->parent, name);
+    rt_list_init(&ipc->suspend_thread);
+}
+
+/* insert after threads of the same priority */
+static void _ready_insert(rt_thread_t thread) {
+    rt_list_t *node;
+
+    rt_list_for_each(node, &_ready) {
+        rt_thread_t t = rt_list_entry(node, struct rt_thread, tlist);
+        if (t->current_priority > thread->current_priority) break;
+    }
+    rt_list_insert_before(node, &thread->tlist);
+    thread->stat = THREAD_READY;
+}
+
+static void _give_cpu(rt_thread_t thread) {
+    _running = thread;
+    thread->stat = THREAD_RUNNING;
+    (void)pthread_cond_signal(&thread->cond);
+}
+
+/* hand over the cpu, the caller has left running state */
+static void _schedule(void) {
+    rt_thread_t next;
+
+    if (rt_list_isempty(&_ready)) {
+        _running = RT_NULL;
+        return;
+    }
+    next = rt_list_entry(_ready.next, struct rt_thread, tlist);
+    rt_list_remove(&next->tlist);
+    _give_cpu(next);
+}
+
+static void _wait_cpu(rt_thread_t self) {
+    while (_running != self)
+        (void)pthread_cond_wait(&self->cond, &_kernel);
+}
+
+static void _make_ready(rt_thread_t thread) {
+    if (!_running)
+        _give_cpu(thread);
+    else
+        _ready_insert(thread);
+}
+
+/* wake up a suspended thread */
+static void _resume(rt_thread_t thread, rt_err_t error) {
+    rt_list_remove(&thread->tlist);
+    thread->error = error;
+    _make_ready(thread);
+    (void)pthread_cond_signal(&thread->cond);
+}
+
+static void _resume_all(rt_list_t *list) {
+    while (!rt_list_isempty(list))
+        _resume(rt_list_entry(list->next, struct rt_thread, tlist),
+            -RT_ERROR);
+}
+
+/* give the cpu to a higher priority ready thread */
+static void _preempt(rt_thread_t self) {
+    rt_thread_t next;
+
+    if (_irq_nest || _sched_lock || rt_list_isempty(&_ready)) return;
+    next = rt_list_entry(_ready.next, struct rt_thread, tlist);
+    if (next->current_priority >= self->current_priority) return;
+    _ready_insert(self);
+    _schedule();
+    _wait_cpu(self);
+}
+
+static void _abs_time(struct timespec *ts, rt_tick_t tick) {
+    (void)clock_gettime(CLOCK_MONOTONIC, ts);
+    ts->tv_sec += tick / RT_TICK_PER_SECOND;
+    ts->tv_nsec += (long)(tick % RT_TICK_PER_SECOND) * \
+        (1000000000L / RT_TICK_PER_SECOND);
+    if (ts->tv_nsec >= 1000000000L) {
+        ts->tv_sec++;
+        ts->tv_nsec -= 1000000000L;
+    }
+}
+
+/* suspend self (already in a suspend list or not) for at most timeout ticks,
+   return the error set by waker or -RT_ETIMEOUT */
+static rt_err_t _suspend(rt_thread_t self, rt_int32_t timeout) {
+    struct timespec ts;
+
+    self->stat = THREAD_SUSPEND;
+    self->error = RT_EOK;
+    _schedule();
+
+    if (timeout >= 0) _abs_time(&ts, (rt_tick_t)timeout);
+    while (THREAD_SUSPEND == self->stat) {
+        if (timeout < 0) {
+            (void)pthread_cond_wait(&self->cond, &_kernel);
+        } else if (ETIMEDOUT == \
+            pthread_cond_timedwait(&self->cond, &_kernel, &ts)) {
+            if (THREAD_SUSPEND == self->stat)
+                _resume(self, -RT_ETIMEOUT);
+            break;
+        }
+    }
+    _wait_cpu(self);
+    return self->error;
+}
+
+/* suspend in a FIFO list */
+static rt_err_t _suspend_in(rt_thread_t self, rt_list_t *list,
+    rt_int32_t timeout) {
+    rt_list_insert_before(list, &self->tlist);
+    return _suspend(self, timeout);
+}
+
+static rt_int32_t _remain(rt_tick_t deadline, rt_int32_t timeout) {
+    rt_tick_t now;
+
+    if (timeout < 0) return timeout;
+    now = rt_tick_get();
+    return TICK_AFTER(deadline, now) ? (rt_int32_t)(deadline - now) : 0;
+}
+
+static void _thread_init(rt_thread_t thread, const char *name,
+    rt_uint8_t priority) {
+    rt_memset(thread, 0x00, sizeof(struct rt_thread));
+    _object_init(&thread->parent, name);
+    rt_list_init(&thread->tlist);
+    thread->init_priority = priority;
+    thread->current_priority = priority;
+    (void)pthread_cond_init(&thread->cond, &_cond_attr);
+}
+
+/* adopt the calling host thread (e.g. main) as an rt thread */
+static rt_thread_t _current(void) {
+    rt_thread_t self;
+
+    if (_self) return _self;
+    _kernel_init();
+    self = malloc(sizeof(struct rt_thread));
+    RT_ASSERT(self != RT_NULL);
+    _thread_init(self, "main", RT_MAIN_THREAD_PRIORITY);
+    self->pid = pthread_self();
+    _self = self;
+    _make_ready(self);
+    _wait_cpu(self);
+    return self;
+}
+
+static rt_thread_t _enter(void) {
+    (void)pthread_mutex_lock(&_kernel);
+    return _current();
+}
+
+static void _leave(rt_thread_t self) {
+    _preempt(self);
+    (void)pthread_mutex_unlock(&_kernel);
+}
+
+static void *_thread_entry(void *param) {
+    rt_thread_t self = param;
+
+    (void)pthread_mutex_lock(&_kernel);
+    _self = self;
+    _wait_cpu(self);
+    (void)pthread_mutex_unlock(&_kernel);
+
+    self->entry(self->parameter);
+
+    (void)pthread_mutex_lock(&_kernel);
+    self->stat = THREAD_CLOSE;
+    _schedule();
+    (void)pthread_mutex_unlock(&_kernel);
+    return RT_NULL;
+}
+
+static void _timer_insert(rt_timer_t timer) {
+    rt_list_t *node;
+
+    timer->timeout_tick = rt_tick_get() + timer->init_tick;
+    rt_list_for_each(node, &_timers) {
+        rt_timer_t t = rt_list_entry(node, struct rt_timer, row);
+        if (TICK_AFTER(t->timeout_tick, timer->timeout_tick)) break;
+    }
+    rt_list_insert_before(node, &timer->row);
+    timer->parent.flag |= TIMER_ACTIVATED;
+}
+
+/* timer thread at top priority, acts as tick interrupt */
+static void _timer_entry(void *param) {
+    rt_thread_t self;
+    (void)param;
+
+    self = _enter();
+    while (1) {
+        rt_timer_t timer;
+        rt_int32_t timeout = RT_WAITING_FOREVER;
+        rt_tick_t now = rt_tick_get();
+
+        if (!rt_list_isempty(&_timers)) {
+            timer = rt_list_entry(_timers.next, struct rt_timer, row);
+            if (!TICK_AFTER(timer->timeout_tick, now)) {
+                rt_list_remove(&timer->row);
+                timer->parent.flag &= ~TIMER_ACTIVATED;
+                if (timer->parent.flag & RT_TIMER_FLAG_PERIODIC)
+                    _timer_insert(timer);
+                (void)pthread_mutex_unlock(&_kernel);
+                timer->timeout_func(timer->parameter);
+                (void)pthread_mutex_lock(&_kernel);
+                continue;
+            }
+            timeout = (rt_int32_t)(timer->timeout_tick - now);
+        }
+        (void)_suspend(self, timeout);
+    }
+}
+
+static rt_err_t _timer_thread_start(void) {
+    if (_timer_thread) return RT_EOK;
+    _timer_thread = malloc(sizeof(struct rt_thread));
+    if (!_timer_thread) return -RT_ENOMEM;
+    _thread_init(_timer_thread, "timer", TIMER_PRIORITY);
+    _timer_thread->entry = _timer_entry;
+    _ready_insert(_timer_thread);
+    if (pthread_create(&_timer_thread->pid, RT_NULL, _thread_entry,
+        _timer_thread))
+        return -RT_ERROR;
+    return RT_EOK;
+}
+
+static const char *_dfs_path(const char *path, char *buf) {
+    if ('/' != path[0]) return path;
+    (void)snprintf(buf, DFS_PATH_MAX, "%s%s", _dfs_root, path);
+    return buf;
+}
+
+/* Public functions ----------------------------------------------------------*/
+void rt_assert_handler(const char *ex, const char *func, long line) {
+    fprintf(stderr, "(%s) assertion failed at function:%s, line number:%ld\n",
+        ex, func, line);
+    abort();
+}
+
+/* thread */
+rt_thread_t rt_thread_self(void) {
+    rt_thread_t self = _enter();
+
+    (void)pthread_mutex_unlock(&_kernel);
+    return self;
+}
+
+rt_thread_t rt_thread_create(const char *name,
+    void (*entry)(void *parameter), void *parameter, rt_uint32_t stack_size,
+    rt_uint8_t priority, rt_uint32_t tick) {
+    rt_thread_t thread;
+    (void)stack_size;
+    (void)tick;
+
+    /* host stack is used, no time slice */
+    thread = malloc(sizeof(struct rt_thread));
+    if (!thread) return RT_NULL;
+    (void)pthread_mutex_lock(&_kernel);
+    _kernel_init();
+    _thread_init(thread, name, priority);
+    (void)pthread_mutex_unlock(&_kernel);
+    thread->entry = entry;
+    thread->parameter = parameter;
+    return thread;
+}
+
+rt_err_t rt_thread_startup(rt_thread_t thread) {
+    rt_thread_t self = _enter();
+    rt_err_t ret = RT_EOK;
+
+    if (THREAD_INIT != thread->stat) {
+        ret = -RT_ERROR;
+    } else {
+        _ready_insert(thread);
+        if (pthread_create(&thread->pid, RT_NULL, _thread_entry, thread)) {
+            rt_list_remove(&thread->tlist);
+            thread->stat = THREAD_INIT;
+            ret = -RT_ERROR;
+        } else {
+            (void)pthread_detach(thread->pid);
+        }
+    }
+    _leave(self);
+    return ret;
+}
+
+rt_err_t rt_thread_delay(rt_tick_t tick) {
+    rt_thread_t self = _enter();
+
+    if (!tick) {
+        _ready_insert(self);
+        _schedule();
+        _wait_cpu(self);
+    } else {
+        (void)_suspend(self, (rt_int32_t)tick);
+    }
+    _leave(self);
+    return RT_EOK;
+}
+
+rt_err_t rt_thread_mdelay(rt_int32_t ms) {
+    return rt_thread_delay(rt_tick_from_millisecond(ms));
+}
+
+rt_err_t rt_thread_yield(void) {
+    return rt_thread_delay(0);
+}
+
+/* tick and timer */
+rt_tick_t rt_tick_get(void) {
+    struct timespec now;
+
+    _kernel_init();
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    return (rt_tick_t)((now.tv_sec - _boot.tv_sec) * RT_TICK_PER_SECOND + \
+        (now.tv_nsec - _boot.tv_nsec) / (1000000000L / RT_TICK_PER_SECOND));
+}
+
+rt_tick_t rt_tick_from_millisecond(rt_int32_t ms) {
+    if (ms < 0) return (rt_tick_t)RT_WAITING_FOREVER;
+    return (rt_tick_t)((ms * RT_TICK_PER_SECOND + 999) / 1000);
+}
+
+void rt_timer_init(rt_timer_t timer, const char *name,
+    void (*timeout)(void *parameter), void *parameter, rt_tick_t time,
+    rt_uint8_t flag) {
+    _object_init(&timer->parent, name);
+    timer->parent.flag = flag & ~TIMER_ACTIVATED;
+    rt_list_init(&timer->row);
+    timer->timeout_func = timeout;
+    timer->parameter = parameter;
+    timer->init_tick = time;
+    timer->timeout_tick = 0;
+}
+
+rt_err_t rt_timer_detach(rt_timer_t timer) {
+    return rt_timer_stop(timer);
+}
+
+rt_err_t rt_timer_start(rt_timer_t timer) {
+    rt_thread_t self = _enter();
+    rt_err_t ret;
+
+    do {
+        ret = _timer_thread_start();
+        if (RT_EOK != ret) break;
+        rt_list_remove(&timer->row);
+        _timer_insert(timer);
+        /* recalculate sleep time */
+        if (THREAD_SUSPEND == _timer_thread->stat)
+            _resume(_timer_thread, RT_EOK);
+    } while (0);
+    _leave(self);
+    return ret;
+}
+
+rt_err_t rt_timer_stop(rt_timer_t timer) {
+    rt_thread_t self = _enter();
+    rt_err_t ret = -RT_ERROR;
+
+    if (timer->parent.flag & TIMER_ACTIVATED) {
+        rt_list_remove(&timer->row);
+        timer->parent.flag &= ~TIMER_ACTIVATED;
+        ret = RT_EOK;
+    }
+    _leave(self);
+    return ret;
+}
+
+rt_err_t rt_timer_control(rt_timer_t timer, int cmd, void *arg) {
+    rt_thread_t self = _enter();
+    rt_err_t ret = RT_EOK;
+
+    switch (cmd) {
+    case RT_TIMER_CTRL_SET_TIME:
+        timer->init_tick = *(rt_tick_t *)arg;
+        break;
+    case RT_TIMER_CTRL_GET_TIME:
+        *(rt_tick_t *)arg = timer->init_tick;
+        break;
+    case RT_TIMER_CTRL_SET_ONESHOT:
+        timer->parent.flag &= ~RT_TIMER_FLAG_PERIODIC;
+        break;
+    case RT_TIMER_CTRL_SET_PERIODIC:
+        timer->parent.flag |= RT_TIMER_FLAG_PERIODIC;
+        break;
+    default:
+        ret = -RT_ERROR;
+        break;
+    }
+    _leave(self);
+    return ret;
+}
+
+/* semaphore */
+rt_err_t rt_sem_init(rt_sem_t sem, const char *name, rt_uint32_t value,
+    rt_uint8_t flag) {
+    (void)flag;
+    _ipc_init(&sem->parent, name);
+    sem->value = (rt_uint16_t)value;
+    return RT_EOK;
+}
+
+rt_err_t rt_sem_detach(rt_sem_t sem) {
+    rt_thread_t self = _enter();
+
+    _resume_all(&sem->parent.suspend_thread);
+    _leave(self);
+    return RT_EOK;
+}
+
+rt_err_t rt_sem_take(rt_sem_t sem, rt_int32_t time) {
+    rt_thread_t self = _enter();
+    rt_err_t ret = RT_EOK;
+
+    if (sem->value) {
+        sem->value--;
+    } else if (!time) {
+        ret = -RT_ETIMEOUT;
+    } else {
+        /* value is passed by releaser */
+        ret = _suspend_in(self, &sem->parent.suspend_thread, time);
+    }
+    _leave(self);
+    return ret;
+}
+
+rt_err_t rt_sem_trytake(rt_sem_t sem) {
+    return rt_sem_take(sem, RT_WAITING_NO);
+}
+
+rt_err_t rt_sem_release(rt_sem_t sem) {
+    rt_thread_t self = _enter();
+    rt_err_t ret = RT_EOK;
+
+    if (!rt_list_isempty(&sem->parent.suspend_thread))
+        _resume(rt_list_entry(sem->parent.suspend_thread.next,
+            struct rt_thread, tlist), RT_EOK);
+    else if (sem->value < 0xffff)
+        sem->value++;
+    else
+        ret = -RT_EFULL;
+    _leave(self);
+    return ret;
+}
+
+/* mutex, recursive with priority inheritance */
+rt_err_t rt_mutex_init(rt_mutex_t mutex, const char *name, rt_uint8_t flag) {
+    (void)flag;
+    _ipc_init(&mutex->parent, name);
+    mutex->value = 1;
+    mutex->owner = RT_NULL;
+    mutex->original_priority = 0xff;
+    mutex->hold = 0;
+    return RT_EOK;
+}
+
+rt_err_t rt_mutex_detach(rt_mutex_t mutex) {
+    rt_thread_t self = _enter();
+
+    _resume_all(&mutex->parent.suspend_thread);
+    _leave(self);
+    return RT_EOK;
+}
+
+rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t time) {
+    rt_thread_t self = _enter();
+    rt_err_t ret = RT_EOK;
+
+    if (mutex->owner == self) {
+        mutex->hold++;
+    } else if (!mutex->owner) {
+        mutex->owner = self;
+        mutex->original_priority = self->current_priority;
+        mutex->hold = 1;
+        mutex->value = 0;
+    } else if (!time) {
+        ret = -RT_ETIMEOUT;
+    } else {
+        rt_thread_t owner = mutex->owner;
+
+        if (self->current_priority < owner->current_priority) {
+            owner->current_priority = self->current_priority;
+            if (THREAD_READY == owner->stat) {
+                rt_list_remove(&owner->tlist);
+                _ready_insert(owner);
+            }
+        }
+        /* ownership is passed by releaser */
+        ret = _suspend_in(self, &mutex->parent.suspend_thread, time);
+    }
+    _leave(self);
+    return ret;
+}
+
+rt_err_t rt_mutex_release(rt_mutex_t mutex) {
+    rt_thread_t self = _enter();
+    rt_err_t ret = RT_EOK;
+
+    do {
+        if (mutex->owner != self) {
+            ret = -RT_ERROR;
+            break;
+        }
+        if (--mutex->hold) break;
+
+        self->current_priority = self->init_priority;
+        if (!rt_list_isempty(&mutex->parent.suspend_thread)) {
+            rt_thread_t next = rt_list_entry(
+                mutex->parent.suspend_thread.next, struct rt_thread, tlist);
+
+            mutex->owner = next;
+            mutex->original_priority = next->current_priority;
+            mutex->hold = 1;
+            _resume(next, RT_EOK);
+        } else {
+            mutex->owner = RT_NULL;
+            mutex->original_priority = 0xff;
+            mutex->value = 1;
+        }
+    } while (0);
+    _leave(self);
+    return ret;
+}
+
+/* event */
+static rt_bool_t _event_match(rt_uint32_t have, rt_uint32_t set,
+    rt_uint8_t opt) {
+    if (opt & RT_EVENT_FLAG_AND) return (have & set) == set;
+    return (have & set) != 0;
+}
+
+rt_err_t rt_event_init(rt_event_t event, const char *name, rt_uint8_t flag) {
+    (void)flag;
+    _ipc_init(&event->parent, name);
+    event->set = 0;
+    return RT_EOK;
+}
+
+rt_err_t rt_event_detach(rt_event_t event) {
+    rt_thread_t self = _enter();
+
+    _resume_all(&event->parent.suspend_thread);
+    _leave(self);
+    return RT_EOK;
+}
+
+rt_err_t rt_event_send(rt_event_t event, rt_uint32_t set) {
+    rt_thread_t self = _enter();
+    rt_list_t *node = event->parent.suspend_thread.next;
+
+    event->set |= set;
+    while (node != &event->parent.suspend_thread) {
+        rt_thread_t t = rt_list_entry(node, struct rt_thread, tlist);
+
+        node = node->next;
+        if (!_event_match(event->set, t->event_set, t->event_info)) continue;
+        t->event_set &= event->set;
+        if (t->event_info & RT_EVENT_FLAG_CLEAR)
+            event->set &= ~t->event_set;
+        _resume(t, RT_EOK);
+    }
+    _leave(self);
+    return RT_EOK;
+}
+
+rt_err_t rt_event_recv(rt_event_t event, rt_uint32_t set, rt_uint8_t opt,
+    rt_int32_t timeout, rt_uint32_t *recved) {
+    rt_thread_t self = _enter();
+    rt_err_t ret = RT_EOK;
+
+    if (_event_match(event->set, set, opt)) {
+        self->event_set = event->set & set;
+        if (opt & RT_EVENT_FLAG_CLEAR)
+            event->set &= ~self->event_set;
+    } else if (!timeout) {
+        ret = -RT_ETIMEOUT;
+    } else {
+        self->event_set = set;
+        self->event_info = opt;
+        ret = _suspend_in(self, &event->parent.suspend_thread, timeout);
+    }
+    if ((RT_EOK == ret) && recved) *recved = self->event_set;
+    _leave(self);
+    return ret;
+}
+
+/* mailbox */
+rt_err_t rt_mb_init(rt_mailbox_t mb, const char *name, void *msgpool,
+    rt_size_t size, rt_uint8_t flag) {
+    (void)flag;
+    _ipc_init(&mb->parent, name);
+    mb->msg_pool = msgpool;
+    mb->size = (rt_uint16_t)size;
+    mb->entry = 0;
+    mb->in_offset = 0;
+    mb->out_offset = 0;
+    rt_list_init(&mb->suspend_sender_thread);
+    return RT_EOK;
+}
+
+rt_err_t rt_mb_detach(rt_mailbox_t mb) {
+    rt_thread_t self = _enter();
+
+    _resume_all(&mb->parent.suspend_thread);
+    _resume_all(&mb->suspend_sender_thread);
+    _leave(self);
+    return RT_EOK;
+}
+
+rt_mailbox_t rt_mb_create(const char *name, rt_size_t size, rt_uint8_t flag) {
+    rt_mailbox_t mb;
+
+    mb = malloc(sizeof(struct rt_mailbox) + size * sizeof(rt_ubase_t));
+    if (!mb) return RT_NULL;
+    (void)rt_mb_init(mb, name, mb + 1, size, flag);
+    return mb;
+}
+
+rt_err_t rt_mb_delete(rt_mailbox_t mb) {
+    (void)rt_mb_detach(mb);
+    free(mb);
+    return RT_EOK;
+}
+
+rt_err_t rt_mb_send_wait(rt_mailbox_t mb, rt_ubase_t value,
+    rt_int32_t timeout) {
+    rt_thread_t self = _enter();
+    rt_tick_t deadline = rt_tick_get() + (rt_tick_t)timeout;
+    rt_err_t ret = RT_EOK;
+
+    while (mb->entry == mb->size) {
+        rt_int32_t remain = _remain(deadline, timeout);
+
+        if (!remain) {
+            ret = -RT_EFULL;
+            break;
+        }
+        ret = _suspend_in(self, &mb->suspend_sender_thread, remain);
+        if (-RT_ETIMEOUT == ret) ret = -RT_EFULL;
+        if (RT_EOK != ret) break;
+    }
+    if (RT_EOK == ret) {
+        mb->msg_pool[mb->in_offset] = value;
+        if (++mb->in_offset >= mb->size) mb->in_offset = 0;
+        mb->entry++;
+        if (!rt_list_isempty(&mb->parent.suspend_thread))
+            _resume(rt_list_entry(mb->parent.suspend_thread.next,
+                struct rt_thread, tlist), RT_EOK);
+    }
+    _leave(self);
+    return ret;
+}
+
+rt_err_t rt_mb_send(rt_mailbox_t mb, rt_ubase_t value) {
+    return rt_mb_send_wait(mb, value, RT_WAITING_NO);
+}
+
+rt_err_t rt_mb_recv(rt_mailbox_t mb, rt_ubase_t *value, rt_int32_t timeout) {
+    rt_thread_t self = _enter();
+    rt_tick_t deadline = rt_tick_get() + (rt_tick_t)timeout;
+    rt_err_t ret = RT_EOK;
+
+    while (!mb->entry) {
+        rt_int32_t remain = _remain(deadline, timeout);
+
+        if (!remain) {
+            ret = -RT_ETIMEOUT;
+            break;
+        }
+        ret = _suspend_in(self, &mb->parent.suspend_thread, remain);
+        if (RT_EOK != ret) break;
+    }
+    if (RT_EOK == ret) {
+        *value = mb->msg_pool[mb->out_offset];
+        if (++mb->out_offset >= mb->size) mb->out_offset = 0;
+        mb->entry--;
+        if (!rt_list_isempty(&mb->suspend_sender_thread))
+            _resume(rt_list_entry(mb->suspend_sender_thread.next,
+                struct rt_thread, tlist), RT_EOK);
+    }
+    _leave(self);
+    return ret;
+}
+
+/* memory pool, each block is headed by its pool */
+rt_mp_t rt_mp_create(const char *name, rt_size_t block_count,
+    rt_size_t block_size) {
+    rt_mp_t mp;
+    rt_uint8_t *block;
+    rt_size_t i;
+
+    block_size = (block_size + RT_ALIGN_SIZE - 1) & ~(RT_ALIGN_SIZE - 1);
+    mp = malloc(sizeof(struct rt_mempool));
+    if (!mp) return RT_NULL;
+    mp->size = block_count * (block_size + sizeof(rt_uint8_t *));
+    mp->start_address = malloc(mp->size);
+    if (!mp->start_address) {
+        free(mp);
+        return RT_NULL;
+    }
+    _object_init(&mp->parent, name);
+    rt_list_init(&mp->suspend_thread);
+    mp->block_size = block_size;
+    mp->block_total_count = block_count;
+    mp->block_free_count = block_count;
+
+    mp->block_list = RT_NULL;
+    block = mp->start_address;
+    for (i = 0; i < block_count; i++) {
+        /* free block links to next free one */
+        *(rt_uint8_t **)block = mp->block_list;
+        mp->block_list = block;
+        block += block_size + sizeof(rt_uint8_t *);
+    }
+    return mp;
+}
+
+rt_err_t rt_mp_delete(rt_mp_t mp) {
+    rt_thread_t self = _enter();
+
+    _resume_all(&mp->suspend_thread);
+    _leave(self);
+    free(mp->start_address);
+    free(mp);
+    return RT_EOK;
+}
+
+void *rt_mp_alloc(rt_mp_t mp, rt_int32_t time) {
+    rt_thread_t self = _enter();
+    rt_tick_t deadline = rt_tick_get() + (rt_tick_t)time;
+    rt_uint8_t *block = RT_NULL;
+
+    while (!mp->block_free_count) {
+        rt_int32_t remain = _remain(deadline, time);
+
+        if (!remain) break;
+        if (RT_EOK != _suspend_in(self, &mp->suspend_thread, remain)) break;
+    }
+    if (mp->block_free_count) {
+        block = mp->block_list;
+        mp->block_list = *(rt_uint8_t **)block;
+        mp->block_free_count--;
+        *(rt_mp_t *)block = mp;
+        block += sizeof(rt_uint8_t *);
+    }
+    _leave(self);
+    return block;
+}
+
+void rt_mp_free(void *block) {
+    rt_thread_t self = _enter();
+    rt_uint8_t *head = (rt_uint8_t *)block - sizeof(rt_uint8_t *);
+    rt_mp_t mp = *(rt_mp_t *)head;
+
+    *(rt_uint8_t **)head = mp->block_list;
+    mp->block_list = head;
+    mp->block_free_count++;
+    if (!rt_list_isempty(&mp->suspend_thread))
+        _resume(rt_list_entry(mp->suspend_thread.next, struct rt_thread,
+            tlist), RT_EOK);
+    _leave(self);
+}
+
+/* interrupt and scheduler, no other thread runs meanwhile, only preemption
+   is held back */
+rt_base_t rt_hw_interrupt_disable(void) {
+    rt_base_t level;
+
+    (void)_enter();
+    level = _irq_nest++;
+    (void)pthread_mutex_unlock(&_kernel);
+    return level;
+}
+
+void rt_hw_interrupt_enable(rt_base_t level) {
+    rt_thread_t self = _enter();
+
+    _irq_nest = level;
+    _leave(self);
+}
+
+void rt_enter_critical(void) {
+    (void)_enter();
+    _sched_lock++;
+    (void)pthread_mutex_unlock(&_kernel);
+}
+
+void rt_exit_critical(void) {
+    rt_thread_t self = _enter();
+
+    if (_sched_lock) _sched_lock--;
+    _leave(self);
+}
+
+/* device */
+rt_err_t rt_device_register(rt_device_t dev, const char *name,
+    rt_uint16_t flags) {
+    if (!dev) return -RT_ERROR;
+    if (rt_device_find(name)) return -RT_ERROR;
+
+    (void)pthread_mutex_lock(&_kernel);
+    _object_init(&dev->parent, name);
+    dev->flag = flags;
+    dev->ref_count = 0;
+    dev->open_flag = 0;
+    rt_list_insert_before(&_devices, &dev->parent.list);
+    (void)pthread_mutex_unlock(&_kernel);
+    return RT_EOK;
+}
+
+rt_err_t rt_device_unregister(rt_device_t dev) {
+    (void)pthread_mutex_lock(&_kernel);
+    rt_list_remove(&dev->parent.list);
+    (void)pthread_mutex_unlock(&_kernel);
+    return RT_EOK;
+}
+
+rt_device_t rt_device_find(const char *name) {
+    rt_device_t dev = RT_NULL;
+    rt_list_t *node;
+
+    (void)pthread_mutex_lock(&_kernel);
+    rt_list_for_each(node, &_devices) {
+        rt_device_t d = rt_list_entry(node, struct rt_device, parent.list);
+        if (!rt_strncmp(d->parent.name, name, RT_NAME_MAX)) {
+            dev = d;
+            break;
+        }
+    }
+    (void)pthread_mutex_unlock(&_kernel);
+    return dev;
+}
+
+rt_err_t rt_device_open(rt_device_t dev, rt_uint16_t oflag) {
+    rt_err_t ret = RT_EOK;
+
+    if (!(dev->flag & RT_DEVICE_FLAG_ACTIVATED)) {
+        if (dev->init) ret = dev->init(dev);
+        if (RT_EOK != ret) return ret;
+        dev->flag |= RT_DEVICE_FLAG_ACTIVATED;
+    }
+    if (dev->open) ret = dev->open(dev, oflag);
+    if (RT_EOK == ret) {
+        dev->open_flag = oflag | RT_DEVICE_OFLAG_OPEN;
+        dev->ref_count++;
+    }
+    return ret;
+}
+
+rt_err_t rt_device_close(rt_device_t dev) {
+    rt_err_t ret = RT_EOK;
+
+    if (!dev->ref_count) return -RT_ERROR;
+    if (--dev->ref_count) return RT_EOK;
+    if (dev->close) ret = dev->close(dev);
+    if (RT_EOK == ret) dev->open_flag = RT_DEVICE_OFLAG_CLOSE;
+    return ret;
+}
+
+rt_size_t rt_device_read(rt_device_t dev, rt_off_t pos, void *buffer,
+    rt_size_t size) {
+    if (!dev->read) return 0;
+    return dev->read(dev, pos, buffer, size);
+}
+
+rt_size_t rt_device_write(rt_device_t dev, rt_off_t pos, const void *buffer,
+    rt_size_t size) {
+    if (!dev->write) return 0;
+    return dev->write(dev, pos, buffer, size);
+}
+
+rt_err_t rt_device_control(rt_device_t dev, int cmd, void *arg) {
+    if (!dev->control) return -RT_ENOSYS;
+    return dev->control(dev, cmd, arg);
+}
+
+/* memory and string */
+void *rt_malloc(rt_size_t size) {
+    return malloc(size);
+}
+
+void *rt_realloc(void *ptr, rt_size_t size) {
+    return realloc(ptr, size);
+}
+
+void *rt_calloc(rt_size_t count, rt_size_t size) {
+    return calloc(count, size);
+}
+
+void rt_free(void *ptr) {
+    free(ptr);
+}
+
+char *rt_strdup(const char *s) {
+    return strdup(s);
+}
+
+void rt_kprintf(const char *fmt, ...) {
+    va_list args;
+
+    va_start(args, fmt);
+    (void)vprintf(fmt, args);
+    va_end(args);
+    (void)fflush(stdout);
+}
+
+int rt_snprintf(char *buf, rt_size_t size, const char *fmt, ...) {
+    va_list args;
+    int ret;
+
+    va_start(args, fmt);
+    ret = vsnprintf(buf, size, fmt, args);
+    va_end(args);
+    return ret;
+}
+
+void ulog_output(rt_uint32_t level, const char *tag, const char *format,
+    ...) {
+    static const char lvl[] = "A??EW?ID";
+    va_list args;
+
+    printf("%c/%s: ", lvl[level & 0x07], tag);
+    va_start(args, format);
+    (void)vprintf(format, args);
+    va_end(args);
+    printf("\n");
+    (void)fflush(stdout);
+}
+
+/* DFS */
+void dfs_host_set_root(const char *dir) {
+    (void)snprintf(_dfs_root, sizeof(_dfs_root), "%s", dir);
+}
+
+int dfs_host_open(const char *path, int flags, ...) {
+    char buf[DFS_PATH_MAX];
+
+    /* DFS ignores mode */
+    return open(_dfs_path(path, buf), flags, 0644);
+}
+
+int dfs_host_stat(const char *path, struct stat *st) {
+    char buf[DFS_PATH_MAX];
+
+    return stat(_dfs_path(path, buf), st);
+}
+
+DIR *dfs_host_opendir(const char *path) {
+    char buf[DFS_PATH_MAX];
+
+    return opendir(_dfs_path(path, buf));
+}
+
+int dfs_host_unlink(const char *path) {
+    char buf[DFS_PATH_MAX];
+
+    return unlink(_dfs_path(path, buf));
+}
+
+int dfs_host_mkdir(const char *path, mode_t mode) {
+    char buf[DFS_PATH_MAX];
+
+    return mkdir(_dfs_path(path, buf), mode);
+}
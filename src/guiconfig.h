@@ -93,6 +93,46 @@
 # define RTGUI_USING_FRAMEBUFFER
 #endif
 
+/* clip update allocates region data from a static arena of ARENA_SIZE bytes
+   and falls back to heap when full */
+// #define RTGUI_USING_REGION_ARENA
+#define RTGUI_REGION_ARENA_SIZE             (1024)
+
+/* Screen Update Config */
+
+/* damaged rects are updated as one bounding box when more than MAX_RECTS or
+   when they cover at least MERGE_PERCENT of the bounding box */
+#define RTGUI_DAMAGE_MAX_RECTS              (4)
+#define RTGUI_DAMAGE_MERGE_PERCENT          (70)
+
+/* draw without UPDATE_BEGIN/END events to server when cursor is away from
+   the window, damage is updated when the app has no more pending event */
+// #define RTGUI_USING_DIRECT_DRAWING
+
+/* ordered dither gradient fills on RGB565 display to reduce banding */
+// #define RTGUI_USING_GRADIENT_DITHER
+
+/* draw in RAM bands of BAND_HEIGHT lines for device without framebuffer */
+// #define RTGUI_USING_BAND_BUFFER
+#define RTGUI_BAND_HEIGHT                   (16)
+
+/* draw to back buffer and flip (or copy) at commit for framebuffer device */
+// #define RTGUI_USING_DOUBLE_BUFFER
+
+/* update screen in a thread, at most UPDATE_QUEUE_SIZE rects are queued */
+// #define RTGUI_USING_ASYNC_UPDATE
+#define RTGUI_UPDATE_QUEUE_SIZE             (4)
+#define RTGUI_UPDATE_PRIORITY               (RTGUI_SERVER_PRIORITY)
+#define RTGUI_UPDATE_STACK_SIZE             (512)
+
+/* in-memory display and scripted input devices, e.g. for simulator BSP */
+// #define RTGUI_USING_SIMULATOR
+/* simulated display also provides mock graphic extension ops (counted) */
+// #define RTGUI_USING_SIM_EXT_OPS
+
+/* record widget drawing and replay it on repaint, see rtgui_dc_list_attach() */
+// #define RTGUI_USING_DISPLAY_LIST
+
 
 /* Color Config */
 
@@ -53,7 +53,7 @@ void rtgui_free(void *ptr);
 void *rtgui_realloc(void *ptr, rt_size_t size);
 
 void rtgui_get_screen_rect(rtgui_rect_t *rect);
-void rtgui_screen_lock(rt_int32_t timeout);
+rt_err_t rtgui_screen_lock(rt_int32_t timeout);
 void rtgui_screen_unlock(void);
 rt_uint8_t rtgui_screen_lock_freeze(void);
 void rtgui_screen_lock_thaw(rt_uint8_t cnt);
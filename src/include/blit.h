@@ -56,6 +56,9 @@ extern "C" {
 /* Exported constants --------------------------------------------------------*/
 /* Exported defines ----------------------------------------------------------*/
 /* Exported types ------------------------------------------------------------*/
+/* convert len bytes of src line to dst line
+ * - sources with alpha (ARGB888 as R, G, B, A bytes and ARGB565 as RGB565
+ *   plus A bytes) are blended over dst, which must hold the background */
 typedef void (*rtgui_blit_line_func)(rt_uint8_t *_dst, rt_uint8_t *_src,
     rt_uint32_t len, rt_uint8_t scale, rtgui_image_palette_t *palette);
 
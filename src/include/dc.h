@@ -42,6 +42,8 @@ extern "C" {
 typedef enum rtgui_dc_type {
     RTGUI_DC_HW,
     RTGUI_DC_CLIENT,
+    RTGUI_DC_BUFFER,
+    RTGUI_DC_RECORD,
 } rtgui_dc_type_t;
 
 struct rtgui_dc_engine {
@@ -79,6 +81,46 @@ struct rtgui_dc_hw {
     const rtgui_gfx_driver_t *hw_driver;
 };
 
+/*
+ * The buffer device context
+ *
+ * The buffer DC is an offscreen canvas in the pixel format of display. The
+ * content is shown by blitting to a hardware or client DC.
+ *
+ */
+struct rtgui_dc_buffer {
+    rtgui_dc_t _super;
+    rtgui_gc_t gc;
+    rt_uint8_t pixel_format;
+    rt_uint8_t bpp;                         /* byte per pixel */
+    rt_uint16_t width;
+    rt_uint16_t height;
+    rt_uint16_t pitch;
+    rt_uint8_t *pixel;
+};
+
+/*
+ * The record device context
+ *
+ * The record DC forwards drawing to a hardware or client DC and records it
+ * to the display list of owner, which is replayed on next repaint.
+ *
+ */
+struct rtgui_dc_record {
+    rtgui_dc_t _super;
+    rtgui_dc_t *dc;                         /* the drawing dc */
+    rtgui_widget_t *owner;
+};
+
+/* polygon edge, the scratch of rtgui_dc_fill_polygon_buf() */
+struct rtgui_poly_edge {
+    rt_int32_t x;                           /* 16.16 x at current line */
+    rt_int32_t dx;                          /* integer part of x step */
+    rt_int32_t rem;                         /* remainder of x step */
+    rt_int32_t err;                         /* accumulated remainder */
+    rt_int16_t y1;                          /* first line */
+    rt_int16_t y2;                          /* last line, exclusive */
+};
 
 #define RTGUI_DC(dc)            ((rtgui_dc_t*)(dc))
 #define RTGUI_DC_FC(dc)         (rtgui_dc_get_gc(RTGUI_DC(dc))->foreground)
@@ -86,6 +128,10 @@ struct rtgui_dc_hw {
 #define RTGUI_DC_FONT(dc)       (rtgui_dc_get_gc(RTGUI_DC(dc))->font)
 #define RTGUI_DC_TEXTALIGN(dc)  (rtgui_dc_get_gc(RTGUI_DC(dc))->textalign)
 
+/* scratch size in byte to fill a polygon of count vertices */
+#define RTGUI_POLY_SCRATCH_SIZE(count) \
+    (2 * (count) * sizeof(struct rtgui_poly_edge))
+
 /* Exported constants --------------------------------------------------------*/
 
 #undef __RTGUI_DC_H__
@@ -99,6 +145,38 @@ rtgui_dc_t *rtgui_dc_hw_create(rtgui_widget_t *owner);
 /* create a client dc */
 rtgui_dc_t *rtgui_dc_client_create(rtgui_widget_t *owner);
 void rtgui_dc_client_init(rtgui_widget_t *owner);
+/* create a buffer dc */
+rtgui_dc_t *rtgui_dc_buffer_create(int width, int height);
+rt_uint8_t *rtgui_dc_buffer_get_pixel(rtgui_dc_t *dc);
+/* add device area (x2, y2 not included) drawn by dc of owner to the damage
+   reported by rtgui_dc_end_drawing(), clipped by owner */
+void rtgui_dc_damage(rtgui_widget_t *owner, int x1, int y1, int x2, int y2);
+/* blit screen pixels at device point to dc */
+void rtgui_dc_blit_screen(struct rtgui_point *point, rtgui_dc_t *dst,
+    rtgui_rect_t *rect);
+/* read back pixels of dc line, e.g. as destination of alpha blending */
+rt_err_t rtgui_dc_read_line(rtgui_dc_t *dc, int x1, int x2, int y,
+    rt_uint8_t *line);
+/* move pixels of dc, e.g. for scrolling, and get the area to repaint */
+rt_err_t rtgui_dc_copy_area(rtgui_dc_t *dc, rtgui_rect_t *rect, int dx,
+    int dy, rtgui_region_t *exposed);
+
+/* display list of widget, recorded by begin and end drawing
+ * - rtgui_dc_list_replay() draws the list, or arms recording of the next
+ *   drawing and returns RT_FALSE
+ * - the list is invalid when the owner draws out of recording, or marked
+ *   dirty (e.g. state changed without drawing) */
+#ifdef RTGUI_USING_DISPLAY_LIST
+rt_err_t rtgui_dc_list_attach(rtgui_widget_t *owner, rt_uint32_t size);
+void rtgui_dc_list_detach(rtgui_widget_t *owner);
+void rtgui_dc_list_dirty(rtgui_widget_t *owner);
+rt_bool_t rtgui_dc_list_replay(rtgui_widget_t *owner);
+rtgui_dc_t *rtgui_dc_record_begin(rtgui_widget_t *owner, rtgui_dc_t *dc);
+rtgui_dc_t *rtgui_dc_record_end(rtgui_dc_t *dc);
+#else
+# define rtgui_dc_list_dirty(owner)
+# define rtgui_dc_list_replay(owner)        (RT_FALSE)
+#endif
 
 /* begin and end a drawing */
 rtgui_dc_t *rtgui_dc_begin_drawing(rtgui_widget_t *owner);
@@ -109,18 +187,27 @@ void rtgui_dc_draw_rect(rtgui_dc_t *dc, rtgui_rect_t *rect);
 void rtgui_dc_fill_rect_forecolor(rtgui_dc_t *dc, rtgui_rect_t *rect);
 void rtgui_dc_draw_round_rect(rtgui_dc_t *dc, rtgui_rect_t *rect, int r);
 void rtgui_dc_fill_round_rect(rtgui_dc_t *dc, rtgui_rect_t *rect, int r);
-/** Fill a vertical gradient rect from @c1 to @c2 */
+/** Fill a vertical gradient rect from @c1 (top) to @c2 (bottom) */
 void rtgui_dc_fill_gradient_rectv(rtgui_dc_t *dc, rtgui_rect_t *rect,
                                   rtgui_color_t c1, rtgui_color_t c2);
+/** Fill a horizontal gradient rect from @c1 (left) to @c2 (right) */
+void rtgui_dc_fill_gradient_recth(rtgui_dc_t *dc, rtgui_rect_t *rect,
+                                  rtgui_color_t c1, rtgui_color_t c2);
 void rtgui_dc_draw_annulus(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_t r1, rt_int16_t r2, rt_int16_t start, rt_int16_t end);
 void rtgui_dc_draw_pie(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_t r, rt_int16_t start, rt_int16_t end);
 void rtgui_dc_fill_pie(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_t r, rt_int16_t start, rt_int16_t end);
+void rtgui_dc_fill_annulus(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y,
+    rt_int16_t r1, rt_int16_t r2, rt_int16_t start, rt_int16_t end);
 
 void rtgui_dc_draw_text(rtgui_dc_t *dc, const char *text, rtgui_rect_t *rect);
 void rtgui_dc_draw_text_stroke(rtgui_dc_t *dc, const char *text, rtgui_rect_t *rect,
                                rtgui_color_t color_stroke, rtgui_color_t color_core);
 
 void rtgui_dc_draw_mono_bmp(rtgui_dc_t *dc, int x, int y, int w, int h, const rt_uint8_t *data);
+void rtgui_dc_draw_mono_bmp_opaque(rtgui_dc_t *dc, int x, int y, int w, int h,
+    const rt_uint8_t *data);
+rtgui_dc_t *rtgui_dc_mono_bmp_cache(int w, int h, const rt_uint8_t *data,
+    rtgui_color_t fc, rtgui_color_t bc);
 void rtgui_dc_draw_byte(rtgui_dc_t *dc, int x, int y, int h, const rt_uint8_t *data);
 void rtgui_dc_draw_word(rtgui_dc_t *dc, int x, int y, int h, const rt_uint8_t *data);
 
@@ -131,6 +218,10 @@ void rtgui_dc_draw_focus_rect(rtgui_dc_t *dc, rtgui_rect_t *rect);
 
 void rtgui_dc_draw_polygon(rtgui_dc_t *dc, const int *vx, const int *vy, int count);
 void rtgui_dc_fill_polygon(rtgui_dc_t *dc, const int *vx, const int *vy, int count);
+/* fill polygon with caller's (word aligned) scratch buffer, no heap used
+ * - size should be at least RTGUI_POLY_SCRATCH_SIZE(count) */
+rt_err_t rtgui_dc_fill_polygon_buf(rtgui_dc_t *dc, const int *vx,
+    const int *vy, int count, void *scratch, rt_uint32_t size);
 
 void rtgui_dc_draw_circle(rtgui_dc_t *dc, int x, int y, int r);
 void rtgui_dc_fill_circle(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_t r);
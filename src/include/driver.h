@@ -29,8 +29,25 @@
 #ifdef IMPORT_TYPES
 
 /* Exported defines ----------------------------------------------------------*/
+/* set the framebuffer for scan-out (optional), args is the address */
+#define RTGUI_GRAPHIC_CTRL_FLIP     (0x80)
+/* copy a rect on screen (optional, e.g. GRAM copy), args is
+   struct rtgui_gfx_copy_info */
+#define RTGUI_GRAPHIC_CTRL_COPY     (0x81)
+
 /* Exported types ------------------------------------------------------------*/
 typedef struct rtgui_gfx_driver rtgui_gfx_driver_t;
+/* called in update thread when a rect is updated to device, or (overlay
+   hook) when a rect (RT_NULL for all) of scanout is copied from or flipped
+   with back buffer */
+typedef void (*rtgui_gfx_update_hook_t)(rtgui_rect_t *rect);
+
+/* pixels of rect moved by (-dx, -dy) are copied to rect, in device
+   coordinate and (x2, y2) is not included, the rects may overlap */
+struct rtgui_gfx_copy_info {
+    rtgui_rect_t rect;
+    int dx, dy;
+};
 
 /* graphic driver operations */
 struct rtgui_graphic_driver_ops {
@@ -39,9 +56,19 @@ struct rtgui_graphic_driver_ops {
     void (*draw_hline)(rtgui_color_t *c, int x1, int x2, int y);
     void (*draw_vline)(rtgui_color_t *c, int x , int y1, int y2);
     void (*draw_raw_hline)(rt_uint8_t *pixels, int x1, int x2, int y);
+    /* bulk operations (optional, set to RT_NULL if not supported)
+     * - rect is in device coordinate, (x2, y2) is not included
+     * - pitch is the byte offset between two lines of pixels */
+    void (*fill_rect)(rtgui_color_t *c, rtgui_rect_t *rect);
+    void (*blit_rect)(rt_uint8_t *pixels, rt_uint32_t pitch,
+        rtgui_rect_t *rect);
+    /* read back (optional), the reverse of draw_raw_hline (x2 not included) */
+    void (*read_raw_hline)(rt_uint8_t *pixels, int x1, int x2, int y);
 };
 
-/* graphic extension operations */
+/* graphic extension operations (optional, set to RT_NULL if not supported)
+ * - used by dc only when the shape needs no clipping
+ * - coordinates are in device coordinate, c is in rtgui color format */
 struct rtgui_graphic_ext_ops {
     void (*draw_line)(rtgui_color_t *c, int x1, int y1, int x2, int y2);
     void (*draw_rect)(rtgui_color_t *c, int x1, int y1, int x2, int y2);
@@ -62,8 +89,14 @@ struct rtgui_gfx_driver {
     rt_uint16_t height;
     /* framebuffer address and ops */
     rt_uint8_t *framebuffer;
+    /* framebuffer shown by device, differs from the above (back buffer)
+       when using double buffer */
+    rt_uint8_t *scanout;
     struct rt_device* device;
     const struct rtgui_graphic_driver_ops *ops;
+    /* ops without color conversion, the color should be converted by
+       rtgui_gfx_native_color() first (optional ops may be RT_NULL) */
+    const struct rtgui_graphic_driver_ops *native_ops;
     const struct rtgui_graphic_ext_ops *ext_ops;
 };
 
@@ -84,7 +117,30 @@ rt_err_t rtgui_set_gfx_device(rt_device_t dev);
 REFERENCE_GETTER_PROTOTYPE(gfx_device, rtgui_gfx_driver_t);
 void rtgui_gfx_get_rect(const rtgui_gfx_driver_t *driver, rtgui_rect_t *rect);
 void rtgui_gfx_update_screen(const rtgui_gfx_driver_t *driver, rtgui_rect_t *rect);
+void rtgui_gfx_damage_screen(const rtgui_gfx_driver_t *driver, rtgui_rect_t *rect);
+void rtgui_gfx_commit_screen(const rtgui_gfx_driver_t *driver);
+void rtgui_gfx_fence_screen(const rtgui_gfx_driver_t *driver, rtgui_rect_t *rect);
+#ifdef RTGUI_USING_ASYNC_UPDATE
+    SETTER_PROTOTYPE(gfx_update_hook, rtgui_gfx_update_hook_t);
+#endif
+#ifdef RTGUI_USING_DOUBLE_BUFFER
+    SETTER_PROTOTYPE(gfx_overlay_hook, rtgui_gfx_update_hook_t);
+    /* area drawn by overlay hook on scanout, removed from back buffer at
+       flip */
+    SETTER_PROTOTYPE(gfx_overlay_rect, rtgui_rect_t);
+#endif
+#ifdef RTGUI_USING_BAND_BUFFER
+    rt_bool_t rtgui_gfx_band_start(const rtgui_rect_t *rect);
+    rt_bool_t rtgui_gfx_band_next(void);
+#endif
 rt_uint8_t *rtgui_gfx_get_framebuffer(const rtgui_gfx_driver_t *driver);
+rt_err_t rtgui_gfx_read_rect(const rtgui_gfx_driver_t *driver,
+    rtgui_rect_t *rect, rt_uint8_t *pixels, rt_uint32_t pitch);
+rt_err_t rtgui_gfx_copy_rect(const rtgui_gfx_driver_t *driver,
+    rtgui_rect_t *rect, int dx, int dy);
+rtgui_color_t rtgui_gfx_native_color(rtgui_color_t c);
+/* color in the pixel format of draw_raw_hline */
+rtgui_color_t rtgui_gfx_raw_color(rtgui_color_t c);
 
 #ifdef CONFIG_TOUCH_DEVICE_NAME
     rt_err_t rtgui_set_touch_device(rt_device_t dev);
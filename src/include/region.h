@@ -36,10 +36,10 @@ extern "C" {
 /* Exported defines ----------------------------------------------------------*/
 /*  true if rect r1 and r2 are overlap */
 #define IS_R_INTERSECT(r1, r2)      \
-    (  !((r1)->x2 <= (r2)->x1)  ||  \
+    (!( ((r1)->x2 <= (r2)->x1)  ||  \
         ((r1)->x1 >= (r2)->x2)  ||  \
         ((r1)->y2 <= (r2)->y1)  ||  \
-        ((r1)->y1 >= (r2)->y2)  )
+        ((r1)->y1 >= (r2)->y2)  ))
 
 /* true if rect contains point (x, y) */
 #define IS_P_INSIDE(r, x, y)    \
@@ -50,17 +50,17 @@ extern "C" {
 
 /* true if vline intersect rect */
 #define IS_VL_INTERSECT(r, x, y1, y2) \
-    (  !((r)->x1 >  ( x))   ||  \
+    (!( ((r)->x1 >  ( x))   ||  \
         ((r)->x2 <= ( x))   ||  \
         ((r)->y2 <= (y1))   ||  \
-        ((r)->y1 >  (y2))   )
+        ((r)->y1 >  (y2))   ))
 
 /* true if hline intersect rect */
 #define IS_HL_INTERSECT(r, x1, x2, y) \
-    (  !((r)->y1 >  ( y))   ||  \
+    (!( ((r)->y1 >  ( y))   ||  \
         ((r)->y2 <= ( y))   ||  \
         ((r)->x2 <= (x1))   ||  \
-        ((r)->x1 >  (x2))   )
+        ((r)->x1 >  (x2))   ))
 
 /* true if rect r1 contains rect r2 */
 #define IS_R_INSIDE(r1, r2)         \
@@ -127,6 +127,10 @@ void rtgui_region_uninit(rtgui_region_t *region);
 rt_uint32_t rtgui_region_num_rects(rtgui_region_t *region);
 rtgui_rect_t *rtgui_region_rects(rtgui_region_t *region);
 r_op_status_t rtgui_region_copy(rtgui_region_t *dst, rtgui_region_t *src);
+/* clip update pass with region data from arena, see guiconfig.h */
+rt_bool_t rtgui_region_arena_begin(void);
+void rtgui_region_arena_end(void);
+void rtgui_region_arena_keep(rtgui_region_t *region);
 
 void rtgui_region_translate(rtgui_region_t *region, int x, int y);
 
@@ -0,0 +1,87 @@
+/*
+ * File      : simulator.h
+ * This file is part of RT-Thread GUI Engine
+ * COPYRIGHT (C) 2006 - 2017, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2019-07-05     onelife      first version
+ * 2019-07-13     onelife      add mock graphic extension ops
+ * 2019-07-14     onelife      add transfer speed of display
+ * 2019-08-24     onelife      add flip and copy control
+ */
+#ifndef __RTGUI_SIMULATOR_H__
+#define __RTGUI_SIMULATOR_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "include/rtgui.h"
+#include "include/filerw.h"
+
+/* Exported defines ----------------------------------------------------------*/
+#define RTGUI_SIM_LCD_NAME                  "SIM_LCD"
+#define RTGUI_SIM_TOUCH_NAME                "SIM_TCH"
+#define RTGUI_SIM_KEY_NAME                  "SIM_KEY"
+
+/* same as Arduino port, for hosts without "drv_common.h" */
+#ifndef RT_DEVICE_CTRL_SET_RX_INDICATOR
+# define RT_DEVICE_CTRL_SET_RX_INDICATOR    (0x20)
+#endif
+
+/* Exported types ------------------------------------------------------------*/
+/* counters of the simulated display */
+struct rtgui_sim_stat {
+    rt_uint32_t op_calls;                   /* device ops called */
+    rt_uint32_t op_pixels;                  /* pixels written by device ops */
+    rt_uint32_t updates;                    /* RTGRAPHIC_CTRL_RECT_UPDATE */
+    rt_uint32_t update_pixels;              /* pixels updated to screen */
+    rt_uint32_t ext_calls;                  /* graphic extension ops called */
+    rt_uint32_t ext_pixels;                 /* pixels written by them */
+    rt_uint32_t update_ms;                  /* time of sending to screen */
+    rt_uint32_t flips;                      /* RTGUI_GRAPHIC_CTRL_FLIP */
+    rt_uint32_t copies;                     /* RTGUI_GRAPHIC_CTRL_COPY */
+};
+
+/* Exported constants --------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+/* register in-memory display, touch and key devices
+ * - framebuffer may be RT_NULL (allocated) or e.g. a mmap-ed file */
+rt_err_t rtgui_sim_init(rt_uint16_t width, rt_uint16_t height,
+    rt_uint8_t pixel_format, rt_uint8_t *framebuffer);
+void rtgui_sim_get_stat(struct rtgui_sim_stat *stat, rt_bool_t reset);
+/* the buffer on screen, changed by RTGUI_GRAPHIC_CTRL_FLIP */
+rt_uint8_t *rtgui_sim_get_scanout(void);
+/* simulate slow display, e.g. SPI panel, 0 (default) for no delay
+ * - RTGRAPHIC_CTRL_RECT_UPDATE blocks for pixels / pixels_per_ms, rounded
+ *   up to ms */
+void rtgui_sim_set_speed(rt_uint32_t pixels_per_ms);
+
+/* replay input script in a thread, the script is closed when done
+ * - one event per line: "<delay_ms> <down|move|up> <x> <y>" or
+ *   "<delay_ms> <keydown|keyup> <key> [mod]", "#" starts a comment */
+rt_err_t rtgui_sim_play(rtgui_filerw_t *script);
+/* wait for the playing script to end */
+rt_err_t rtgui_sim_wait(rt_int32_t timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RTGUI_SIMULATOR_H__ */
@@ -0,0 +1,56 @@
+/*
+ * File      : trig.h
+ * This file is part of RT-Thread GUI Engine
+ * COPYRIGHT (C) 2006 - 2017, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2019-07-12     onelife      first version
+ */
+#ifndef __RTGUI_TRIG_H__
+#define __RTGUI_TRIG_H__
+/* Includes ------------------------------------------------------------------*/
+#include "include/rtgui.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Exported constants --------------------------------------------------------*/
+/* Exported defines ----------------------------------------------------------*/
+#define RTGUI_TRIG_SHIFT                    (15)
+#define RTGUI_TRIG_ONE                      (1 << RTGUI_TRIG_SHIFT)
+/* angle unit is 1/16 degree */
+#define RTGUI_ANGLE_SHIFT                   (4)
+#define RTGUI_ANGLE(degree)                 ((degree) << RTGUI_ANGLE_SHIFT)
+
+/* Exported types ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+/* sin and cos of angle in Q15, by quarter wave table and interpolation */
+rt_int32_t rtgui_sin(rt_int32_t angle);
+rt_int32_t rtgui_cos(rt_int32_t angle);
+/* r * sin(angle) and r * cos(angle), rounded toward zero */
+rt_int32_t rtgui_sin_mul(rt_int32_t angle, rt_int32_t r);
+rt_int32_t rtgui_cos_mul(rt_int32_t angle, rt_int32_t r);
+/* floor of square root */
+rt_uint32_t rtgui_isqrt(rt_uint32_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RTGUI_TRIG_H__ */
@@ -176,8 +176,8 @@ struct rtgui_line {
 };
 
 #define IMPORT_TYPES
-#include "include/driver.h"
 #include "include/region.h"
+#include "include/driver.h"
 #include "include/font/font.h"
 #include "include/image.h"
 #undef IMPORT_TYPES
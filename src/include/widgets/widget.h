@@ -92,6 +92,9 @@ struct rtgui_widget {
     rtgui_gc_t gc;                          /* graphic context */
     rt_ubase_t dc_type;                     /* hardware device context */
     const rtgui_dc_engine_t *dc_engine;     // TODO(onelife): struct rtgui_dc
+#ifdef RTGUI_USING_DISPLAY_LIST
+    struct rtgui_dc_list *dlist;            /* recorded drawing */
+#endif
     rt_uint32_t user_data;
 };
 
@@ -86,6 +86,7 @@ typedef enum rtgui_win_flag {
     RTGUI_WIN_FLAG_CONNECTED                = 0x10,     /* with server */
     RTGUI_WIN_FLAG_HANDLE_KEY               = 0x20,     /* to RX KBD event */
     RTGUI_WIN_FLAG_CB_PRESSED               = 0x40,
+    RTGUI_WIN_FLAG_DIRECT                   = 0x80,     /* drawing w/o server */
 } rtgui_win_flag_t;
 
 typedef enum rtgui_modal_code {
@@ -104,7 +105,7 @@ struct rtgui_win {
     // rtgui_modal_code_t modal;
     rt_base_t update;                       /* update count */
     rt_base_t drawing;                      /* drawing count */
-    rtgui_rect_t drawing_rect;
+    rtgui_rect_t drawing_rect;              /* damage while drawing, device */
     rtgui_rect_t outer_extent;
     rtgui_region_t outer_clip;
     rtgui_title_t *_title;
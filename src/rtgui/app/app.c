@@ -128,7 +128,7 @@ rt_err_t rtgui_app_init(rtgui_app_t *app, const char *name, rt_bool_t is_srv) {
             ret = -RT_ENOMEM;
             break;
         }
-        self->user_data = (rt_uint32_t)app;
+        self->user_data = (rt_ubase_t)app;
 
         if (is_srv) {
             rtgui_event_pool = rt_mp_create(name, RTGUI_EVENT_POOL_NUMBER,
@@ -369,6 +369,11 @@ rt_inline void _rtgui_application_event_loop(rtgui_app_t *app) {
         }
         evt = RT_NULL;
         LOG_D("%s mb: %d", app->name, app->mb->entry);
+    #ifdef RTGUI_USING_DIRECT_DRAWING
+        /* end of frame, update damage of direct drawing */
+        if (!app->mb->entry)
+            rtgui_gfx_commit_screen(rtgui_get_gfx_device());
+    #endif
 
         if (app->on_idle) {
             ret = rtgui_wait(app, &evt, RT_WAITING_NO);
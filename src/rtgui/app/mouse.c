@@ -21,6 +21,7 @@
  * Date           Author       Notes
  * 2009-10-16     Bernard      first version
  * 2019-08-21     onelife      refactor
+ * 2019-08-24     onelife      compose cursor to scanout of double buffer
  */
 /* Includes ------------------------------------------------------------------*/
 #include "include/rtgui.h"
@@ -43,6 +44,9 @@
     static void _cursor_rect_restore(void);
     static void _cursor_rect_save(void);
     static void _cursor_draw(void);
+    #ifdef RTGUI_USING_DOUBLE_BUFFER
+        static void _cursor_compose(rtgui_rect_t *rect);
+    #endif
 #endif
 #ifdef RTGUI_USING_WINMOVE
     static void rtgui_winmove_restore(void);
@@ -66,6 +70,10 @@ struct rtgui_cursor {
         /* cursor image and saved cursor */
         rtgui_image_t *cursor_image;
         void *rect_copy;
+        #ifdef RTGUI_USING_DOUBLE_BUFFER
+            /* shown on scanout */
+            rt_bool_t composed;
+        #endif
     #endif /* RTGUI_USING_CURSOR */
 
     #ifdef RTGUI_USING_WINMOVE
@@ -84,6 +92,14 @@ typedef struct rtgui_cursor rtgui_cursor_t;
 #define display()                           (rtgui_get_gfx_device())
 #define display_pitch                       \
     (display()->width * _BIT2BYTE(display()->bits_per_pixel))
+#if defined(RTGUI_USING_CURSOR) && defined(RTGUI_USING_DOUBLE_BUFFER)
+    /* with back buffer, cursor is drawn only to scanout after flip or copy, so
+       there is nothing to save or restore */
+    #define CURSOR_COMPOSED()               \
+        (display()->scanout != display()->framebuffer)
+#else
+    #define CURSOR_COMPOSED()               (RT_FALSE)
+#endif
 
 /* Private variables ---------------------------------------------------------*/
 static rtgui_cursor_t *_cursor;
@@ -246,6 +262,65 @@ static void _cursor_draw(void) {
     rtgui_gfx_update_screen(display(), &rect);
 }
 
+#ifdef RTGUI_USING_DOUBLE_BUFFER
+/* overlay hook: draw the cursor part in rect (RT_NULL for all) to scanout */
+static void _cursor_compose(rtgui_rect_t *rect) {
+    rtgui_rect_t cur, area;
+    rtgui_color_t *pixel;
+    rt_uint8_t *ptr;
+    rt_uint16_t x, y;
+
+    if (!_cursor || !_cursor->composed || !_cursor->show_cursor) return;
+
+    rtgui_cursor_get_rect(&cur);
+    rtgui_rect_move(&cur, _cursor->cx, _cursor->cy);
+    /* to be removed from back buffer at flip */
+    rtgui_set_gfx_overlay_rect(cur);
+    rtgui_gfx_get_rect(display(), &area);
+    rtgui_rect_intersect(&cur, &area);
+    if (rect) rtgui_rect_intersect(rect, &area);
+    if ((area.x1 >= area.x2) || (area.y1 >= area.y2)) return;
+
+    for (y = area.y1; y < area.y2; y++) {
+        pixel = (rtgui_color_t *)_cursor->cursor_image->data + \
+            (y - cur.y1) * _cursor->cursor_image->w + (area.x1 - cur.x1);
+        ptr = display()->scanout + y * display_pitch + \
+            area.x1 * _cursor->byte_pp;
+        for (x = area.x1; x < area.x2; x++, pixel++, ptr += _cursor->byte_pp) {
+            rtgui_color_t raw;
+
+            if (0xff == RTGUI_RGB_A(*pixel)) continue;
+            raw = rtgui_gfx_raw_color(*pixel);
+            switch (_cursor->byte_pp) {
+            case 1:
+                *ptr = (rt_uint8_t)raw;
+                break;
+            case 2:
+                *(rt_uint16_t *)ptr = (rt_uint16_t)raw;
+                break;
+            case 3:
+                ptr[0] = raw & 0xff;
+                ptr[1] = (raw >> 8) & 0xff;
+                ptr[2] = (raw >> 16) & 0xff;
+                break;
+            default:
+                *(rt_uint32_t *)ptr = raw;
+                break;
+            }
+        }
+    }
+}
+
+/* update cursor rect at (x, y), copied from back buffer then composed */
+static void _cursor_update(rt_uint16_t x, rt_uint16_t y) {
+    rtgui_rect_t rect;
+
+    rtgui_cursor_get_rect(&rect);
+    rtgui_rect_move(&rect, x, y);
+    rtgui_gfx_update_screen(display(), &rect);
+}
+#endif /* RTGUI_USING_DOUBLE_BUFFER */
+
 #endif /* RTGUI_USING_CURSOR */
 
 #ifdef RTGUI_USING_WINMOVE
@@ -451,6 +526,12 @@ rt_err_t rtgui_cursor_init(void) {
             _cursor->rect.y2 = _cursor->cursor_image->h;
             _cursor->show_cursor = RT_TRUE;
             _cursor->cursor_count = 0;
+            #ifdef RTGUI_USING_DOUBLE_BUFFER
+                if (CURSOR_COMPOSED()) {
+                    rtgui_set_gfx_overlay_hook(_cursor_compose);
+                    break;
+                }
+            #endif
             _cursor->rect_copy = rtgui_malloc(_cursor->cursor_image->h * \
                 _cursor->cursor_image->w * _cursor->byte_pp);
             if (!_cursor->rect_copy) {
@@ -490,6 +571,9 @@ void rtgui_cursor_uninit(void) {
     if (!_cursor) return;
 
     #ifdef RTGUI_USING_CURSOR
+        #ifdef RTGUI_USING_DOUBLE_BUFFER
+            rtgui_set_gfx_overlay_hook(RT_NULL);
+        #endif
         rt_mutex_detach(&cursor_lock);
         if (_cursor->cursor_image)  rtgui_image_destroy(_cursor->cursor_image);
         if (_cursor->rect_copy)     rtgui_free(_cursor->rect_copy);
@@ -512,6 +596,10 @@ void rtgui_cursor_move(rt_uint16_t x, rt_uint16_t y) {
     #endif
 
     if ((x != _cursor->cx) || (y != _cursor->cy)) {
+        #if defined(RTGUI_USING_CURSOR) && defined(RTGUI_USING_DOUBLE_BUFFER)
+            rt_uint16_t old_x = _cursor->cx, old_y = _cursor->cy;
+        #endif
+
         #ifdef RTGUI_USING_WINMOVE
             if (_cursor->win_moving) {
                 if (_cursor->has_win_copy)
@@ -546,6 +634,14 @@ void rtgui_cursor_move(rt_uint16_t x, rt_uint16_t y) {
             #endif
         }
 
+        #if defined(RTGUI_USING_CURSOR) && defined(RTGUI_USING_DOUBLE_BUFFER)
+            /* erase at old position and compose at new one */
+            if (CURSOR_COMPOSED() && _cursor->composed) {
+                _cursor_update(old_x, old_y);
+                _cursor_update(_cursor->cx, _cursor->cy);
+            }
+        #endif
+
         #ifdef RTGUI_USING_HW_CURSOR
             rtgui_cursor_set_position(_cursor->cx, _cursor->cy);
         #endif
@@ -650,6 +746,16 @@ rt_bool_t rtgui_monitor_contain_point(rt_slist_t *list, int x, int y) {
         LOG_D("->cursor cnt %d", _cursor->cursor_count);
 
         if (1 == _cursor->cursor_count) {
+            #ifdef RTGUI_USING_DOUBLE_BUFFER
+                if (CURSOR_COMPOSED()) {
+                    /* first show */
+                    if (!_cursor->composed) {
+                        _cursor->composed = RT_TRUE;
+                        _cursor_update(_cursor->cx, _cursor->cy);
+                    }
+                    return;
+                }
+            #endif
             _cursor_rect_save();
             _cursor_draw();
         }
@@ -658,15 +764,19 @@ rt_bool_t rtgui_monitor_contain_point(rt_slist_t *list, int x, int y) {
     void rtgui_cursor_hide(void) {
         if (!_cursor->show_cursor) return;
 
-        if (1 == _cursor->cursor_count)
+        if ((1 == _cursor->cursor_count) && !CURSOR_COMPOSED())
             _cursor_rect_restore();
 
         _cursor->cursor_count--;
         LOG_D("<-cursor cnt %d", _cursor->cursor_count);
     }
 
+    /* rect is in device coordinate */
     rt_bool_t rtgui_mouse_is_intersect(rtgui_rect_t *rect) {
-        return rtgui_rect_is_intersect(&(_cursor->rect), rect);
+        rtgui_rect_t cur = _cursor->rect;
+
+        rtgui_rect_move(&cur, _cursor->cx, _cursor->cy);
+        return IS_R_INTERSECT(&cur, rect);
     }
 #endif /* RTGUI_USING_CURSOR */
 
@@ -284,8 +284,8 @@ static rt_bool_t _server_event_handler(void *obj, rtgui_evt_generic_t *evt) {
             /* handle screen update */
             rtgui_gfx_driver_t *drv = rtgui_get_gfx_device();
             if (drv) {
-                rtgui_gfx_update_screen(drv,
-                    &(evt->update_end.rect));
+                /* updated when no more pending event */
+                rtgui_gfx_damage_screen(drv, &(evt->update_end.rect));
             }
             #ifdef RTGUI_USING_CURSOR
                 rtgui_cursor_show();
@@ -322,6 +322,9 @@ static rt_bool_t _server_event_handler(void *obj, rtgui_evt_generic_t *evt) {
         rtgui_response(evt, ack);
         RTGUI_FREE_EVENT(evt);
     }
+    /* end of frame, update all damaged rects */
+    if (!_srv_app->mb->entry)
+        rtgui_gfx_commit_screen(rtgui_get_gfx_device());
     return done;    // who care server handler return value?
 }
 
@@ -225,7 +225,8 @@ static void _topwin_activate(rtgui_topwin_t *top) {
     if (IS_TOPWIN_FLAG(top, NO_FOCUS)) return;
 
     #ifdef RTGUI_USING_CURSOR
-        if (top->wid->drawing > 0) rtgui_cursor_hide();
+        if ((top->wid->drawing > 0) && !IS_WIN_FLAG(top->wid, DIRECT))
+            rtgui_cursor_hide();
     #endif
 
     /* send RTGUI_EVENT_WIN_ACTIVATE */
@@ -255,7 +256,8 @@ static void _topwin_deactivate(rtgui_topwin_t *top) {
     rtgui_evt_generic_t *evt;
 
     #ifdef RTGUI_USING_CURSOR
-        if (top->wid->drawing > 0) rtgui_cursor_show();
+        if ((top->wid->drawing > 0) && !IS_WIN_FLAG(top->wid, DIRECT))
+            rtgui_cursor_show();
     #endif
 
     /* send RTGUI_EVENT_WIN_DEACTIVATE */
@@ -462,6 +464,7 @@ static void _topwin_update_clip(void) {
         return;
     }
 
+    (void)rtgui_region_arena_begin();
     rtgui_region_init(
         &region, 0, 0,
         rtgui_get_gfx_device()->width,
@@ -489,6 +492,7 @@ static void _topwin_update_clip(void) {
 
         /* clip the topwin */
         _rtgui_topwin_clip_to_region(top, &region);
+        rtgui_region_arena_keep(&top->wid->outer_clip);
         /* update available region */
         rtgui_region_subtract_rect(&region, &region, &top->extent);
 
@@ -501,6 +505,7 @@ static void _topwin_update_clip(void) {
     }
 
     rtgui_region_uninit(&region);
+    rtgui_region_arena_end();
 }
 
 static void _topwin_redraw(rt_list_t *list, rtgui_rect_t *rect) {
@@ -51,7 +51,7 @@
 /* Private variables ---------------------------------------------------------*/
 static struct rt_mutex _screen_lock;
 static struct rt_mailbox ack_sync;
-static rt_uint8_t ack_pool[SYNC_ACK_NUMBER];
+static rt_ubase_t ack_pool[SYNC_ACK_NUMBER];
 static rtgui_event_timer_t _timer_evt = {
     .base = {
         .type = RTGUI_EVENT_TIMER,
@@ -613,8 +613,8 @@ void rtgui_get_screen_rect(rtgui_rect_t *rect) {
 }
 RTM_EXPORT(rtgui_get_screen_rect);
 
-void rtgui_screen_lock(rt_int32_t timeout) {
-    rt_mutex_take(&_screen_lock, timeout);
+rt_err_t rtgui_screen_lock(rt_int32_t timeout) {
+    return rt_mutex_take(&_screen_lock, timeout);
 }
 RTM_EXPORT(rtgui_screen_lock);
 
@@ -356,6 +356,107 @@ static void blit_line_mono_to_rgb565(rt_uint8_t *_dst, rt_uint8_t *src,
             }
 }
 
+/*
+ * Alpha blending lines composite over the pixels already in dst, so dst is
+ * read back (or filled with background) by caller. Pixels are blended by
+ * spreading RGB565 as "-G-R-B" in 32 bits, that all three channels are
+ * scaled by one multiply.
+ */
+#define RGB565_SPREAD(c)            \
+    ((((rt_uint32_t)(c) << 16) | (c)) & 0x07E0F81FUL)
+#define RGB565_PACK(c)              ((rt_uint16_t)((c) | ((c) >> 16)))
+#ifdef RTGUI_BIG_ENDIAN_OUTPUT
+# define RGB565_ORDER(c)            ((rt_uint16_t)(((c) << 8) | ((c) >> 8)))
+#else
+# define RGB565_ORDER(c)            ((rt_uint16_t)(c))
+#endif
+
+/* blend fg (spread, native order) over bg (output order) with alpha (0 - 32),
+   returns output order */
+rt_inline rt_uint16_t _blend_rgb565(rt_uint32_t fg, rt_uint16_t bg,
+    rt_uint32_t alpha) {
+    rt_uint32_t c = RGB565_SPREAD(RGB565_ORDER(bg));
+
+    c += ((fg - c) * alpha) >> 5;
+    c &= 0x07E0F81FUL;
+    return RGB565_ORDER(RGB565_PACK(c));
+}
+
+/* ARGB888 (R, G, B, A bytes) -> RGB565 alpha blending */
+static void blit_line_argb888_to_rgb565(rt_uint8_t *_dst, rt_uint8_t *src,
+    rt_uint32_t len, rt_uint8_t scale, rtgui_image_palette_t *palette) {
+    rt_uint16_t *dst = (rt_uint16_t *)_dst;
+    rt_uint8_t *end = src + len;
+    rt_uint8_t step = 4 << scale;
+    rt_uint32_t fg;
+    (void)palette;
+
+    while (src < end) {
+        /* transparent run */
+        while ((src < end) && (0x00 == src[3])) {
+            src += step;
+            dst++;
+        }
+        /* opaque run */
+        while ((src < end) && (0xff == src[3])) {
+            RGB565_FROM_RGB(*dst, src[0], src[1], src[2]);
+            src += step;
+            dst++;
+        }
+        /* translucent run */
+        while ((src < end) && (0x00 != src[3]) && (0xff != src[3])) {
+            fg = ((src[0] >> 3) << 11) | ((src[1] >> 2) << 5) | (src[2] >> 3);
+            *dst = _blend_rgb565(RGB565_SPREAD(fg), *dst, (src[3] + 4) >> 3);
+            src += step;
+            dst++;
+        }
+    }
+}
+
+/* ARGB565 (RGB565 in output order, A bytes) -> RGB565 alpha blending */
+static void blit_line_argb565_to_rgb565(rt_uint8_t *_dst, rt_uint8_t *src,
+    rt_uint32_t len, rt_uint8_t scale, rtgui_image_palette_t *palette) {
+    rt_uint16_t *dst = (rt_uint16_t *)_dst;
+    rt_uint8_t *end = src + len;
+    rt_uint8_t step = 3 << scale;
+    rt_uint16_t fg;
+    (void)palette;
+
+    while (src < end) {
+        while ((src < end) && (0x00 == src[2])) {
+            src += step;
+            dst++;
+        }
+        while ((src < end) && (0xff == src[2])) {
+            rt_memcpy(dst, src, 2);
+            src += step;
+            dst++;
+        }
+        while ((src < end) && (0x00 != src[2]) && (0xff != src[2])) {
+            rt_memcpy(&fg, src, 2);
+            *dst = _blend_rgb565(RGB565_SPREAD(RGB565_ORDER(fg)), *dst,
+                (src[2] + 4) >> 3);
+            src += step;
+            dst++;
+        }
+    }
+}
+
+/* ARGB888 (R, G, B, A bytes) -> ARGB565 converting, may be in place */
+static void blit_line_argb888_to_argb565(rt_uint8_t *dst, rt_uint8_t *src,
+    rt_uint32_t len, rt_uint8_t scale, rtgui_image_palette_t *palette) {
+    rt_uint8_t *end = src + len;
+    rt_uint8_t step = 4 << scale;
+    rt_uint16_t pixel;
+    (void)palette;
+
+    for ( ; src < end; src += step, dst += 3) {
+        RGB565_FROM_RGB(pixel, src[0], src[1], src[2]);
+        rt_memcpy(dst, &pixel, 2);
+        dst[2] = src[3];
+    }
+}
+
 #endif /* CONFIG_USING_RGB565 */
 
 rtgui_blit_line_func rtgui_get_blit_line_func(rt_uint8_t src_fmt,
@@ -412,9 +513,20 @@ rtgui_blit_line_func rtgui_get_blit_line_func(rt_uint8_t src_fmt,
         case RTGRAPHIC_PIXEL_FORMAT_MONO:
             return blit_line_mono_to_rgb565;
 
+        case RTGRAPHIC_PIXEL_FORMAT_ARGB888:
+            return blit_line_argb888_to_rgb565;
+
+        case RTGRAPHIC_PIXEL_FORMAT_ARGB565:
+            return blit_line_argb565_to_rgb565;
+
         default:
             return RT_NULL;
         }
+
+    case RTGRAPHIC_PIXEL_FORMAT_ARGB565:
+        if (RTGRAPHIC_PIXEL_FORMAT_ARGB888 == src_fmt)
+            return blit_line_argb888_to_argb565;
+        return RT_NULL;
     #endif /* CONFIG_USING_RGB565 */
 
     default:
@@ -25,11 +25,10 @@
  * 2011-04-25     Bernard      fix fill polygon issue, which found by loveic
  */
 
-#include <stdlib.h> /* fir qsort  */
-#include <math.h>   /* for sin/cos etc */
-
 #include "include/rtgui.h"
 #include "include/font/font.h"
+#include "include/trig.h"
+#include "include/app/app.h"
 
 #ifdef RT_USING_ULOG
 # define LOG_LVL                    RTGUI_LOG_LEVEL
@@ -40,8 +39,57 @@
 # define LOG_D                      LOG_E
 #endif /* RT_USING_ULOG */
 
-static int _int_compare(const void *a, const void *b) {
-    return (*(const int *) a) - (*(const int *) b);
+/* get the graphic extension ops when the area (logic coordinate, inclusive)
+   needs no clipping, also returns the logic to device offset */
+static const struct rtgui_graphic_ext_ops *_dc_get_ext_ops(rtgui_dc_t *dc,
+    const rtgui_rect_t *area, struct rtgui_point *offset) {
+    const struct rtgui_graphic_ext_ops *ext_ops;
+    rtgui_widget_t *owner;
+    rtgui_rect_t *clip;
+
+    ext_ops = rtgui_get_gfx_device()->ext_ops;
+    if (!ext_ops) return RT_NULL;
+
+    switch (dc->type) {
+    case RTGUI_DC_HW:
+        owner = ((struct rtgui_dc_hw *)dc)->owner;
+        clip = &(owner->extent);
+        break;
+
+    case RTGUI_DC_CLIENT:
+        owner = rt_container_of(dc, rtgui_widget_t, dc_type);
+        if (!rtgui_dc_get_visible(dc) || !rtgui_region_is_flat(&(owner->clip)))
+            return RT_NULL;
+        clip = &(owner->clip.extents);
+        break;
+
+    default:
+        return RT_NULL;
+    }
+
+    offset->x = owner->extent.x1;
+    offset->y = owner->extent.y1;
+    if (((area->x1 + offset->x) < clip->x1) || \
+        ((area->y1 + offset->y) < clip->y1) || \
+        ((area->x2 + offset->x) >= clip->x2) || \
+        ((area->y2 + offset->y) >= clip->y2))
+        return RT_NULL;
+
+    return ext_ops;
+}
+
+/* damage the area (logic coordinate, inclusive) once an extension op of
+   _dc_get_ext_ops() is actually going to draw it */
+static void _dc_ext_damage(rtgui_dc_t *dc, const rtgui_rect_t *area,
+    const struct rtgui_point *offset) {
+    rtgui_widget_t *owner;
+
+    if (dc->type == RTGUI_DC_HW)
+        owner = ((struct rtgui_dc_hw *)dc)->owner;
+    else
+        owner = rt_container_of(dc, rtgui_widget_t, dc_type);
+    rtgui_dc_damage(owner, area->x1 + offset->x, area->y1 + offset->y,
+        area->x2 + offset->x + 1, area->y2 + offset->y + 1);
 }
 
 void rtgui_dc_destory(rtgui_dc_t *dc)
@@ -53,6 +101,131 @@ void rtgui_dc_destory(rtgui_dc_t *dc)
 }
 RTM_EXPORT(rtgui_dc_destory);
 
+/* a slanted line walked along its major axis (p) by Bresenham, the pixel of
+   step i (1 <= i <= dp) is at p0 + sp * i, q0 + sq * (h + i * dq) / dp */
+struct rtgui_dc_line {
+    int p0, q0;                             /* start point, not drawn */
+    int sp, sq;                             /* step direction */
+    int dp, dq;                             /* length, dp >= dq > 0 */
+    int h;                                  /* initial error, dp / 2 */
+    rt_bool_t steep;                        /* major axis is y */
+};
+
+#define LINE_LEFT                   (0x01)
+#define LINE_RIGHT                  (0x02)
+#define LINE_TOP                    (0x04)
+#define LINE_BOTTOM                 (0x08)
+
+static rt_uint8_t _dc_line_outcode(const rtgui_rect_t *rect, int x, int y) {
+    rt_uint8_t code = 0;
+
+    if (x < rect->x1)
+        code |= LINE_LEFT;
+    else if (x >= rect->x2)
+        code |= LINE_RIGHT;
+    if (y < rect->y1)
+        code |= LINE_TOP;
+    else if (y >= rect->y2)
+        code |= LINE_BOTTOM;
+    return code;
+}
+
+/* draw the runs of steps [i1, i2], one hline (vline if steep) per run
+   - pixel is RT_NULL: by dc engine in logic coordinate
+   - otherwise: by native ops in device coordinate */
+static void _dc_line_runs(rtgui_dc_t *dc, const struct rtgui_dc_line *line,
+    int i1, int i2, rtgui_color_t *pixel) {
+    int k, next, p1, p2, q;
+
+    k = (line->h + i1 * line->dq) / line->dp;
+    while (i1 <= i2) {
+        /* the first step with minor offset (k + 1) */
+        next = ((k + 1) * line->dp - line->h + line->dq - 1) / line->dq;
+        if (next > (i2 + 1)) next = i2 + 1;
+
+        p1 = line->p0 + line->sp * i1;
+        p2 = line->p0 + line->sp * (next - 1);
+        if (p1 > p2) {
+            int tmp = p1;
+            p1 = p2;
+            p2 = tmp;
+        }
+        q = line->q0 + line->sq * k;
+
+        if (!pixel) {
+            if (line->steep)
+                rtgui_dc_draw_vline(dc, q, p1, p2 + 1);
+            else
+                rtgui_dc_draw_hline(dc, p1, p2 + 1, q);
+        } else {
+            if (line->steep)
+                rtgui_get_gfx_device()->native_ops->draw_vline(pixel, q, p1,
+                    p2 + 1);
+            else
+                rtgui_get_gfx_device()->native_ops->draw_hline(pixel, p1,
+                    p2 + 1, q);
+        }
+
+        i1 = next;
+        k++;
+    }
+}
+
+/* clip the line by rect (device coordinate) and draw the visible steps */
+static void _dc_line_clip(const struct rtgui_dc_line *line,
+    const rtgui_rect_t *rect, rtgui_color_t *pixel) {
+    int i1, i2, p_lo, p_hi, k_lo, k_hi;
+    rt_uint8_t code1, code2;
+
+    if (line->steep) {
+        code1 = _dc_line_outcode(rect, line->q0, line->p0);
+        code2 = _dc_line_outcode(rect, line->q0 + line->sq * line->dq,
+            line->p0 + line->sp * line->dp);
+    } else {
+        code1 = _dc_line_outcode(rect, line->p0, line->q0);
+        code2 = _dc_line_outcode(rect, line->p0 + line->sp * line->dp,
+            line->q0 + line->sq * line->dq);
+    }
+    /* trivial reject and accept */
+    if (code1 & code2) return;
+    if (!(code1 | code2)) {
+        _dc_line_runs(RT_NULL, line, 1, line->dp, pixel);
+        return;
+    }
+
+    /* the steps inside rect along the major axis */
+    p_lo = line->steep ? rect->y1 : rect->x1;
+    p_hi = (line->steep ? rect->y2 : rect->x2) - 1;
+    if (line->sp > 0) {
+        i1 = p_lo - line->p0;
+        i2 = p_hi - line->p0;
+    } else {
+        i1 = line->p0 - p_hi;
+        i2 = line->p0 - p_lo;
+    }
+
+    /* and along the minor axis, by the range of minor offset */
+    p_lo = line->steep ? rect->x1 : rect->y1;
+    p_hi = (line->steep ? rect->x2 : rect->y2) - 1;
+    if (line->sq > 0) {
+        k_lo = p_lo - line->q0;
+        k_hi = p_hi - line->q0;
+    } else {
+        k_lo = line->q0 - p_hi;
+        k_hi = line->q0 - p_lo;
+    }
+    if (k_hi < 0) return;
+    if (k_lo > 0)
+        i1 = _MAX(i1,
+            (k_lo * line->dp - line->h + line->dq - 1) / line->dq);
+    i2 = _MIN(i2, ((k_hi + 1) * line->dp - line->h - 1) / line->dq);
+
+    i1 = _MAX(i1, 1);
+    i2 = _MIN(i2, line->dp);
+    if (i1 <= i2)
+        _dc_line_runs(RT_NULL, line, i1, i2, pixel);
+}
+
 void rtgui_dc_draw_line(rtgui_dc_t *dc, int x1, int y1, int x2, int y2)
 {
     if (dc == RT_NULL) return;
@@ -67,55 +240,70 @@ void rtgui_dc_draw_line(rtgui_dc_t *dc, int x1, int y1, int x2, int y2)
     }
     else
     {
-        int dx, dy, sdx, sdy, dxabs, dyabs, x, y, px, py;
-        register rt_base_t i;
-        /* rtgui_rect_t rect; */
-
-        dx = x2 - x1;       /* the horizontal distance of the line */
-        dy = y2 - y1;       /* the vertical distance of the line */
-
-#define rtgui_sgn(x) ((x<0)?-1:((x>0)?1:0)) /* macro to return the sign of a number */
+        const struct rtgui_graphic_ext_ops *ext_ops;
+        struct rtgui_dc_line line;
+        struct rtgui_point offset;
+        rtgui_rect_t area;
+
+        area.x1 = _MIN(x1, x2);
+        area.y1 = _MIN(y1, y2);
+        area.x2 = _MAX(x1, x2);
+        area.y2 = _MAX(y1, y2);
+        ext_ops = _dc_get_ext_ops(dc, &area, &offset);
+        if (ext_ops && ext_ops->draw_line) {
+            _dc_ext_damage(dc, &area, &offset);
+            ext_ops->draw_line(&RTGUI_DC_FC(dc), x1 + offset.x, y1 + offset.y,
+                x2 + offset.x, y2 + offset.y);
+            return;
+        }
 
-        dxabs = _ABS(dx);
-        dyabs = _ABS(dy);
-        sdx = rtgui_sgn(dx);
-        sdy = rtgui_sgn(dy);
-        x = dyabs >> 1;
-        y = dxabs >> 1;
-        px = x1;
-        py = y1;
+        line.steep = _ABS(y2 - y1) > _ABS(x2 - x1);
+        if (line.steep) {
+            line.p0 = y1;
+            line.q0 = x1;
+            line.sp = (y2 > y1) ? 1 : -1;
+            line.sq = (x2 > x1) ? 1 : -1;
+            line.dp = _ABS(y2 - y1);
+            line.dq = _ABS(x2 - x1);
+        } else {
+            line.p0 = x1;
+            line.q0 = y1;
+            line.sp = (x2 > x1) ? 1 : -1;
+            line.sq = (y2 > y1) ? 1 : -1;
+            line.dp = _ABS(x2 - x1);
+            line.dq = _ABS(y2 - y1);
+        }
+        line.h = line.dp >> 1;
 
-        if (dxabs >= dyabs) /* the line is more horizontal than vertical */
-        {
-            for (i = 0; i < dxabs; i++)
-            {
-                y += dyabs;
-                if (y >= dxabs)
-                {
-                    y -= dxabs;
-                    py += sdy;
-                }
-                px += sdx;
+        if (RTGUI_DC_CLIENT == dc->type) {
+            rtgui_widget_t *owner;
+            rtgui_rect_t *rect, *end;
+            rtgui_color_t pixel;
 
-                /* draw this point */
-                rtgui_dc_draw_point(dc, px, py);
+            /* clip once per clip rect and draw runs by native ops */
+            if (!rtgui_dc_get_visible(dc)) return;
+            owner = rt_container_of(dc, rtgui_widget_t, dc_type);
+            if (line.steep) {
+                line.p0 += owner->extent.y1;
+                line.q0 += owner->extent.x1;
+            } else {
+                line.p0 += owner->extent.x1;
+                line.q0 += owner->extent.y1;
             }
-        }
-        else                /* the line is more vertical than horizontal */
-        {
-            for (i = 0; i < dyabs; i++)
-            {
-                x += dxabs;
-                if (x >= dyabs)
-                {
-                    x -= dyabs;
-                    px += sdx;
-                }
-                py += sdy;
-
-                /* draw this point */
-                rtgui_dc_draw_point(dc, px, py);
+            rtgui_rect_move(&area, owner->extent.x1, owner->extent.y1);
+            pixel = rtgui_gfx_native_color(owner->gc.foreground);
+            rtgui_dc_damage(owner, area.x1, area.y1, area.x2 + 1,
+                area.y2 + 1);
+
+            rect = rtgui_region_rects(&(owner->clip));
+            end = rect + rtgui_region_num_rects(&(owner->clip));
+            for (; (rect < end) && (rect->y1 <= area.y2); rect++) {
+                if (rect->y2 <= area.y1) continue;
+                _dc_line_clip(&line, rect, &pixel);
             }
+        } else {
+            /* the engine clips each run */
+            _dc_line_runs(dc, &line, 1, line.dp, RT_NULL);
         }
     }
 }
@@ -166,6 +354,17 @@ void rtgui_dc_draw_vertical_line(rtgui_dc_t *dc, int x, int y1, int y2)
 RTM_EXPORT(rtgui_dc_draw_vertical_line);
 
 void rtgui_dc_draw_rect(rtgui_dc_t *dc, rtgui_rect_t *rect) {
+    const struct rtgui_graphic_ext_ops *ext_ops;
+    struct rtgui_point offset;
+
+    ext_ops = _dc_get_ext_ops(dc, rect, &offset);
+    if (ext_ops && ext_ops->draw_rect) {
+        _dc_ext_damage(dc, rect, &offset);
+        ext_ops->draw_rect(&RTGUI_DC_FC(dc), rect->x1 + offset.x,
+            rect->y1 + offset.y, rect->x2 + offset.x, rect->y2 + offset.y);
+        return;
+    }
+
     rtgui_dc_draw_hline(dc, rect->x1, rect->x2, rect->y1);
     rtgui_dc_draw_hline(dc, rect->x1, rect->x2, rect->y2);
 
@@ -187,67 +386,190 @@ void rtgui_dc_fill_rect_forecolor(rtgui_dc_t *dc, rtgui_rect_t *rect)
 }
 RTM_EXPORT(rtgui_dc_fill_rect_forecolor);
 
-void rtgui_dc_draw_round_rect(rtgui_dc_t *dc, rtgui_rect_t *rect, int r)
-{
-    RT_ASSERT(((rect->x2 - rect->x1) / 2 >= r) && ((rect->y2 - rect->y1) / 2 >= r));
+/*
+ * An oval is an ellipse of radii (rx, ry) split into quadrants at center,
+ * which are (gx, gy) apart for rounded rect. Point (x, dy) of a quadrant is
+ * inside if x^2 / (rx + 1/2)^2 + dy^2 / (ry + 1/2)^2 <= 1, so each row has
+ * a half width walked by integers and is emitted as spans exactly once.
+ */
+struct rtgui_dc_oval {
+    rtgui_dc_t *dc;
+    rtgui_rect_t clip;                      /* for early-out, inclusive */
+    int x, y;                               /* top left center */
+    int gx, gy;                             /* to bottom right center */
+    int rx, ry;
+    int vx, vy1, vy2;                       /* pending vertical run */
+};
 
-    if (r < 0)
-    {
+static void _dc_oval_hline(struct rtgui_dc_oval *oval, int x1, int x2,
+    int y) {
+    if ((y < oval->clip.y1) || (y > oval->clip.y2) || \
+        (x2 <= oval->clip.x1) || (x1 > oval->clip.x2))
+        return;
+    rtgui_dc_draw_hline(oval->dc, x1, x2, y);
+}
+
+static void _dc_oval_vline(struct rtgui_dc_oval *oval, int x, int y1,
+    int y2) {
+    if ((x < oval->clip.x1) || (x > oval->clip.x2) || \
+        (y2 <= oval->clip.y1) || (y1 > oval->clip.y2))
         return;
+    rtgui_dc_draw_vline(oval->dc, x, y1, y2);
+}
+
+/* draw the pending vertical run of outline, both sides */
+static void _dc_oval_flush(struct rtgui_dc_oval *oval) {
+    int x1, x2, y1, y2, y3, y4;
+
+    if (oval->vx < 0) return;
+    x1 = oval->x - oval->vx;
+    x2 = oval->x + oval->gx + oval->vx;
+    y1 = oval->y - oval->vy2;
+    y2 = oval->y - oval->vy1 + 1;
+    y3 = oval->y + oval->gy + oval->vy1;
+    y4 = oval->y + oval->gy + oval->vy2 + 1;
+    if (!oval->vy1) {
+        /* top and bottom are joined by the side */
+        _dc_oval_vline(oval, x1, y1, y4);
+        if (x2 != x1) _dc_oval_vline(oval, x2, y1, y4);
+    } else {
+        _dc_oval_vline(oval, x1, y1, y2);
+        _dc_oval_vline(oval, x1, y3, y4);
+        if (x2 != x1) {
+            _dc_oval_vline(oval, x2, y1, y2);
+            _dc_oval_vline(oval, x2, y3, y4);
+        }
     }
+    oval->vx = -1;
+}
 
-    if (r == 0)
-    {
-        rtgui_dc_draw_rect(dc, rect);
+/* outline of row dy is from x1 to x2 (inclusive) */
+static void _dc_oval_outline(struct rtgui_dc_oval *oval, int dy, int x1,
+    int x2) {
+    int y1 = oval->y - dy;
+    int y2 = oval->y + oval->gy + dy;
+
+    /* one pixel rows under each other make a vertical run */
+    if ((x1 == x2) && x1) {
+        if ((oval->vx == x1) && (oval->vy1 == (dy + 1))) {
+            oval->vy1 = dy;
+            return;
+        }
+        _dc_oval_flush(oval);
+        oval->vx = x1;
+        oval->vy1 = oval->vy2 = dy;
         return;
     }
+    _dc_oval_flush(oval);
+
+    if (!x1) {
+        _dc_oval_hline(oval, oval->x - x2, oval->x + oval->gx + x2 + 1, y1);
+        if (y2 != y1)
+            _dc_oval_hline(oval, oval->x - x2, oval->x + oval->gx + x2 + 1,
+                y2);
+    } else {
+        _dc_oval_hline(oval, oval->x - x2, oval->x - x1 + 1, y1);
+        _dc_oval_hline(oval, oval->x + oval->gx + x1,
+            oval->x + oval->gx + x2 + 1, y1);
+        if (y2 != y1) {
+            _dc_oval_hline(oval, oval->x - x2, oval->x - x1 + 1, y2);
+            _dc_oval_hline(oval, oval->x + oval->gx + x1,
+                oval->x + oval->gx + x2 + 1, y2);
+        }
+    }
+    if (!dy && (oval->gy > 1)) {
+        /* the sides */
+        _dc_oval_vline(oval, oval->x - x2, oval->y + 1, oval->y + oval->gy);
+        _dc_oval_vline(oval, oval->x + oval->gx + x2, oval->y + 1,
+            oval->y + oval->gy);
+    }
+}
 
-    if (((rect->x2 - rect->x1) / 2 >= r) && ((rect->y2 - rect->y1) / 2 >= r))
-    {
-        rtgui_dc_draw_arc(dc, rect->x1 + r, rect->y1 + r, r, 180, 270);
-        rtgui_dc_draw_arc(dc, rect->x2 - r, rect->y1 + r, r, 270, 360);
-        rtgui_dc_draw_arc(dc, rect->x1 + r, rect->y2 - r, r, 90,  180);
-        rtgui_dc_draw_arc(dc, rect->x2 - r, rect->y2 - r, r, 0,   90);
+static void _dc_draw_oval(rtgui_dc_t *dc, int x, int y, int gx, int gy,
+    int rx, int ry, rt_bool_t fill) {
+    struct rtgui_dc_oval oval;
+    rt_int64_t a, b, lim, t;
+    int dy, hw, last;
+
+    oval.dc = dc;
+    oval.x = x;
+    oval.y = y;
+    oval.gx = gx;
+    oval.gy = gy;
+    oval.rx = rx;
+    oval.ry = ry;
+    oval.vx = -1;
+    rtgui_dc_get_rect(dc, &oval.clip);
+    if (((x + gx + rx) < oval.clip.x1) || ((x - rx) > oval.clip.x2) || \
+        ((y + gy + ry) < oval.clip.y1) || ((y - ry) > oval.clip.y2))
+        return;
+
+    if (fill && (gy > 1)) {
+        rtgui_rect_t rect;
+
+        rect.x1 = x - rx;
+        rect.y1 = y + 1;
+        rect.x2 = x + gx + rx + 1;
+        rect.y2 = y + gy;
+        rtgui_dc_fill_rect_forecolor(dc, &rect);
+    }
+
+    /* from top row with x = 0, the half width never shrinks */
+    a = (rt_int64_t)(2 * ry + 1) * (2 * ry + 1);
+    b = (rt_int64_t)(2 * rx + 1) * (2 * rx + 1);
+    lim = a * b;
+    t = 4 * (rt_int64_t)ry * ry * b;
+    hw = 0;
+    last = -1;
+    for (dy = ry; dy >= 0; dy--) {
+        while ((t + 4 * a * (2 * hw + 1)) <= lim) {
+            t += 4 * a * (2 * hw + 1);
+            hw++;
+        }
+        if (fill) {
+            _dc_oval_hline(&oval, x - hw, x + gx + hw + 1, y - dy);
+            if (dy || gy)
+                _dc_oval_hline(&oval, x - hw, x + gx + hw + 1, y + gy + dy);
+        } else {
+            _dc_oval_outline(&oval, dy, (hw > last) ? (last + 1) : hw, hw);
+        }
+        last = hw;
+        t -= 4 * b * (2 * dy - 1);
+    }
+    if (!fill) _dc_oval_flush(&oval);
+}
+
+/* draw rounded rect (inclusive) of corner radius r */
+void rtgui_dc_draw_round_rect(rtgui_dc_t *dc, rtgui_rect_t *rect, int r) {
+    RT_ASSERT(((rect->x2 - rect->x1) / 2 >= r) && \
+              ((rect->y2 - rect->y1) / 2 >= r));
 
-        rtgui_dc_draw_hline(dc, rect->x1 + r, rect->x2 - r, rect->y1);
-        rtgui_dc_draw_hline(dc, rect->x1 + r, rect->x2 - r, rect->y2);
-        rtgui_dc_draw_vline(dc, rect->x1, rect->y1 + r, rect->y2 - r);
-        rtgui_dc_draw_vline(dc, rect->x2, rect->y1 + r, rect->y2 - r);
+    if (r < 0) return;
+    if (r == 0) {
+        rtgui_dc_draw_rect(dc, rect);
+        return;
     }
+    if (((rect->x2 - rect->x1) / 2 < r) || ((rect->y2 - rect->y1) / 2 < r))
+        return;
+
+    _dc_draw_oval(dc, rect->x1 + r, rect->y1 + r,
+        rect->x2 - rect->x1 - (r << 1), rect->y2 - rect->y1 - (r << 1), r, r,
+        RT_FALSE);
 }
 RTM_EXPORT(rtgui_dc_draw_round_rect);
 
-void rtgui_dc_fill_round_rect(rtgui_dc_t *dc, rtgui_rect_t *rect, int r)
-{
-    rtgui_rect_t rect_temp;
+/* fill rounded rect (inclusive) of corner radius r with foreground */
+void rtgui_dc_fill_round_rect(rtgui_dc_t *dc, rtgui_rect_t *rect, int r) {
+    RT_ASSERT(((rect->x2 - rect->x1) / 2 >= r) && \
+              ((rect->y2 - rect->y1) / 2 >= r));
 
-    RT_ASSERT(((rect->x2 - rect->x1) / 2 >= r) && ((rect->y2 - rect->y1) / 2 >= r));
+    if (r < 0) return;
+    if (((rect->x2 - rect->x1) / 2 < r) || ((rect->y2 - rect->y1) / 2 < r))
+        return;
 
-    if (((rect->x2 - rect->x1) / 2 >= r) && ((rect->y2 - rect->y1) / 2 >= r))
-    {
-        rect_temp.x1 = rect->x1 + r;
-        rect_temp.y1 = rect->y1;
-        rect_temp.x2 = rect->x2 - r;
-        rect_temp.y2 = rect->y2;
-        rtgui_dc_fill_rect_forecolor(dc, &rect_temp);//fill rect with foreground
-
-        rect_temp.x1 = rect->x1;
-        rect_temp.y1 = rect->y1 + r;
-        rect_temp.x2 = rect->x1 + r;
-        rect_temp.y2 = rect->y2 - r;
-        rtgui_dc_fill_rect_forecolor(dc, &rect_temp);//fill rect with foreground
-
-        rect_temp.x1 = rect->x2 - r;
-        rect_temp.y1 = rect->y1 + r;
-        rect_temp.x2 = rect->x2;
-        rect_temp.y2 = rect->y2 - r;
-        rtgui_dc_fill_rect_forecolor(dc, &rect_temp);//fill rect with foreground
-
-        rtgui_dc_fill_circle(dc, rect->x1 + r, rect->y1 + r, r);
-        rtgui_dc_fill_circle(dc, rect->x2 - r, rect->y2 - r, r);
-        rtgui_dc_fill_circle(dc, rect->x2 - r, rect->y1 + r, r);
-        rtgui_dc_fill_circle(dc, rect->x1 + r, rect->y2 - r, r);
-    }
+    _dc_draw_oval(dc, rect->x1 + r, rect->y1 + r,
+        rect->x2 - rect->x1 - (r << 1), rect->y2 - rect->y1 - (r << 1), r, r,
+        RT_TRUE);
 }
 RTM_EXPORT(rtgui_dc_fill_round_rect);
 
@@ -265,31 +587,216 @@ void rtgui_dc_draw_shaded_rect(rtgui_dc_t *dc, rtgui_rect_t *rect,
 }
 RTM_EXPORT(rtgui_dc_draw_shaded_rect);
 
+/* gradient color stepper, channels in 16.16 fixed point */
+struct rtgui_dc_ramp {
+    rt_int32_t val[4];
+    rt_int32_t step[4];
+};
+
+#define RAMP_A(ramp)                ((ramp)->val[0] >> 16)
+#define RAMP_R(ramp)                ((ramp)->val[1] >> 16)
+#define RAMP_G(ramp)                ((ramp)->val[2] >> 16)
+#define RAMP_B(ramp)                ((ramp)->val[3] >> 16)
+#define RAMP_COLOR(ramp)            RTGUI_ARGB(RAMP_A(ramp), RAMP_R(ramp), \
+                                        RAMP_G(ramp), RAMP_B(ramp))
+
+#ifdef RTGUI_USING_GRADIENT_DITHER
+/* 4x4 Bayer thresholds */
+static const rt_uint8_t _ramp_bayer[4][4] = {
+    { 0,  8,  2, 10},
+    {12,  4, 14,  6},
+    { 3, 11,  1,  9},
+    {15,  7, 13,  5},
+};
+#endif
+
+/* from c1 at 0 to c2 at (num - 1) */
+static void _dc_ramp_init(struct rtgui_dc_ramp *ramp, rtgui_color_t c1,
+    rtgui_color_t c2, int num) {
+    rt_int32_t from[4], to[4];
+    int i;
+
+    from[0] = RTGUI_RGB_A(c1);
+    from[1] = RTGUI_RGB_R(c1);
+    from[2] = RTGUI_RGB_G(c1);
+    from[3] = RTGUI_RGB_B(c1);
+    to[0] = RTGUI_RGB_A(c2);
+    to[1] = RTGUI_RGB_R(c2);
+    to[2] = RTGUI_RGB_G(c2);
+    to[3] = RTGUI_RGB_B(c2);
+
+    for (i = 0; i < 4; i++) {
+        ramp->val[i] = (from[i] << 16) + 0x8000;
+        ramp->step[i] = (num > 1) ? \
+            (((to[i] - from[i]) << 16) / (num - 1)) : 0;
+    }
+}
+
+rt_inline void _dc_ramp_next(struct rtgui_dc_ramp *ramp) {
+    ramp->val[0] += ramp->step[0];
+    ramp->val[1] += ramp->step[1];
+    ramp->val[2] += ramp->step[2];
+    ramp->val[3] += ramp->step[3];
+}
+
+/* the pixel of ramp in display format, (x, y) selects the dither threshold */
+static rtgui_color_t _dc_ramp_pixel(struct rtgui_dc_ramp *ramp,
+    rt_uint8_t format, int x, int y) {
+#ifdef RTGUI_USING_GRADIENT_DITHER
+    if (RTGRAPHIC_PIXEL_FORMAT_RGB565 == format) {
+        rt_uint32_t t = _ramp_bayer[y & 0x03][x & 0x03];
+        rt_uint32_t r, g, b;
+        rt_uint16_t pixel;
+
+        /* add less than one output step before truncation */
+        r = _MIN(RAMP_R(ramp) + (t >> 1), 0xff);
+        g = _MIN(RAMP_G(ramp) + (t >> 2), 0xff);
+        b = _MIN(RAMP_B(ramp) + (t >> 1), 0xff);
+        RGB565_FROM_RGB(pixel, r, g, b);
+        return pixel;
+    }
+#else
+    (void)format;
+    (void)x;
+    (void)y;
+#endif
+    return rtgui_gfx_raw_color(RAMP_COLOR(ramp));
+}
+
+/* store pixel at index of line in display format */
+rt_inline void _dc_ramp_store(rt_uint8_t *line, int bpp, int idx,
+    rtgui_color_t pixel) {
+    switch (bpp) {
+    case 2:
+        ((rt_uint16_t *)line)[idx] = (rt_uint16_t)pixel;
+        break;
+
+    case 3:
+        line += idx * 3;
+        line[0] = pixel & 0xff;
+        line[1] = (pixel >> 8) & 0xff;
+        line[2] = (pixel >> 16) & 0xff;
+        break;
+
+    default:
+        ((rt_uint32_t *)line)[idx] = (rt_uint32_t)pixel;
+        break;
+    }
+}
+
+/* bytes per pixel if lines can be blitted to dc, else 0 */
+static int _dc_ramp_bpp(rtgui_dc_t *dc) {
+    rtgui_gfx_driver_t *drv = rtgui_get_gfx_device();
+
+    if (drv->bits_per_pixel < 8) return 0;
+    if (rtgui_dc_get_pixel_format(dc) != drv->pixel_format) return 0;
+    return _BIT2BYTE(drv->bits_per_pixel);
+}
+
 void rtgui_dc_fill_gradient_rectv(rtgui_dc_t *dc, rtgui_rect_t *rect,
-                                  rtgui_color_t c1, rtgui_color_t c2)
-{
-    int y, step;
+    rtgui_color_t c1, rtgui_color_t c2) {
+    struct rtgui_dc_ramp ramp;
     rtgui_color_t fc;
+    int y;
+#ifdef RTGUI_USING_GRADIENT_DITHER
+    rt_uint8_t *line = RT_NULL;
+    rt_uint8_t format;
+    int bpp, w;
+#endif
 
     RT_ASSERT(dc != RT_NULL);
     RT_ASSERT(rect != RT_NULL);
 
-    step = RECT_H(*rect);
-    fc = RTGUI_DC_FC(dc);
+    if ((rect->x1 >= rect->x2) || (rect->y1 >= rect->y2)) return;
+    _dc_ramp_init(&ramp, c1, c2, rect->y2 - rect->y1);
+
+#ifdef RTGUI_USING_GRADIENT_DITHER
+    /* dithered row repeats every 4 pixels, blit it as a line */
+    format = rtgui_dc_get_pixel_format(dc);
+    bpp = _dc_ramp_bpp(dc);
+    w = rect->x2 - rect->x1;
+    if (bpp && (RTGRAPHIC_PIXEL_FORMAT_RGB565 == format))
+        line = rtgui_malloc(w * bpp);
+
+    if (line) {
+        int x;
+
+        for (y = rect->y1; y < rect->y2; y++, _dc_ramp_next(&ramp)) {
+            for (x = 0; x < w; x++) {
+                if (x < 4)
+                    _dc_ramp_store(line, bpp, x,
+                        _dc_ramp_pixel(&ramp, format, rect->x1 + x, y));
+                else
+                    ((rt_uint16_t *)line)[x] = ((rt_uint16_t *)line)[x - 4];
+            }
+            dc->engine->blit_line(dc, rect->x1, rect->x2, y, line);
+        }
+        rtgui_free(line);
+        return;
+    }
+#endif
 
-    for (y = rect->y1; y < rect->y2; y++)
-    {
-        RTGUI_DC_FC(dc) = RTGUI_ARGB(((int)RTGUI_RGB_A(c2) - RTGUI_RGB_A(c1)) * (y - rect->y1) / step + RTGUI_RGB_A(c1),
-                                     ((int)RTGUI_RGB_R(c2) - RTGUI_RGB_R(c1)) * (y - rect->y1) / step + RTGUI_RGB_R(c1),
-                                     ((int)RTGUI_RGB_G(c2) - RTGUI_RGB_G(c1)) * (y - rect->y1) / step + RTGUI_RGB_G(c1),
-                                     ((int)RTGUI_RGB_B(c2) - RTGUI_RGB_B(c1)) * (y - rect->y1) / step + RTGUI_RGB_B(c1));
+    fc = RTGUI_DC_FC(dc);
+    for (y = rect->y1; y < rect->y2; y++, _dc_ramp_next(&ramp)) {
+        RTGUI_DC_FC(dc) = RAMP_COLOR(&ramp);
         rtgui_dc_draw_hline(dc, rect->x1, rect->x2, y);
     }
-
     RTGUI_DC_FC(dc) = fc;
 }
 RTM_EXPORT(rtgui_dc_fill_gradient_rectv);
 
+void rtgui_dc_fill_gradient_recth(rtgui_dc_t *dc, rtgui_rect_t *rect,
+    rtgui_color_t c1, rtgui_color_t c2) {
+    struct rtgui_dc_ramp ramp;
+    rt_uint8_t *line;
+    rt_uint8_t format;
+    int bpp, w, rows, x, y;
+
+    RT_ASSERT(dc != RT_NULL);
+    RT_ASSERT(rect != RT_NULL);
+
+    if ((rect->x1 >= rect->x2) || (rect->y1 >= rect->y2)) return;
+    w = rect->x2 - rect->x1;
+    _dc_ramp_init(&ramp, c1, c2, w);
+
+    format = rtgui_dc_get_pixel_format(dc);
+    bpp = _dc_ramp_bpp(dc);
+#ifdef RTGUI_USING_GRADIENT_DITHER
+    /* one row per dither line */
+    rows = (RTGRAPHIC_PIXEL_FORMAT_RGB565 == format) ? \
+        _MIN(rect->y2 - rect->y1, 4) : 1;
+#else
+    rows = 1;
+#endif
+    line = bpp ? rtgui_malloc(w * bpp * rows) : RT_NULL;
+
+    if (!line) {
+        /* no line buffer, column by column */
+        rtgui_color_t fc = RTGUI_DC_FC(dc);
+
+        for (x = rect->x1; x < rect->x2; x++, _dc_ramp_next(&ramp)) {
+            RTGUI_DC_FC(dc) = RAMP_COLOR(&ramp);
+            rtgui_dc_draw_vline(dc, x, rect->y1, rect->y2);
+        }
+        RTGUI_DC_FC(dc) = fc;
+        return;
+    }
+
+    /* build the rows once ... */
+    for (x = 0; x < w; x++, _dc_ramp_next(&ramp)) {
+        for (y = 0; y < rows; y++)
+            _dc_ramp_store(line + w * bpp * y, bpp, x,
+                _dc_ramp_pixel(&ramp, format, rect->x1 + x, rect->y1 + y));
+    }
+    /* ... and replay them */
+    for (y = rect->y1; y < rect->y2; y++)
+        dc->engine->blit_line(dc, rect->x1, rect->x2, y,
+            line + w * bpp * ((y - rect->y1) % rows));
+
+    rtgui_free(line);
+}
+RTM_EXPORT(rtgui_dc_fill_gradient_recth);
+
 void rtgui_dc_draw_focus_rect(rtgui_dc_t *dc, rtgui_rect_t *rect) {
     rt_int16_t x, y;
 
@@ -323,50 +830,283 @@ void rtgui_dc_draw_text(rtgui_dc_t *dc, const char *text, rtgui_rect_t *rect) {
 }
 RTM_EXPORT(rtgui_dc_draw_text);
 
-void rtgui_dc_draw_text_stroke(rtgui_dc_t *dc, const char *text, rtgui_rect_t *rect,
-                               rtgui_color_t color_stroke, rtgui_color_t color_core)
-{
-    int x, y;
-    rtgui_rect_t r;
-    rtgui_color_t fc;
+/* capture drawn points of text to a 1bpp mask (MSB first) */
+static void _dc_mask_draw_point(rtgui_dc_t *self, int x, int y) {
+    struct rtgui_dc_buffer *dc = (struct rtgui_dc_buffer *)self;
+
+    if ((x < 0) || (x >= dc->width) || (y < 0) || (y >= dc->height)) return;
+    dc->pixel[dc->pitch * y + (x >> 3)] |= 0x80 >> (x & 0x07);
+}
+
+static void _dc_mask_draw_color_point(rtgui_dc_t *self, int x, int y,
+    rtgui_color_t color) {
+    (void)self;
+    (void)x;
+    (void)y;
+    (void)color;
+}
+
+static void _dc_mask_draw_line(rtgui_dc_t *self, int a, int b, int c) {
+    (void)self;
+    (void)a;
+    (void)b;
+    (void)c;
+}
+
+static void _dc_mask_fill_rect(rtgui_dc_t *self, rtgui_rect_t *rect) {
+    (void)self;
+    (void)rect;
+}
+
+static void _dc_mask_blit_line(rtgui_dc_t *self, int x1, int x2, int y,
+    rt_uint8_t *line_data) {
+    (void)self;
+    (void)x1;
+    (void)x2;
+    (void)y;
+    (void)line_data;
+}
+
+static void _dc_mask_blit(rtgui_dc_t *self, struct rtgui_point *dc_point,
+    rtgui_dc_t *dest, rtgui_rect_t *rect) {
+    (void)self;
+    (void)dc_point;
+    (void)dest;
+    (void)rect;
+}
+
+static rt_bool_t _dc_mask_fini(rtgui_dc_t *self) {
+    (void)self;
+    return RT_TRUE;
+}
+
+static const rtgui_dc_engine_t _dc_mask_engine = {
+    _dc_mask_draw_point,
+    _dc_mask_draw_color_point,
+    _dc_mask_draw_line,
+    _dc_mask_draw_line,
+    _dc_mask_fill_rect,
+    _dc_mask_blit_line,
+    _dc_mask_blit,
+    _dc_mask_fini,
+};
+
+/* byte idx of mask line dilated by one pixel horizontally */
+rt_inline rt_uint8_t _mask_dilate(const rt_uint8_t *line, int idx, int pitch) {
+    rt_uint8_t b = line[idx];
+
+    return b | (b >> 1) | (b << 1) | \
+        ((idx > 0) ? (line[idx - 1] << 7) : 0) | \
+        ((idx < (pitch - 1)) ? (line[idx + 1] >> 7) : 0);
+}
+
+#define STROKE_STACK_MASK                   (128)
+
+/*
+ * draw text with one pixel stroke, the glyphs are rendered to a mask once and
+ * drawn with the dilated mask in one pass of spans
+ */
+void rtgui_dc_draw_text_stroke(rtgui_dc_t *dc, const char *text,
+    rtgui_rect_t *rect, rtgui_color_t color_stroke, rtgui_color_t color_core) {
+    struct rtgui_dc_buffer mask;
+    rt_uint8_t stack[STROKE_STACK_MASK];
+    rtgui_rect_t text_rect, area;
+    rtgui_gc_t *gc;
+    rtgui_color_t fc, color[3];
+    rt_uint32_t len, size;
+    int x, y, idx, start, kind, last;
 
     RT_ASSERT(dc != RT_NULL);
 
-    fc = RTGUI_DC_FC(dc);
-    RTGUI_DC_FC(dc) = color_stroke;
-    for (x = -1; x < 2; x++)
-    {
-        for (y = -1; y < 2; y++)
-        {
-            r = *rect;
-            rtgui_rect_move(&r, x, y);
-            rtgui_dc_draw_text(dc, text, &r);
+    len = rt_strlen(text);
+    if (!len) return;
+
+    gc = rtgui_dc_get_gc(dc);
+    mask.gc = *gc;
+    if (!mask.gc.font) mask.gc.font = rtgui_font_default();
+    mask.gc.textstyle &= ~RTGUI_TEXTSTYLE_DRAW_BACKGROUND;
+
+    /* the glyphs are in the aligned text rect, plus one pixel of stroke */
+    rtgui_font_get_metrics(mask.gc.font, text, &text_rect);
+    rtgui_rect_move_align(rect, &text_rect, mask.gc.textalign);
+    area = text_rect;
+    rtgui_rect_inflate(&area, 1);
+    if ((area.x2 <= area.x1) || (area.y2 <= area.y1)) return;
+
+    mask._super.type = RTGUI_DC_BUFFER;
+    mask._super.engine = &_dc_mask_engine;
+    mask.pixel_format = RTGRAPHIC_PIXEL_FORMAT_MONO;
+    mask.bpp = 0;
+    mask.width = RECT_W(area);
+    mask.height = RECT_H(area);
+    mask.pitch = (mask.width + 7) >> 3;
+    size = mask.pitch * mask.height;
+    if (size <= sizeof(stack)) {
+        mask.pixel = stack;
+    } else {
+        mask.pixel = rtgui_malloc(size);
+        if (!mask.pixel) {
+            LOG_E("no mem for mask");
+            return;
         }
     }
-    RTGUI_DC_FC(dc) = color_core;
-    rtgui_dc_draw_text(dc, text, rect);
-    RTGUI_DC_FC(dc) = fc;
+    rt_memset(mask.pixel, 0x00, size);
+
+    if (gc->textstyle & RTGUI_TEXTSTYLE_DRAW_BACKGROUND)
+        rtgui_dc_fill_rect(dc, &text_rect);
+
+    /* render the glyphs once */
+    text_rect = *rect;
+    rtgui_rect_move(&text_rect, -area.x1, -area.y1);
+    rtgui_font_draw(mask.gc.font, &mask._super, text, len, &text_rect);
+
+    /* 0: none, 1: stroke, 2: core */
+    color[0] = 0;
+    color[1] = color_stroke;
+    color[2] = color_core;
+    fc = gc->foreground;
+    for (y = 0; y < mask.height; y++) {
+        rt_uint8_t *line = mask.pixel + mask.pitch * y;
+        rt_uint8_t core = 0, edge = 0;
+
+        start = 0;
+        last = 0;
+        for (x = 0; x <= mask.width; x++) {
+            if (x == mask.width) {
+                kind = -1;
+            } else {
+                if (!(x & 0x07)) {
+                    idx = x >> 3;
+                    core = line[idx];
+                    edge = _mask_dilate(line, idx, mask.pitch);
+                    if (y > 0)
+                        edge |= _mask_dilate(line - mask.pitch, idx,
+                            mask.pitch);
+                    if (y < (mask.height - 1))
+                        edge |= _mask_dilate(line + mask.pitch, idx,
+                            mask.pitch);
+                    /* skip empty byte */
+                    if (!edge && !last && ((x + 8) <= mask.width)) {
+                        x += 7;
+                        start = x + 1;
+                        continue;
+                    }
+                }
+                kind = (core & (0x80 >> (x & 0x07))) ? 2 : \
+                       ((edge & (0x80 >> (x & 0x07))) ? 1 : 0);
+            }
+            if (kind == last) continue;
+            if (last) {
+                gc->foreground = color[last];
+                rtgui_dc_draw_hline(dc, area.x1 + start, area.x1 + x,
+                    area.y1 + y);
+            }
+            start = x;
+            last = kind;
+        }
+    }
+    gc->foreground = fc;
+
+    if (mask.pixel != stack) rtgui_free(mask.pixel);
 }
 RTM_EXPORT(rtgui_dc_draw_text_stroke);
 
+/* number of leading (MSB first) ones of a byte */
+static const rt_uint8_t _mono_lead_ones[256] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    4, 4, 4, 4, 4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 7, 8,
+};
+
+/* end of the run of bits equal to the one at x, within w */
+static int _mono_run_end(const rt_uint8_t *line, int x, int w) {
+    rt_uint8_t inv, n, left;
+
+    /* count ones of inverted byte for a run of zeros */
+    inv = (line[x >> 3] & (0x80 >> (x & 0x07))) ? 0x00 : 0xff;
+    do {
+        left = 8 - (x & 0x07);
+        n = _mono_lead_ones[(rt_uint8_t)((line[x >> 3] ^ inv) << (x & 0x07))];
+        x += n;
+    } while ((n == left) && (x < w));
+
+    return _MIN(x, w);
+}
+
+/* draw set bits in foreground and others in background if opaque, by runs */
+static void _dc_draw_mono_runs(rtgui_dc_t *dc, int x, int y, int w, int h,
+    const rt_uint8_t *data, rt_bool_t opaque) {
+    rtgui_gc_t *gc = rtgui_dc_get_gc(dc);
+    rtgui_color_t fc = gc->foreground;
+    int pitch = (w + 7) >> 3;
+    int i, start, end;
+
+    for (i = 0; i < h; i++, data += pitch) {
+        for (start = 0; start < w; start = end) {
+            end = _mono_run_end(data, start, w);
+            if (data[start >> 3] & (0x80 >> (start & 0x07))) {
+                gc->foreground = fc;
+            } else if (opaque) {
+                gc->foreground = gc->background;
+            } else {
+                continue;
+            }
+            rtgui_dc_draw_hline(dc, x + start, x + end, y + i);
+        }
+    }
+    gc->foreground = fc;
+}
+
 /*
- * draw a monochrome color bitmap data
+ * draw a monochrome color bitmap data, lines are (w + 7) / 8 bytes and MSB
+ * first, set bits are drawn in foreground
  */
-void rtgui_dc_draw_mono_bmp(rtgui_dc_t *dc, int x, int y, int w, int h, const rt_uint8_t *data)
-{
-    int i, j, k;
+void rtgui_dc_draw_mono_bmp(rtgui_dc_t *dc, int x, int y, int w, int h,
+    const rt_uint8_t *data) {
+    if (!dc || !data || (w <= 0)) return;
+    _dc_draw_mono_runs(dc, x, y, w, h, data, RT_FALSE);
+}
+RTM_EXPORT(rtgui_dc_draw_mono_bmp);
+
+/* draw a monochrome color bitmap data, clear bits are drawn in background */
+void rtgui_dc_draw_mono_bmp_opaque(rtgui_dc_t *dc, int x, int y, int w, int h,
+    const rt_uint8_t *data) {
+    if (!dc || !data || (w <= 0)) return;
+    _dc_draw_mono_runs(dc, x, y, w, h, data, RT_TRUE);
+}
+RTM_EXPORT(rtgui_dc_draw_mono_bmp_opaque);
+
+/*
+ * expand a monochrome color bitmap to a buffer dc in display format, for
+ * small bitmaps drawn repeatedly by rtgui_dc_blit()
+ */
+rtgui_dc_t *rtgui_dc_mono_bmp_cache(int w, int h, const rt_uint8_t *data,
+    rtgui_color_t fc, rtgui_color_t bc) {
+    rtgui_dc_t *dc;
 
-    /* get word bytes */
-    w = (w + 7) / 8;
+    if (!data) return RT_NULL;
+    dc = rtgui_dc_buffer_create(w, h);
+    if (!dc) return RT_NULL;
 
-    /* draw mono bitmap data */
-    for (i = 0; i < h; i ++)
-        for (j = 0; j < w; j++)
-            for (k = 0; k < 8; k++)
-                if (((data[i * w + j] >> (7 - k)) & 0x01) != 0)
-                    rtgui_dc_draw_point(dc, x + 8 * j + k, y + i);
+    RTGUI_DC_FC(dc) = fc;
+    RTGUI_DC_BC(dc) = bc;
+    _dc_draw_mono_runs(dc, 0, 0, w, h, data, RT_TRUE);
+    return dc;
 }
-RTM_EXPORT(rtgui_dc_draw_mono_bmp);
+RTM_EXPORT(rtgui_dc_mono_bmp_cache);
 
 void rtgui_dc_draw_byte(rtgui_dc_t *dc, int x, int y, int h, const rt_uint8_t *data)
 {
@@ -463,180 +1203,154 @@ void rtgui_dc_draw_polygon(rtgui_dc_t *dc, const int *vx, const int *vy, int cou
 }
 RTM_EXPORT(rtgui_dc_draw_polygon);
 
-void rtgui_dc_fill_polygon(rtgui_dc_t *dc, const int *vx, const int *vy, int count)
-{
-    int i;
-    int y, xa, xb;
-    int miny, maxy;
-    int x1, y1;
-    int x2, y2;
-    int ind1, ind2;
-    int ints;
-    int *poly_ints = RT_NULL;
+/* vertices of polygon filled with stack scratch */
+#define POLY_STACK_VERTICES                 (6)
 
-    /*
-     * Sanity check number of edges
-     */
-    if (count < 3) return;
-
-    /*
-     * Allocate temp array, only grow array
-     */
-    poly_ints = (int *) rtgui_malloc(sizeof(int) * count);
-    if (poly_ints == RT_NULL) return ; /* no memory, failed */
-
-    /*
-     * Determine Y maximal
-     */
-    miny = vy[0];
-    maxy = vy[0];
-    for (i = 1; (i < count); i++)
-    {
-        if (vy[i] < miny) miny = vy[i];
-        else if (vy[i] > maxy) maxy = vy[i];
+/* insert edge to the list sorted by key, the list has room for one more */
+static void _poly_insert(struct rtgui_poly_edge *list, int num,
+    const struct rtgui_poly_edge *edge, rt_bool_t by_y) {
+    while (num > 0) {
+        if (by_y ? (list[num - 1].y1 <= edge->y1) : (list[num - 1].x <= edge->x))
+            break;
+        list[num] = list[num - 1];
+        num--;
     }
+    list[num] = *edge;
+}
 
-    /*
-     * Draw, scanning y
-     */
-    for (y = miny; (y <= maxy); y++)
-    {
-        ints = 0;
-        for (i = 0; (i < count); i++)
-        {
-            if (!i)
-            {
-                ind1 = count - 1;
-                ind2 = 0;
-            }
-            else
-            {
-                ind1 = i - 1;
-                ind2 = i;
-            }
-            y1 = vy[ind1];
-            y2 = vy[ind2];
-            if (y1 < y2)
-            {
-                x1 = vx[ind1];
-                x2 = vx[ind2];
-            }
-            else if (y1 > y2)
-            {
-                y2 = vy[ind1];
-                y1 = vy[ind2];
-                x2 = vx[ind1];
-                x1 = vx[ind2];
-            }
-            else
-            {
-                continue;
-            }
-
-            if (((y >= y1) && (y < y2)) || ((y == maxy) && (y > y1) && (y <= y2)))
-            {
-                poly_ints[ints++] = ((65536 * (y - y1)) / (y2 - y1)) * (x2 - x1) + (65536 * x1);
-            }
+rt_err_t rtgui_dc_fill_polygon_buf(rtgui_dc_t *dc, const int *vx,
+    const int *vy, int count, void *scratch, rt_uint32_t size) {
+    struct rtgui_poly_edge *table, *active, edge;
+    int i, j, num, act, next;
+    int y, miny, maxy, xa, xb;
+    int x1, y1, x2, y2;
+
+    if (!dc || (count < 3)) return -RT_EINVAL;
+    if (!scratch || (size < RTGUI_POLY_SCRATCH_SIZE(count)))
+        return -RT_ENOMEM;
+    table = (struct rtgui_poly_edge *)scratch;
+    active = table + count;
+
+    /* edge table, sorted by the first line and horizontal edges dropped */
+    miny = maxy = vy[0];
+    for (i = 0, num = 0; i < count; i++) {
+        j = i ? (i - 1) : (count - 1);
+        if (vy[j] < vy[i]) {
+            x1 = vx[j];
+            y1 = vy[j];
+            x2 = vx[i];
+            y2 = vy[i];
+        } else if (vy[j] > vy[i]) {
+            x1 = vx[i];
+            y1 = vy[i];
+            x2 = vx[j];
+            y2 = vy[j];
+        } else {
+            continue;
+        }
+        if (y1 < miny) miny = y1;
+        if (y2 > maxy) maxy = y2;
+
+        edge.x = x1 * 65536;
+        edge.dx = ((x2 - x1) * 65536) / (y2 - y1);
+        edge.rem = ((x2 - x1) * 65536) % (y2 - y1);
+        if (edge.rem < 0) {
+            edge.dx--;
+            edge.rem += y2 - y1;
         }
+        edge.err = 0;
+        edge.y1 = y1;
+        edge.y2 = y2;
+        _poly_insert(table, num++, &edge, RT_TRUE);
+    }
 
-        qsort(poly_ints, ints, sizeof(int), _int_compare);
+    /* scan lines with active edge list, the last line is closed by the
+       edges ending on it */
+    for (y = miny, act = 0, next = 0; y <= maxy; y++) {
+        for (i = 0, j = 0; i < act; i++) {
+            if ((y >= active[i].y2) && (y != maxy)) continue;
+            active[j++] = active[i];
+        }
+        act = j;
+        while ((next < num) && (table[next].y1 == y))
+            _poly_insert(active, act++, &table[next++], RT_FALSE);
 
-        for (i = 0; (i < ints); i += 2)
-        {
-            xa = poly_ints[i] + 1;
+        for (i = 0; (i + 1) < act; i += 2) {
+            xa = active[i].x + 1;
             xa = (xa >> 16) + ((xa & 32768) >> 15);
-            xb = poly_ints[i + 1] - 1;
+            xb = active[i + 1].x - 1;
             xb = (xb >> 16) + ((xb & 32768) >> 15);
             rtgui_dc_draw_hline(dc, xa, xb, y);
         }
+
+        /* step to next line, the list stays nearly sorted */
+        for (i = 0; i < act; i++) {
+            edge = active[i];
+            edge.x += edge.dx;
+            edge.err += edge.rem;
+            if (edge.err >= (edge.y2 - edge.y1)) {
+                edge.x++;
+                edge.err -= edge.y2 - edge.y1;
+            }
+            _poly_insert(active, i, &edge, RT_FALSE);
+        }
     }
 
-    /* release memory */
-    rtgui_free(poly_ints);
+    return RT_EOK;
 }
-RTM_EXPORT(rtgui_dc_fill_polygon);
+RTM_EXPORT(rtgui_dc_fill_polygon_buf);
 
-void rtgui_dc_draw_circle(rtgui_dc_t *dc, int x, int y, int r)
-{
-    rtgui_dc_draw_ellipse(dc, x, y, r, r);
-}
-RTM_EXPORT(rtgui_dc_draw_circle);
-
-enum
+void rtgui_dc_fill_polygon(rtgui_dc_t *dc, const int *vx, const int *vy, int count)
 {
-    QUARTER_BTM,
-    QUARTER_BTM_LEFT,
-    QUARTER_BTM_RIGHT,
-    QUARTER_TOP,
-    QUARTER_TOP_LEFT,
-    QUARTER_TOP_RIGHT,
-    QUARTER_FULL,
-};
+    struct rtgui_poly_edge edges[2 * POLY_STACK_VERTICES];
+    void *scratch;
 
-static void _fill_quarter_circle(rtgui_dc_t *dc,
-                                 rt_int16_t ox, rt_int16_t oy,
-                                 rt_int16_t rad, int quadrant)
-{
-    /* Midpoint circle algorithm. */
-    int dk, x, y;
+    if (count < 3) return;
 
-    dk = 1 - rad;
-    x = 0;
-    y = rad;
+    if (count <= POLY_STACK_VERTICES) {
+        (void)rtgui_dc_fill_polygon_buf(dc, vx, vy, count, edges,
+            sizeof(edges));
+        return;
+    }
 
-    while (x <= y)
-    {
-        switch (quadrant)
-        {
-        case QUARTER_BTM:
-            rtgui_dc_draw_hline(dc, ox - x, ox + x, oy + y);
-            rtgui_dc_draw_hline(dc, ox - y, ox + y, oy + x);
-            break;
-        case QUARTER_BTM_LEFT:
-            rtgui_dc_draw_hline(dc, ox, ox + x, oy + y);
-            rtgui_dc_draw_hline(dc, ox, ox + y, oy + x);
-            break;
-        case QUARTER_BTM_RIGHT:
-            rtgui_dc_draw_hline(dc, ox, ox - x, oy + y);
-            rtgui_dc_draw_hline(dc, ox, ox - y, oy + x);
-            break;
-        case QUARTER_TOP_RIGHT:
-            rtgui_dc_draw_hline(dc, ox, ox - x, oy - y);
-            rtgui_dc_draw_hline(dc, ox, ox - y, oy - x);
-            break;
-        case QUARTER_TOP_LEFT:
-            rtgui_dc_draw_hline(dc, ox, ox + x, oy - y);
-            rtgui_dc_draw_hline(dc, ox, ox + y, oy - x);
-            break;
-        case QUARTER_TOP:
-            rtgui_dc_draw_hline(dc, ox - x, ox + x, oy - y);
-            rtgui_dc_draw_hline(dc, ox - y, ox + y, oy - x);
-            break;
-        case QUARTER_FULL:
-            rtgui_dc_draw_hline(dc, ox - x, ox + x, oy + y);
-            rtgui_dc_draw_hline(dc, ox - y, ox + y, oy + x);
-            rtgui_dc_draw_hline(dc, ox - x, ox + x, oy - y);
-            rtgui_dc_draw_hline(dc, ox - y, ox + y, oy - x);
-            break;
-        default:
-            RT_ASSERT(0);
-        };
+    scratch = rtgui_malloc(RTGUI_POLY_SCRATCH_SIZE(count));
+    if (!scratch) return; /* no memory, failed */
+    (void)rtgui_dc_fill_polygon_buf(dc, vx, vy, count, scratch,
+        RTGUI_POLY_SCRATCH_SIZE(count));
+    rtgui_free(scratch);
+}
+RTM_EXPORT(rtgui_dc_fill_polygon);
 
-        if (dk > 0)
-        {
-            y--;
-            dk += 2 * (x - y) + 5;
-        }
-        else
-        {
-            dk += 2 * x + 3;
+void rtgui_dc_draw_circle(rtgui_dc_t *dc, int x, int y, int r)
+{
+    const struct rtgui_graphic_ext_ops *ext_ops;
+    struct rtgui_point offset;
+    rtgui_rect_t area;
+
+    if (r > 0) {
+        area.x1 = x - r;
+        area.y1 = y - r;
+        area.x2 = x + r;
+        area.y2 = y + r;
+        ext_ops = _dc_get_ext_ops(dc, &area, &offset);
+        if (ext_ops && ext_ops->draw_circle) {
+            _dc_ext_damage(dc, &area, &offset);
+            ext_ops->draw_circle(&RTGUI_DC_FC(dc), x + offset.x, y + offset.y,
+                r);
+            return;
         }
-        x++;
     }
+
+    rtgui_dc_draw_ellipse(dc, x, y, r, r);
 }
+RTM_EXPORT(rtgui_dc_draw_circle);
 
 void rtgui_dc_fill_circle(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_t r)
 {
+    const struct rtgui_graphic_ext_ops *ext_ops;
+    struct rtgui_point offset;
+    rtgui_rect_t area;
+
     /*
      * Sanity check radius
      */
@@ -652,7 +1366,18 @@ void rtgui_dc_fill_circle(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_t
         return;
     }
 
-    _fill_quarter_circle(dc, x, y, r, QUARTER_FULL);
+    area.x1 = x - r;
+    area.y1 = y - r;
+    area.x2 = x + r;
+    area.y2 = y + r;
+    ext_ops = _dc_get_ext_ops(dc, &area, &offset);
+    if (ext_ops && ext_ops->fill_circle) {
+        _dc_ext_damage(dc, &area, &offset);
+        ext_ops->fill_circle(&RTGUI_DC_FC(dc), x + offset.x, y + offset.y, r);
+        return;
+    }
+
+    _dc_draw_oval(dc, x, y, 0, 0, r, r, RT_TRUE);
 }
 RTM_EXPORT(rtgui_dc_fill_circle);
 
@@ -667,7 +1392,7 @@ void rtgui_dc_draw_arc(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_t r,
     rt_int16_t ypcy, ymcy, ypcx, ymcx;
     rt_uint8_t drawoct;
     int startoct, endoct, oct, stopval_start, stopval_end;
-    double temp;
+    rt_int32_t temp;
 
     stopval_start = 0;
     stopval_end = 0;
@@ -727,23 +1452,22 @@ void rtgui_dc_draw_arc(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_t r,
             {
             case 0:
             case 3:
-                temp = sin(start * M_PI / 180);
+                temp = rtgui_sin_mul(RTGUI_ANGLE(start), r);
                 break;
             case 1:
             case 6:
-                temp = cos(start * M_PI / 180);
+                temp = rtgui_cos_mul(RTGUI_ANGLE(start), r);
                 break;
             case 2:
             case 5:
-                temp = -cos(start * M_PI / 180);
+                temp = -rtgui_cos_mul(RTGUI_ANGLE(start), r);
                 break;
             case 4:
             case 7:
-                temp = -sin(start * M_PI / 180);
+                temp = -rtgui_sin_mul(RTGUI_ANGLE(start), r);
                 break;
             }
-            temp *= r;
-            stopval_start = (int)temp; // always round down.
+            stopval_start = temp; // always round down.
             // This isn't arbitrary, but requires graph paper to explain well.
             // The basic idea is that we're always changing drawoct after we draw, so we
             // stop immediately after we render the last sensible pixel at x = ((int)temp).
@@ -760,23 +1484,22 @@ void rtgui_dc_draw_arc(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_t r,
             {
             case 0:
             case 3:
-                temp = sin(end * M_PI / 180);
+                temp = rtgui_sin_mul(RTGUI_ANGLE(end), r);
                 break;
             case 1:
             case 6:
-                temp = cos(end * M_PI / 180);
+                temp = rtgui_cos_mul(RTGUI_ANGLE(end), r);
                 break;
             case 2:
             case 5:
-                temp = -cos(end * M_PI / 180);
+                temp = -rtgui_cos_mul(RTGUI_ANGLE(end), r);
                 break;
             case 4:
             case 7:
-                temp = -sin(end * M_PI / 180);
+                temp = -rtgui_sin_mul(RTGUI_ANGLE(end), r);
                 break;
             }
-            temp *= r;
-            stopval_end = (int)temp;
+            stopval_end = temp;
 
             // and whether to draw in this octant initially
             if (startoct == endoct)
@@ -882,11 +1605,6 @@ RTM_EXPORT(rtgui_dc_draw_arc);
 
 void rtgui_dc_draw_annulus(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_t r1, rt_int16_t r2, rt_int16_t start, rt_int16_t end)
 {
-    rt_int16_t start_x, start_y;
-    rt_int16_t end_x, end_y;
-    double temp;
-    rt_int16_t temp_val = 0;
-
     /* Sanity check radius */
     if ((r1 < 0) || (r2 < 0)) return ;
     /* Special case for r=0 - draw a point */
@@ -902,45 +1620,24 @@ void rtgui_dc_draw_annulus(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_
     rtgui_dc_draw_arc(dc, x, y, r1, start, end);
     rtgui_dc_draw_arc(dc, x, y, r2, start, end);
 
-    temp     = cos(start * M_PI / 180);
-    temp_val = (int)(temp * r1);
-    start_x  = x + temp_val;
-    temp_val = (int)(temp * r2);
-    end_x    = x + temp_val;
-
-    temp     = sin(start * M_PI / 180);
-    temp_val = (int)(temp * r1);
-    start_y  = y + temp_val;
-    temp_val = (int)(temp * r2);
-    end_y    = y + temp_val;
-
-    rtgui_dc_draw_line(dc, start_x, start_y, end_x, end_y);
-
-    temp     = cos(end * M_PI / 180);
-    temp_val = (int)(temp * r1);
-    start_x  = x + temp_val;
-    temp_val = (int)(temp * r2);
-    end_x    = x + temp_val;
-
-    temp     = sin(end * M_PI / 180);
-    temp_val = (int)(temp * r1);
-    start_y  = y + temp_val;
-    temp_val = (int)(temp * r2);
-    end_y    = y + temp_val;
-
-    rtgui_dc_draw_line(dc, start_x, start_y, end_x, end_y);
+    rtgui_dc_draw_line(dc,
+        x + rtgui_cos_mul(RTGUI_ANGLE(start), r1),
+        y + rtgui_sin_mul(RTGUI_ANGLE(start), r1),
+        x + rtgui_cos_mul(RTGUI_ANGLE(start), r2),
+        y + rtgui_sin_mul(RTGUI_ANGLE(start), r2));
+    rtgui_dc_draw_line(dc,
+        x + rtgui_cos_mul(RTGUI_ANGLE(end), r1),
+        y + rtgui_sin_mul(RTGUI_ANGLE(end), r1),
+        x + rtgui_cos_mul(RTGUI_ANGLE(end), r2),
+        y + rtgui_sin_mul(RTGUI_ANGLE(end), r2));
 }
 RTM_EXPORT(rtgui_dc_draw_annulus);
 
 void rtgui_dc_draw_ellipse(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_t rx, rt_int16_t ry)
 {
-    int ix, iy;
-    int h, i, j, k;
-    int oh, oi, oj, ok;
-    int xmh, xph, ypk, ymk;
-    int xmi, xpi, ymj, ypj;
-    int xmj, xpj, ymi, ypi;
-    int xmk, xpk, ymh, yph;
+    const struct rtgui_graphic_ext_ops *ext_ops;
+    struct rtgui_point offset;
+    rtgui_rect_t area;
 
     /*
      * Sanity check radii
@@ -952,7 +1649,7 @@ void rtgui_dc_draw_ellipse(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_
      */
     if (rx == 0)
     {
-        rtgui_dc_draw_vline(dc, x, y - ry, y + ry);
+        rtgui_dc_draw_vline(dc, x, y - ry, y + ry + 1);
         return;
     }
 
@@ -961,278 +1658,71 @@ void rtgui_dc_draw_ellipse(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_
      */
     if (ry == 0)
     {
-        rtgui_dc_draw_hline(dc, x - rx, x + rx, y);
+        rtgui_dc_draw_hline(dc, x - rx, x + rx + 1, y);
         return;
     }
 
-    /*
-     * Init vars
-     */
-    oh = oi = oj = ok = 0xFFFF;
-
-    if (rx > ry)
-    {
-        ix = 0;
-        iy = rx * 64;
-
-        do
-        {
-            h = (ix + 32) >> 6;
-            i = (iy + 32) >> 6;
-            j = (h * ry) / rx;
-            k = (i * ry) / rx;
-
-            if (((ok != k) && (oj != k)) || ((oj != j) && (ok != j)) || (k != j))
-            {
-                xph = x + h;
-                xmh = x - h;
-                if (k > 0)
-                {
-                    ypk = y + k;
-                    ymk = y - k;
-                    rtgui_dc_draw_point(dc, xmh, ypk);
-                    rtgui_dc_draw_point(dc, xph, ypk);
-                    rtgui_dc_draw_point(dc, xmh, ymk);
-                    rtgui_dc_draw_point(dc, xph, ymk);
-                }
-                else
-                {
-                    rtgui_dc_draw_point(dc, xmh, y);
-                    rtgui_dc_draw_point(dc, xph, y);
-                }
-                ok = k;
-                xpi = x + i;
-                xmi = x - i;
-                if (j > 0)
-                {
-                    ypj = y + j;
-                    ymj = y - j;
-                    rtgui_dc_draw_point(dc, xmi, ypj);
-                    rtgui_dc_draw_point(dc, xpi, ypj);
-                    rtgui_dc_draw_point(dc, xmi, ymj);
-                    rtgui_dc_draw_point(dc, xpi, ymj);
-                }
-                else
-                {
-                    rtgui_dc_draw_point(dc, xmi, y);
-                    rtgui_dc_draw_point(dc, xpi, y);
-                }
-                oj = j;
-            }
-
-            ix = ix + iy / rx;
-            iy = iy - ix / rx;
-        }
-        while (i > h);
+    area.x1 = x - rx;
+    area.y1 = y - ry;
+    area.x2 = x + rx;
+    area.y2 = y + ry;
+    ext_ops = _dc_get_ext_ops(dc, &area, &offset);
+    if (ext_ops && ext_ops->draw_ellipse) {
+        _dc_ext_damage(dc, &area, &offset);
+        ext_ops->draw_ellipse(&RTGUI_DC_FC(dc), x + offset.x, y + offset.y,
+            rx, ry);
+        return;
     }
-    else
-    {
-        ix = 0;
-        iy = ry * 64;
-
-        do
-        {
-            h = (ix + 32) >> 6;
-            i = (iy + 32) >> 6;
-            j = (h * rx) / ry;
-            k = (i * rx) / ry;
-
-            if (((oi != i) && (oh != i)) || ((oh != h) && (oi != h) && (i != h)))
-            {
-                xmj = x - j;
-                xpj = x + j;
-                if (i > 0)
-                {
-                    ypi = y + i;
-                    ymi = y - i;
-                    rtgui_dc_draw_point(dc, xmj, ypi);
-                    rtgui_dc_draw_point(dc, xpj, ypi);
-                    rtgui_dc_draw_point(dc, xmj, ymi);
-                    rtgui_dc_draw_point(dc, xpj, ymi);
-                }
-                else
-                {
-                    rtgui_dc_draw_point(dc, xmj, y);
-                    rtgui_dc_draw_point(dc, xpj, y);
-                }
-                oi = i;
-                xmk = x - k;
-                xpk = x + k;
-                if (h > 0)
-                {
-                    yph = y + h;
-                    ymh = y - h;
-                    rtgui_dc_draw_point(dc, xmk, yph);
-                    rtgui_dc_draw_point(dc, xpk, yph);
-                    rtgui_dc_draw_point(dc, xmk, ymh);
-                    rtgui_dc_draw_point(dc, xpk, ymh);
-                }
-                else
-                {
-                    rtgui_dc_draw_point(dc, xmk, y);
-                    rtgui_dc_draw_point(dc, xpk, y);
-                }
-                oh = h;
-            }
 
-            ix = ix + iy / ry;
-            iy = iy - ix / ry;
-        }
-        while (i > h);
-    }
+    _dc_draw_oval(dc, x, y, 0, 0, rx, ry, RT_FALSE);
 }
 RTM_EXPORT(rtgui_dc_draw_ellipse);
 
 void rtgui_dc_fill_ellipse(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_t rx, rt_int16_t ry)
 {
-    int ix, iy;
-    int h, i, j, k;
-    int oh, oi, oj, ok;
-    int xmh, xph;
-    int xmi, xpi;
-    int xmj, xpj;
-    int xmk, xpk;
+    const struct rtgui_graphic_ext_ops *ext_ops;
+    struct rtgui_point offset;
+    rtgui_rect_t area;
+
+    if ((rx < 0) || (ry < 0)) return;
 
     /*
      * Special case for rx=0 - draw a vline
      */
     if (rx == 0)
     {
-        rtgui_dc_draw_vline(dc, x, y - ry, y + ry);
+        rtgui_dc_draw_vline(dc, x, y - ry, y + ry + 1);
         return;
     }
 
     /* special case for ry=0 - draw a hline  */
     if (ry == 0)
     {
-        rtgui_dc_draw_hline(dc, x - rx, x + rx, y);
+        rtgui_dc_draw_hline(dc, x - rx, x + rx + 1, y);
         return;
     }
 
-    /*
-     * Init vars
-     */
-    oh = oi = oj = ok = 0xFFFF;
-
-    /*
-     * Draw
-     */
-    if (rx > ry)
-    {
-        ix = 0;
-        iy = rx * 64;
-
-        do
-        {
-            h = (ix + 32) >> 6;
-            i = (iy + 32) >> 6;
-            j = (h * ry) / rx;
-            k = (i * ry) / rx;
-
-            if ((ok != k) && (oj != k))
-            {
-                xph = x + h;
-                xmh = x - h;
-                if (k > 0)
-                {
-                    rtgui_dc_draw_hline(dc, xmh, xph, y + k);
-                    rtgui_dc_draw_hline(dc, xmh, xph, y - k);
-                }
-                else
-                {
-                    rtgui_dc_draw_hline(dc, xmh, xph, y);
-                }
-                ok = k;
-            }
-            if ((oj != j) && (ok != j) && (k != j))
-            {
-                xmi = x - i;
-                xpi = x + i;
-                if (j > 0)
-                {
-                    rtgui_dc_draw_hline(dc, xmi, xpi, y + j);
-                    rtgui_dc_draw_hline(dc, xmi, xpi, y - j);
-                }
-                else
-                {
-                    rtgui_dc_draw_hline(dc, xmi, xpi, y);
-                }
-                oj = j;
-            }
-
-            ix = ix + iy / rx;
-            iy = iy - ix / rx;
-
-        }
-        while (i > h);
+    area.x1 = x - rx;
+    area.y1 = y - ry;
+    area.x2 = x + rx;
+    area.y2 = y + ry;
+    ext_ops = _dc_get_ext_ops(dc, &area, &offset);
+    if (ext_ops && ext_ops->fill_ellipse) {
+        _dc_ext_damage(dc, &area, &offset);
+        ext_ops->fill_ellipse(&RTGUI_DC_FC(dc), x + offset.x, y + offset.y,
+            rx, ry);
+        return;
     }
-    else
-    {
-        ix = 0;
-        iy = ry * 64;
-
-        do
-        {
-            h = (ix + 32) >> 6;
-            i = (iy + 32) >> 6;
-            j = (h * rx) / ry;
-            k = (i * rx) / ry;
 
-            if ((oi != i) && (oh != i))
-            {
-                xmj = x - j;
-                xpj = x + j;
-                if (i > 0)
-                {
-                    rtgui_dc_draw_hline(dc, xmj, xpj, y + i);
-                    rtgui_dc_draw_hline(dc, xmj, xpj, y - i);
-                }
-                else
-                {
-                    rtgui_dc_draw_hline(dc, xmj, xpj, y);
-                }
-                oi = i;
-            }
-            if ((oh != h) && (oi != h) && (i != h))
-            {
-                xmk = x - k;
-                xpk = x + k;
-                if (h > 0)
-                {
-                    rtgui_dc_draw_hline(dc, xmk, xpk, y + h);
-                    rtgui_dc_draw_hline(dc, xmk, xpk, y - h);
-                }
-                else
-                {
-                    rtgui_dc_draw_hline(dc, xmk, xpk, y);
-                }
-                oh = h;
-            }
-            ix = ix + iy / ry;
-            iy = iy - ix / ry;
-        }
-        while (i > h);
-    }
+    _dc_draw_oval(dc, x, y, 0, 0, rx, ry, RT_TRUE);
 }
 RTM_EXPORT(rtgui_dc_fill_ellipse);
 
 void rtgui_dc_draw_pie(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_t rad, rt_int16_t start, rt_int16_t end)
 {
-    double angle, start_angle, end_angle;
-    double deltaAngle;
-    double dr;
-    int numpoints, i;
-    int *vx, *vy;
-
     /* Sanity check radii */
     if (rad < 0) return ;
 
-    /*
-     * Fixup angles
-     */
-    start = start % 360;
-    end = end % 360;
-
     /*
      * Special case for rad=0 - draw a point
      */
@@ -1243,218 +1733,118 @@ void rtgui_dc_draw_pie(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_t ra
     }
 
     /*
-     * Variable setup
+     * Fixup angles
      */
-    dr = (double) rad;
-    deltaAngle = 3.0 / dr;
-    start_angle = (double) start * (2.0 * M_PI / 360.0);
-    end_angle = (double) end * (2.0 * M_PI / 360.0);
-    if (start > end)
-    {
-        end_angle += (2.0 * M_PI);
-    }
+    start = start % 360;
+    end = end % 360;
+    if (start < 0) start += 360;
+    if (end < 0) end += 360;
+
+    /* the arc and two radii */
+    rtgui_dc_draw_arc(dc, x, y, rad, start, end);
+    rtgui_dc_draw_line(dc, x, y, x + rtgui_cos_mul(RTGUI_ANGLE(start), rad),
+        y + rtgui_sin_mul(RTGUI_ANGLE(start), rad));
+    rtgui_dc_draw_line(dc, x, y, x + rtgui_cos_mul(RTGUI_ANGLE(end), rad),
+        y + rtgui_sin_mul(RTGUI_ANGLE(end), rad));
+}
+RTM_EXPORT(rtgui_dc_draw_pie);
 
-    /* We will always have at least 2 points */
-    numpoints = 2;
+/* x range on a line of the half plane, [lo, hi] */
+struct rtgui_dc_half {
+    int lo, hi;
+};
 
-    /* Count points (rather than calculating it) */
-    angle = start_angle;
-    while (angle < end_angle)
-    {
-        angle += deltaAngle;
-        numpoints++;
+#define HALF_MIN                    (-0x7fff)
+#define HALF_MAX                    (0x7fff)
+
+/* x range of a * x <= b on a line */
+static void _dc_half_plane(struct rtgui_dc_half *half, rt_int32_t a,
+    rt_int32_t b) {
+    half->lo = HALF_MIN;
+    half->hi = HALF_MAX;
+    if (a > 0) {
+        /* x <= floor(b / a) */
+        half->hi = (b >= 0) ? (b / a) : -((-b + a - 1) / a);
+    } else if (a < 0) {
+        /* x >= ceil(b / a) */
+        a = -a;
+        b = -b;
+        half->lo = (b >= 0) ? ((b + a - 1) / a) : -(-b / a);
+    } else if (b < 0) {
+        half->lo = HALF_MAX;
+        half->hi = HALF_MIN;
     }
+}
 
-    /* Allocate combined vertex array */
-    vx = vy = (int *) rtgui_malloc(2 * sizeof(int) * numpoints);
-    if (vx == RT_NULL) return ;
-
-    /* Update point to start of vy */
-    vy += numpoints;
-
-    /* Center */
-    vx[0] = x;
-    vy[0] = y;
-
-    /* First vertex */
-    angle = start_angle;
-    vx[1] = x + (int)(dr * cos(angle));
-    vy[1] = y + (int)(dr * sin(angle));
-
-    if (numpoints < 3)
-    {
-        rtgui_dc_draw_line(dc, vx[0], vy[0], vx[1], vy[1]);
-    }
-    else
-    {
-        /* Calculate other vertices */
-        i = 2;
-        angle = start_angle;
-        while (angle < end_angle)
-        {
-            angle += deltaAngle;
-            if (angle > end_angle)
-            {
-                angle = end_angle;
-            }
-            vx[i] = x + (int)(dr * cos(angle));
-            vy[i] = y + (int)(dr * sin(angle));
-            i++;
-        }
+/* draw [x1, x2] of line y inside the half ranges */
+static void _dc_sector_span(rtgui_dc_t *dc, int x1, int x2, int y,
+    const struct rtgui_dc_half *half, int num) {
+    int i, lo, hi;
 
-        /* Draw */
-        rtgui_dc_draw_polygon(dc, vx, vy, numpoints);
+    for (i = 0; i < num; i++) {
+        lo = _MAX(x1, half[i].lo);
+        hi = _MIN(x2, half[i].hi);
+        if (lo <= hi) rtgui_dc_draw_hline(dc, lo, hi + 1, y);
     }
-
-    /* Free combined vertex array */
-    rtgui_free(vx);
-    return;
-}
-RTM_EXPORT(rtgui_dc_draw_pie);
-
-/*
- * Octant labelling
- *
- *  \ 5 | 6 /
- *   \  |  /
- *  4 \ | / 7
- *     \|/
- *------+------ +x
- *     /|\
- *  3 / | \ 0
- *   /  |  \
- *  / 2 | 1 \
- *      +y
- */
-static void _draw_octant(rtgui_dc_t *dc,
-                         rt_int16_t ox, rt_int16_t oy,
-                         rt_int16_t y1, rt_int16_t y2, rt_int16_t x, int oct)
-{
-    switch (oct % 8)
-    {
-    case 0:
-        rtgui_dc_draw_line(dc, ox +  x, oy + y1, ox +  x, oy + y2);
-        break;
-    case 1:
-        /* Ugly hack to get the edge right. */
-        y2 += 1;
-        y1 += 1;
-        x -= 1;
-        rtgui_dc_draw_line(dc, ox + y1, oy +  x, ox + y2, oy +  x);
-        break;
-    case 2:
-        y2 -= 1;
-        y1 -= 1;
-        x -= 1;
-        rtgui_dc_draw_line(dc, ox - y2, oy +  x, ox - y1, oy +  x);
-        break;
-    case 3:
-        x -= 1;
-        rtgui_dc_draw_line(dc, ox -  x, oy + y1, ox -  x, oy + y2);
-        break;
-    case 4:
-        x -= 1;
-        rtgui_dc_draw_line(dc, ox -  x, oy - y2, ox -  x, oy - y1);
-        break;
-    case 5:
-        y2 -= 1;
-        y1 -= 1;
-        rtgui_dc_draw_line(dc, ox - y2, oy -  x, ox - y1, oy -  x);
-        break;
-    case 6:
-        y2 += 1;
-        y1 += 1;
-        rtgui_dc_draw_line(dc, ox + y1, oy -  x, ox + y2, oy -  x);
-        break;
-    case 7:
-        rtgui_dc_draw_line(dc, ox +  x, oy - y2, ox +  x, oy - y1);
-        break;
-    };
 }
 
-static void _fill_small_pie(rtgui_dc_t *dc,
-                            rt_int16_t ox, rt_int16_t oy,
-                            rt_int16_t rad, rt_int16_t start, rt_int16_t end,
-                            int oct)
-{
-    /* Midpoint circle algorithm. */
-    int dk, x, y;
-    /* Start X, end X, */
-    rt_int16_t sx, ex, ty = 0, my;
-    enum {ST_NONE, ST_ARC, ST_TRI} st;
-
-    RT_ASSERT(0 <= start && start <= 45);
-    RT_ASSERT(0 <= end && end <= 45);
-    if (start == end)
-        return;
-    RT_ASSERT(start < end);
-    RT_ASSERT(rad > 0);
-
-    /* cos(90 - start) == sin(start) */
-    sx = rad * sin(start * M_PI / 180);
-    ex = rad * sin(end * M_PI / 180);
-
-    dk = 1 - rad;
-    x = 0;
-    y = rad;
-
-    st = ST_NONE;
-    my = ex;
-    while (x <= y)
-    {
-        rt_int16_t lx;
-
-        if (x < sx)
-        {
-        }
-        else if (x == sx)
-        {
-            /* Start point. */
-            st = ST_ARC;
-            ty = y;
-        }
-        else if (x <= ex)
-        {
-            /* Between the pie. */
-            RT_ASSERT(st == ST_ARC);
-        }
-        else /* x > ex */
-        {
-            /* End. */
-            st = ST_TRI;
-            my = y;
-            break;
-        }
-
-        /* Drawing. */
-        if (st == ST_ARC)
-        {
-            lx = y * sx / ty;
-            /* Change from math coordinate to plot coordinate. */
-            _draw_octant(dc, ox, oy, lx, x, y, oct);
+/* fill the ring sector between radius r1 and r2, from start to end (in
+   degree, clockwise on screen), by spans */
+static void _dc_fill_sector(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y,
+    rt_int16_t r1, rt_int16_t r2, rt_int16_t start, rt_int16_t end) {
+    struct rtgui_dc_half half[2];
+    rt_int32_t cs, ss, ce, se;
+    rt_int32_t outer, inner;
+    int sweep, num, dy, xo, xi;
+
+    sweep = end - start;
+    if (sweep >= 360) {
+        sweep = 360;
+    } else {
+        sweep %= 360;
+        if (sweep < 0) sweep += 360;
+        if (!sweep) return;
+    }
+    cs = rtgui_cos(RTGUI_ANGLE(start));
+    ss = rtgui_sin(RTGUI_ANGLE(start));
+    ce = rtgui_cos(RTGUI_ANGLE(end));
+    se = rtgui_sin(RTGUI_ANGLE(end));
+
+    outer = r2 * r2 + r2;
+    inner = (r1 > 0) ? ((r1 - 1) * (r1 - 1) + (r1 - 1)) : -1;
+
+    for (dy = -r2; dy <= r2; dy++) {
+        /* the pixels with r1 - 0.5 < distance <= r2 + 0.5 */
+        xo = (int)rtgui_isqrt(outer - dy * dy);
+        xi = ((inner - dy * dy) >= 0) ? (int)rtgui_isqrt(inner - dy * dy) : -1;
+
+        /* after start: cs * dy - ss * x >= 0, before end: se * x - ce * dy
+           >= 0; the sector is both within half turn, otherwise either */
+        num = 1;
+        if (sweep < 360) {
+            _dc_half_plane(&half[0], ss, cs * dy);
+            _dc_half_plane(&half[1], -se, -ce * dy);
+            if (sweep <= 180) {
+                half[0].lo = _MAX(half[0].lo, half[1].lo);
+                half[0].hi = _MIN(half[0].hi, half[1].hi);
+            } else if ((half[1].lo > half[0].hi) || \
+                       (half[0].lo > half[1].hi)) {
+                num = 2;
+            } else {
+                half[0].lo = _MIN(half[0].lo, half[1].lo);
+                half[0].hi = _MAX(half[0].hi, half[1].hi);
+            }
+        } else {
+            half[0].lo = HALF_MIN;
+            half[0].hi = HALF_MAX;
         }
 
-        /* Midpoint increment. */
-        if (dk > 0)
-        {
-            y--;
-            dk += 2 * (x - y) + 5;
-        }
-        else
-        {
-            dk += 2 * x + 3;
+        if (xi < 0) {
+            _dc_sector_span(dc, x - xo, x + xo, y + dy, half, num);
+        } else {
+            _dc_sector_span(dc, x - xo, x - xi - 1, y + dy, half, num);
+            _dc_sector_span(dc, x + xi + 1, x + xo, y + dy, half, num);
         }
-        x++;
-    }
-    /* Draw bottom part. */
-    for (; y >= 0; y--)
-    {
-        rt_int16_t lx, rx;
-
-        lx = y * sx / ty;
-        rx = y * ex / my;
-
-        _draw_octant(dc, ox, oy, lx, rx, y, oct);
     }
 }
 
@@ -1479,53 +1869,23 @@ void rtgui_dc_fill_pie(rtgui_dc_t *dc,
     if (start == end)
         return;
 
-    /*
-     * Fixup angles
-     */
-    while (start < 0)
-    {
-        start += 360;
-        end   += 360;
-    }
-    while (start >= 360)
-    {
-        start -= 360;
-        end   -= 360;
-    }
-
-    if (end < start)
-        end += 360;
+    _dc_fill_sector(dc, x, y, 0, rad, start, end);
+}
+RTM_EXPORT(rtgui_dc_fill_pie);
 
-    while (start / 45 != end / 45)
-    {
-        /* The start and end are not in the same piece. */
-        if ((start / 45) % 2)
-        {
-            _fill_small_pie(dc, x, y, rad,
-                            0, 45 - start % 45, start / 45);
-            start += 45 - start % 45;
-        }
-        else
-        {
-            _fill_small_pie(dc, x, y, rad,
-                            start % 45, 45, start / 45);
-            start += 45 - start % 45;
-        }
-    }
-    if ((start / 45) % 2)
-    {
-        _fill_small_pie(dc, x, y, rad,
-                        90 - end % 90, 90 - start % 90, start / 45);
-    }
-    else
-    {
-        _fill_small_pie(dc, x, y, rad,
-                        start % 45, end % 45, start / 45);
+void rtgui_dc_fill_annulus(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y,
+    rt_int16_t r1, rt_int16_t r2, rt_int16_t start, rt_int16_t end) {
+    if ((r1 < 0) || (r2 < 0)) return;
+    if (r1 > r2) {
+        rt_int16_t tmp = r1;
+        r1 = r2;
+        r2 = tmp;
     }
+    if (start == end) return;
 
-    return;
+    _dc_fill_sector(dc, x, y, r1, r2, start, end);
 }
-RTM_EXPORT(rtgui_dc_fill_pie);
+RTM_EXPORT(rtgui_dc_fill_annulus);
 
 /*
  * set gc of dc
@@ -1553,6 +1913,14 @@ void rtgui_dc_set_gc(rtgui_dc_t *dc, rtgui_gc_t *gc) {
         break;
     }
 
+    case RTGUI_DC_BUFFER:
+        ((struct rtgui_dc_buffer *)dc)->gc = *gc;
+        break;
+
+    case RTGUI_DC_RECORD:
+        rtgui_dc_set_gc(((struct rtgui_dc_record *)dc)->dc, gc);
+        break;
+
     default:
         LOG_E("bad dc type %d", dc->type);
         break;
@@ -1587,6 +1955,14 @@ rtgui_gc_t *rtgui_dc_get_gc(rtgui_dc_t *dc) {
         break;
     }
 
+    case RTGUI_DC_BUFFER:
+        gc = &((struct rtgui_dc_buffer *)dc)->gc;
+        break;
+
+    case RTGUI_DC_RECORD:
+        gc = rtgui_dc_get_gc(((struct rtgui_dc_record *)dc)->dc);
+        break;
+
     default:
         LOG_E("bad dc type %d", dc->type);
         break;
@@ -1608,6 +1984,12 @@ rt_bool_t rtgui_dc_get_visible(rtgui_dc_t *dc) {
     case RTGUI_DC_HW:
         return IS_WIDGET_FLAG(((struct rtgui_dc_hw *)dc)->owner, DC_VISIBLE);
 
+    case RTGUI_DC_BUFFER:
+        return RT_TRUE;
+
+    case RTGUI_DC_RECORD:
+        return rtgui_dc_get_visible(((struct rtgui_dc_record *)dc)->dc);
+
     default:
         LOG_E("bad dc type %d", dc->type);
         return RT_TRUE;
@@ -1652,6 +2034,18 @@ void rtgui_dc_get_rect(rtgui_dc_t *dc, rtgui_rect_t *rect) {
         break;
     }
 
+    case RTGUI_DC_BUFFER:
+    {
+        struct rtgui_dc_buffer *dc_buf = (struct rtgui_dc_buffer *)dc;
+
+        rtgui_rect_init(rect, 0, 0, dc_buf->width, dc_buf->height);
+        break;
+    }
+
+    case RTGUI_DC_RECORD:
+        rtgui_dc_get_rect(((struct rtgui_dc_record *)dc)->dc, rect);
+        break;
+
     default:
         LOG_E("bad dc type %d", dc->type);
         break;
@@ -1668,6 +2062,7 @@ rt_uint8_t rtgui_dc_get_pixel_format(rtgui_dc_t *dc) {
     switch (dc->type) {
     case RTGUI_DC_CLIENT:
     case RTGUI_DC_HW:
+    case RTGUI_DC_RECORD:
     {
         rtgui_gfx_driver_t *hw_driver;
 
@@ -1676,6 +2071,10 @@ rt_uint8_t rtgui_dc_get_pixel_format(rtgui_dc_t *dc) {
         break;
     }
 
+    case RTGUI_DC_BUFFER:
+        pixel_fmt = ((struct rtgui_dc_buffer *)dc)->pixel_format;
+        break;
+
     default:
         LOG_E("bad dc type %d", dc->type);
         RT_ASSERT(0);
@@ -1710,6 +2109,14 @@ void rtgui_dc_logic_to_device(rtgui_dc_t *dc, struct rtgui_point *point) {
         break;
     }
 
+    case RTGUI_DC_BUFFER:
+        /* logic is device */
+        break;
+
+    case RTGUI_DC_RECORD:
+        rtgui_dc_logic_to_device(((struct rtgui_dc_record *)dc)->dc, point);
+        break;
+
     default:
         LOG_E("bad dc type %d", dc->type);
         break;
@@ -1740,6 +2147,14 @@ void rtgui_dc_rect_to_device(rtgui_dc_t *dc, rtgui_rect_t *rect) {
         break;
     }
 
+    case RTGUI_DC_BUFFER:
+        /* logic is device */
+        break;
+
+    case RTGUI_DC_RECORD:
+        rtgui_dc_rect_to_device(((struct rtgui_dc_record *)dc)->dc, rect);
+        break;
+
     default:
         LOG_E("bad dc type %d", dc->type);
         break;
@@ -1747,10 +2162,271 @@ void rtgui_dc_rect_to_device(rtgui_dc_t *dc, rtgui_rect_t *rect) {
 }
 RTM_EXPORT(rtgui_dc_rect_to_device);
 
+/*
+ * add device area (x2, y2 not included) to the toplevel damage, clipped by
+ * owner
+ */
+void rtgui_dc_damage(rtgui_widget_t *owner, int x1, int y1, int x2, int y2) {
+    rtgui_rect_t *clip, *damage;
+
+    if (!owner || !owner->toplevel) return;
+    clip = &(owner->clip.extents);
+    x1 = _MAX(x1, clip->x1);
+    y1 = _MAX(y1, clip->y1);
+    x2 = _MIN(x2, clip->x2);
+    y2 = _MIN(y2, clip->y2);
+    if ((x1 >= x2) || (y1 >= y2)) return;
+
+    damage = &(owner->toplevel->drawing_rect);
+    if ((damage->x1 >= damage->x2) || (damage->y1 >= damage->y2)) {
+        damage->x1 = x1;
+        damage->y1 = y1;
+        damage->x2 = x2;
+        damage->y2 = y2;
+        return;
+    }
+    if (x1 < damage->x1) damage->x1 = x1;
+    if (y1 < damage->y1) damage->y1 = y1;
+    if (x2 > damage->x2) damage->x2 = x2;
+    if (y2 > damage->y2) damage->y2 = y2;
+}
+RTM_EXPORT(rtgui_dc_damage);
+
+/*
+ * copy screen pixels at device point to rect of dst, lines are clipped by dst
+ */
+void rtgui_dc_blit_screen(struct rtgui_point *point, rtgui_dc_t *dst,
+    rtgui_rect_t *rect) {
+    rtgui_gfx_driver_t *drv = rtgui_get_gfx_device();
+    rt_uint8_t *line;
+    rtgui_rect_t area;
+    int w, h, y;
+
+    if (!point || !dst || !rect) return;
+    if ((point->x < 0) || (point->y < 0)) return;
+    w = _MIN(rect->x2 - rect->x1, drv->width - point->x);
+    h = _MIN(rect->y2 - rect->y1, drv->height - point->y);
+    if ((w <= 0) || (h <= 0)) return;
+
+    line = rtgui_malloc(_BIT2BYTE(w * drv->bits_per_pixel));
+    if (!line) {
+        LOG_E("no mem for line");
+        return;
+    }
+    for (y = 0; y < h; y++) {
+        rtgui_rect_init(&area, point->x, point->y + y, w, 1);
+        if (RT_EOK != rtgui_gfx_read_rect(drv, &area, line, 0)) break;
+        dst->engine->blit_line(dst, rect->x1, rect->x1 + w, rect->y1 + y,
+            line);
+    }
+    rtgui_free(line);
+}
+RTM_EXPORT(rtgui_dc_blit_screen);
+
+/*
+ * read pixels of dc under (x1, x2) of line y, for blending, pixels out of dc
+ * or screen are left unchanged
+ */
+rt_err_t rtgui_dc_read_line(rtgui_dc_t *dc, int x1, int x2, int y,
+    rt_uint8_t *line) {
+    rtgui_gfx_driver_t *drv = rtgui_get_gfx_device();
+    rtgui_rect_t rect;
+    rt_uint8_t bpp;
+
+    if (!dc || !line || (x1 >= x2)) return -RT_EINVAL;
+    if (RTGUI_DC_RECORD == dc->type)
+        dc = ((struct rtgui_dc_record *)dc)->dc;
+
+    if (RTGUI_DC_BUFFER == dc->type) {
+        struct rtgui_dc_buffer *buf = (struct rtgui_dc_buffer *)dc;
+
+        if ((y < 0) || (y >= buf->height)) return -RT_EINVAL;
+        if (x1 < 0) {
+            line -= x1 * buf->bpp;
+            x1 = 0;
+        }
+        if (x2 > buf->width) x2 = buf->width;
+        if (x1 >= x2) return -RT_EINVAL;
+        rt_memcpy(line, buf->pixel + buf->pitch * y + buf->bpp * x1,
+            (x2 - x1) * buf->bpp);
+        return RT_EOK;
+    }
+
+    if (drv->bits_per_pixel < 8) return -RT_ENOSYS;
+    bpp = _BIT2BYTE(drv->bits_per_pixel);
+    rect.x1 = x1;
+    rect.y1 = y;
+    rect.x2 = x2;
+    rect.y2 = y + 1;
+    rtgui_dc_rect_to_device(dc, &rect);
+    if (rect.x1 < 0) {
+        line -= rect.x1 * bpp;
+        rect.x1 = 0;
+    }
+    if (rect.x2 > drv->width) rect.x2 = drv->width;
+    return rtgui_gfx_read_rect(drv, &rect, line, 0);
+}
+RTM_EXPORT(rtgui_dc_read_line);
+
+/* memmove rect of buffer dc moved by (-dx, -dy) to rect */
+static void _dc_buffer_copy_rect(struct rtgui_dc_buffer *buf,
+    rtgui_rect_t *rect, int dx, int dy) {
+    rt_uint32_t len = (rect->x2 - rect->x1) * buf->bpp;
+    rt_int32_t offset = buf->pitch * dy + buf->bpp * dx;
+    rt_int32_t pitch = buf->pitch;
+    rt_uint8_t *ptr;
+    int y;
+
+    /* walk rows away from the source, memmove handles the row itself */
+    ptr = buf->pixel + buf->bpp * rect->x1;
+    if (dy > 0) {
+        ptr += buf->pitch * (rect->y2 - 1);
+        pitch = -pitch;
+    } else {
+        ptr += buf->pitch * rect->y1;
+    }
+    for (y = rect->y1; y < rect->y2; y++, ptr += pitch)
+        rt_memmove(ptr, ptr - offset, len);
+}
+
+/* copy num rects of a band, right most first if moving right */
+static rt_err_t _dc_copy_band(struct rtgui_dc_buffer *buf,
+    rtgui_rect_t *rects, int num, int dx, int dy) {
+    rtgui_rect_t *rect;
+    rt_err_t err = RT_EOK;
+    int idx;
+
+    for (idx = 0; (RT_EOK == err) && (idx < num); idx++) {
+        rect = (dx > 0) ? &rects[num - 1 - idx] : &rects[idx];
+        if (buf)
+            _dc_buffer_copy_rect(buf, rect, dx, dy);
+        else
+            err = rtgui_gfx_copy_rect(rtgui_get_gfx_device(), rect, dx, dy);
+    }
+    return err;
+}
+
+/*
+ * copy pixels of rect (x2, y2 not included) to rect moved by (dx, dy), for
+ * scrolling, only pixels with both source and destination in dc are copied
+ * - exposed (optional, initialized region) gets the area of rect and moved
+ *   rect which needs repainting, in logic coordinate
+ */
+rt_err_t rtgui_dc_copy_area(rtgui_dc_t *dc, rtgui_rect_t *rect, int dx,
+    int dy, rtgui_region_t *exposed) {
+    struct rtgui_dc_buffer *buf = RT_NULL;
+    rtgui_widget_t *owner = RT_NULL;
+    rtgui_region_t clip, moved, copy;
+    rtgui_rect_t src, dst, area, *rects;
+    struct rtgui_point offset;
+    rt_bool_t copied = RT_FALSE;
+    int num, start, end;
+    rt_err_t err = RT_EOK;
+
+    if (!dc || !rect) return -RT_EINVAL;
+    if (RTGUI_DC_RECORD == dc->type) {
+        /* copy is not recorded */
+        rtgui_dc_list_dirty(((struct rtgui_dc_record *)dc)->owner);
+        dc = ((struct rtgui_dc_record *)dc)->dc;
+    }
+    if (RTGUI_DC_BUFFER == dc->type)
+        buf = (struct rtgui_dc_buffer *)dc;
+    else if (RTGUI_DC_CLIENT == dc->type)
+        owner = rt_container_of(dc, rtgui_widget_t, dc_type);
+    else if (RTGUI_DC_HW == dc->type)
+        owner = ((struct rtgui_dc_hw *)dc)->owner;
+    else
+        return -RT_EINVAL;
+
+    /* in device coordinate */
+    offset.x = 0;
+    offset.y = 0;
+    rtgui_dc_logic_to_device(dc, &offset);
+    src = *rect;
+    rtgui_rect_move(&src, offset.x, offset.y);
+    dst = src;
+    rtgui_rect_move(&dst, dx, dy);
+    rtgui_region_init_empty(&clip);
+    rtgui_region_init_empty(&moved);
+    rtgui_region_init_empty(&copy);
+
+    do {
+        if (RTGUI_DC_CLIENT == dc->type) {
+            if (!rtgui_dc_get_visible(dc)) break;
+            if (SUCCESS != rtgui_region_copy(&clip, &(owner->clip))) {
+                err = -RT_ENOMEM;
+                break;
+            }
+        } else {
+            rtgui_dc_get_rect(dc, &area);
+            rtgui_rect_move(&area, offset.x, offset.y);
+            rtgui_region_reset(&clip, &area);
+        }
+
+        /* both source and destination are visible */
+        if (SUCCESS != rtgui_region_copy(&moved, &clip)) {
+            err = -RT_ENOMEM;
+            break;
+        }
+        rtgui_region_translate(&moved, dx, dy);
+        if ((SUCCESS != rtgui_region_intersect_rect(&copy, &clip, &dst)) || \
+            (SUCCESS != rtgui_region_intersect(&copy, &copy, &moved))) {
+            err = -RT_ENOMEM;
+            break;
+        }
+
+        /* walk bands away from the source, that no source is overwritten
+           before copied */
+        rects = rtgui_region_rects(&copy);
+        num = rtgui_region_num_rects(&copy);
+        if (dy > 0) {
+            for (end = num; (RT_EOK == err) && (end > 0); end = start) {
+                for (start = end - 1; (start > 0) && \
+                     (rects[start - 1].y1 == rects[end - 1].y1); start--);
+                err = _dc_copy_band(buf, &rects[start], end - start, dx, dy);
+            }
+        } else {
+            for (start = 0; (RT_EOK == err) && (start < num); start = end) {
+                for (end = start + 1; (end < num) && \
+                     (rects[end].y1 == rects[start].y1); end++);
+                err = _dc_copy_band(buf, &rects[start], end - start, dx, dy);
+            }
+        }
+        copied = (RT_EOK == err);
+        if (copied && owner) {
+            rtgui_rect_t *ext = rtgui_region_extents(&copy);
+
+            rtgui_dc_damage(owner, ext->x1, ext->y1, ext->x2, ext->y2);
+        }
+    } while (0);
+
+    if (exposed) {
+        /* repaint all on error */
+        rtgui_region_reset(exposed, &src);
+        if ((SUCCESS != rtgui_region_union_rect(exposed, exposed, &dst)) || \
+            ((-RT_ENOMEM != err) && \
+             (SUCCESS != rtgui_region_intersect(exposed, exposed, &clip))) || \
+            (copied && \
+             (SUCCESS != rtgui_region_subtract(exposed, exposed, &copy)))) {
+            rtgui_rect_union(&src, &dst);
+            rtgui_region_reset(exposed, &dst);
+            err = -RT_ENOMEM;
+        }
+        rtgui_region_translate(exposed, -offset.x, -offset.y);
+    }
+
+    rtgui_region_uninit(&copy);
+    rtgui_region_uninit(&moved);
+    rtgui_region_uninit(&clip);
+    return err;
+}
+RTM_EXPORT(rtgui_dc_copy_area);
+
 #ifdef RTGUI_USING_CURSOR
     extern struct rt_mutex cursor_lock;
     extern void rtgui_cursor_show(void);
     extern void rtgui_cursor_hide(void);
+    extern rt_bool_t rtgui_mouse_is_intersect(rtgui_rect_t *rect);
 #endif
 
 rtgui_dc_t *rtgui_dc_begin_drawing(rtgui_widget_t *owner) {
@@ -1787,6 +2463,12 @@ rtgui_dc_t *rtgui_dc_begin_drawing(rtgui_widget_t *owner) {
 
         rtgui_screen_lock(RT_WAITING_FOREVER);
 
+        /* not to draw on pixels being updated to device */
+        if (rtgui_get_gfx_device()->framebuffer && \
+            (rtgui_get_gfx_device()->scanout == \
+             rtgui_get_gfx_device()->framebuffer))
+            rtgui_gfx_fence_screen(rtgui_get_gfx_device(), &(owner->extent));
+
         /* create client or hardware dc */
         if (rtgui_region_is_flat(&owner->clip) && \
             rtgui_rect_is_equal(&(owner->extent), &(owner->clip.extents))) {
@@ -1812,6 +2494,21 @@ rtgui_dc_t *rtgui_dc_begin_drawing(rtgui_widget_t *owner) {
             if (!IS_TITLE(win)) {
                 rtgui_evt_generic_t *evt;
 
+            #ifdef RTGUI_USING_DIRECT_DRAWING
+                /* cursor is kept away by the lock until end of drawing, the
+                   area is the clip of owner as drawing_rect is still empty */
+                #ifdef RTGUI_USING_CURSOR
+                    rt_mutex_take(&cursor_lock, RT_WAITING_FOREVER);
+                    if (rtgui_mouse_is_intersect(&(owner->clip.extents)))
+                        rt_mutex_release(&cursor_lock);
+                    else
+                #endif
+                {
+                    WIN_FLAG_SET(win, DIRECT);
+                    break;
+                }
+            #endif
+
                 /* send RTGUI_EVENT_UPDATE_BEGIN */
                 RTGUI_CREATE_EVENT(evt, UPDATE_BEGIN, RT_WAITING_FOREVER);
                 if (!evt) break;
@@ -1828,12 +2525,18 @@ rtgui_dc_t *rtgui_dc_begin_drawing(rtgui_widget_t *owner) {
         }
     } while (0);
 
+#ifdef RTGUI_USING_DISPLAY_LIST
+    dc = rtgui_dc_record_begin(owner, dc);
+#endif
     return dc;
 }
 RTM_EXPORT(rtgui_dc_begin_drawing);
 
 void rtgui_dc_end_drawing(rtgui_dc_t *dc, rt_bool_t update) {
     RT_ASSERT(dc != RT_NULL);
+#ifdef RTGUI_USING_DISPLAY_LIST
+    if (dc->type == RTGUI_DC_RECORD) dc = rtgui_dc_record_end(dc);
+#endif
 
     do {
         rtgui_widget_t *owner;
@@ -1848,13 +2551,28 @@ void rtgui_dc_end_drawing(rtgui_dc_t *dc, rt_bool_t update) {
             break;  /* bad DC type */
 
         win = owner->toplevel;
-        /* union drawing rect */
-        rtgui_rect_union(&(owner->extent_visiable), &(win->drawing_rect));
         /* decrease drawing counter */
         win->drawing--;
         LOG_D("<-draw cnt %d", win->drawing);
 
         if (win->drawing != 0) break;
+
+    #ifdef RTGUI_USING_DIRECT_DRAWING
+        if (IS_WIN_FLAG(win, DIRECT)) {
+            WIN_FLAG_CLEAR(win, DIRECT);
+            #ifdef RTGUI_USING_CURSOR
+                rt_mutex_release(&cursor_lock);
+            #endif
+            if (win->update || !update) break;
+
+            /* app loop commits when no more pending event */
+            rtgui_gfx_damage_screen(rtgui_get_gfx_device(),
+                &(win->drawing_rect));
+            if (!rtgui_app_self())
+                rtgui_gfx_commit_screen(rtgui_get_gfx_device());
+            break;
+        }
+    #endif
         if (win->update || !update) break;
 
         if (!IS_TITLE(win)) {
@@ -1863,7 +2581,7 @@ void rtgui_dc_end_drawing(rtgui_dc_t *dc, rt_bool_t update) {
             /* send RTGUI_EVENT_UPDATE_END */
             RTGUI_CREATE_EVENT(evt, UPDATE_END, RT_WAITING_FOREVER);
             if (!evt) break;
-            evt->update_end.rect = owner->extent;  // win->drawing_rect?
+            evt->update_end.rect = win->drawing_rect;
             (void)rtgui_send_request(evt, RT_WAITING_FOREVER);
         } else {
             #ifdef RTGUI_USING_CURSOR
@@ -1874,8 +2592,9 @@ void rtgui_dc_end_drawing(rtgui_dc_t *dc, rt_bool_t update) {
             #endif
 
             /* update screen */
-            rtgui_gfx_update_screen(rtgui_get_gfx_device(),
-                &(owner->extent));
+            rtgui_gfx_damage_screen(rtgui_get_gfx_device(),
+                &(win->drawing_rect));
+            rtgui_gfx_commit_screen(rtgui_get_gfx_device());
         }
     } while (0);
 
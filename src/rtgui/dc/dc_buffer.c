@@ -0,0 +1,276 @@
+/*
+ * File      : dc_buffer.c
+ * This file is part of RT-Thread GUI Engine
+ * COPYRIGHT (C) 2006 - 2017, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2010-04-10     Bernard      first version
+ * 2019-07-08     onelife      reimplement in display pixel format
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "include/rtgui.h"
+#include "include/font/font.h"
+
+#ifdef RT_USING_ULOG
+# define LOG_LVL                    RTGUI_LOG_LEVEL
+# define LOG_TAG                    " DC_BUF"
+# include "components/utilities/ulog/ulog.h"
+#else /* RT_USING_ULOG */
+# define LOG_E(format, args...)     rt_kprintf(format "\n", ##args)
+# define LOG_D                      LOG_E
+#endif /* RT_USING_ULOG */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define display()                           (rtgui_get_gfx_device())
+#define BUFFER_PIXEL(buf, x, y)             ((buf)->pixel + \
+                                            (buf)->pitch * (y) + \
+                                            (buf)->bpp * (x))
+#define _int_swap(x, y)                     \
+    do {                                    \
+        x ^= y;                             \
+        y ^= x;                             \
+        x ^= y;                             \
+    } while (0)
+
+/* Private function prototypes -----------------------------------------------*/
+static void _dc_buffer_draw_point(rtgui_dc_t *dc, int x, int y);
+static void _dc_buffer_draw_color_point(rtgui_dc_t *dc, int x, int y,
+    rtgui_color_t color);
+static void _dc_buffer_draw_hline(rtgui_dc_t *dc, int x1, int x2, int y);
+static void _dc_buffer_draw_vline(rtgui_dc_t *dc, int x, int y1, int y2);
+static void _dc_buffer_fill_rect(rtgui_dc_t *dc, rtgui_rect_t *rect);
+static void _dc_buffer_blit_line(rtgui_dc_t *self, int x1, int x2, int y,
+    rt_uint8_t *line_data);
+static void _dc_buffer_blit(rtgui_dc_t *dc, struct rtgui_point *dc_point,
+    rtgui_dc_t *dest, rtgui_rect_t *rect);
+static rt_bool_t _dc_buffer_fini(rtgui_dc_t *dc);
+
+/* Private variables ---------------------------------------------------------*/
+const rtgui_dc_engine_t dc_buffer_engine = {
+    _dc_buffer_draw_point,
+    _dc_buffer_draw_color_point,
+    _dc_buffer_draw_vline,
+    _dc_buffer_draw_hline,
+    _dc_buffer_fill_rect,
+    _dc_buffer_blit_line,
+    _dc_buffer_blit,
+    _dc_buffer_fini,
+};
+
+/* Private functions ---------------------------------------------------------*/
+/* store num pixels of raw color */
+static void _dc_buffer_fill(struct rtgui_dc_buffer *dc, rt_uint8_t *ptr,
+    rtgui_color_t pixel, int num) {
+    switch (dc->bpp) {
+    case 2:
+    {
+        rt_uint16_t *ptr16 = (rt_uint16_t *)ptr;
+
+        while (num-- > 0)
+            *ptr16++ = (rt_uint16_t)pixel;
+        break;
+    }
+
+    case 3:
+        while (num-- > 0) {
+            *ptr++ = pixel & 0xff;
+            *ptr++ = (pixel >> 8) & 0xff;
+            *ptr++ = (pixel >> 16) & 0xff;
+        }
+        break;
+
+    default:
+    {
+        rt_uint32_t *ptr32 = (rt_uint32_t *)ptr;
+
+        while (num-- > 0)
+            *ptr32++ = (rt_uint32_t)pixel;
+        break;
+    }
+    }
+}
+
+static void _dc_buffer_draw_point(rtgui_dc_t *self, int x, int y) {
+    struct rtgui_dc_buffer *dc = (struct rtgui_dc_buffer *)self;
+
+    _dc_buffer_draw_color_point(self, x, y, dc->gc.foreground);
+}
+
+static void _dc_buffer_draw_color_point(rtgui_dc_t *self, int x, int y,
+    rtgui_color_t color) {
+    struct rtgui_dc_buffer *dc = (struct rtgui_dc_buffer *)self;
+
+    if ((x < 0) || (x >= dc->width) || (y < 0) || (y >= dc->height)) return;
+    if (!color) color = dc->gc.foreground;
+    _dc_buffer_fill(dc, BUFFER_PIXEL(dc, x, y), rtgui_gfx_raw_color(color), 1);
+}
+
+static void _dc_buffer_draw_vline(rtgui_dc_t *self, int x, int y1, int y2) {
+    struct rtgui_dc_buffer *dc = (struct rtgui_dc_buffer *)self;
+    rtgui_color_t pixel;
+    rt_uint8_t *ptr;
+
+    if ((x < 0) || (x >= dc->width)) return;
+    if (y1 > y2) _int_swap(y1, y2);
+    if (y1 < 0) y1 = 0;
+    if (y2 > dc->height) y2 = dc->height;
+    if (y1 >= y2) return;
+
+    pixel = rtgui_gfx_raw_color(dc->gc.foreground);
+    for (ptr = BUFFER_PIXEL(dc, x, y1); y1 < y2; y1++, ptr += dc->pitch)
+        _dc_buffer_fill(dc, ptr, pixel, 1);
+}
+
+static void _dc_buffer_draw_hline(rtgui_dc_t *self, int x1, int x2, int y) {
+    struct rtgui_dc_buffer *dc = (struct rtgui_dc_buffer *)self;
+
+    if ((y < 0) || (y >= dc->height)) return;
+    if (x1 > x2) _int_swap(x1, x2);
+    if (x1 < 0) x1 = 0;
+    if (x2 > dc->width) x2 = dc->width;
+    if (x1 >= x2) return;
+
+    _dc_buffer_fill(dc, BUFFER_PIXEL(dc, x1, y),
+        rtgui_gfx_raw_color(dc->gc.foreground), x2 - x1);
+}
+
+static void _dc_buffer_fill_rect(rtgui_dc_t *self, rtgui_rect_t *rect) {
+    struct rtgui_dc_buffer *dc = (struct rtgui_dc_buffer *)self;
+    rtgui_color_t pixel;
+    rtgui_rect_t area;
+    rt_uint8_t *ptr;
+    int y;
+
+    area.x1 = _MAX(rect->x1, 0);
+    area.y1 = _MAX(rect->y1, 0);
+    area.x2 = _MIN(rect->x2, dc->width);
+    area.y2 = _MIN(rect->y2, dc->height);
+    if ((area.x1 >= area.x2) || (area.y1 >= area.y2)) return;
+
+    pixel = rtgui_gfx_raw_color(dc->gc.background);
+    ptr = BUFFER_PIXEL(dc, area.x1, area.y1);
+    for (y = area.y1; y < area.y2; y++, ptr += dc->pitch)
+        _dc_buffer_fill(dc, ptr, pixel, area.x2 - area.x1);
+}
+
+static void _dc_buffer_blit_line(rtgui_dc_t *self, int x1, int x2, int y,
+    rt_uint8_t *line_data) {
+    struct rtgui_dc_buffer *dc = (struct rtgui_dc_buffer *)self;
+
+    if ((y < 0) || (y >= dc->height)) return;
+    if (x1 > x2) _int_swap(x1, x2);
+    if (x1 < 0) {
+        line_data -= x1 * dc->bpp;
+        x1 = 0;
+    }
+    if (x2 > dc->width) x2 = dc->width;
+    if (x1 >= x2) return;
+
+    rt_memcpy(BUFFER_PIXEL(dc, x1, y), line_data, (x2 - x1) * dc->bpp);
+}
+
+/* copy (dc_point) of buffer to rect of dest, lines are clipped by dest */
+static void _dc_buffer_blit(rtgui_dc_t *self, struct rtgui_point *dc_point,
+    rtgui_dc_t *dest, rtgui_rect_t *rect) {
+    struct rtgui_dc_buffer *dc = (struct rtgui_dc_buffer *)self;
+    rt_uint8_t *ptr;
+    int sx, sy, w, h, y;
+
+    if (!dest || !rect) return;
+    if ((RTGUI_DC_BUFFER != dest->type) && !rtgui_dc_get_visible(dest))
+        return;
+    if (rtgui_dc_get_pixel_format(dest) != dc->pixel_format) {
+        LOG_E("bad pixel format");
+        return;
+    }
+
+    sx = dc_point ? dc_point->x : 0;
+    sy = dc_point ? dc_point->y : 0;
+    if ((sx < 0) || (sy < 0) || (sx >= dc->width) || (sy >= dc->height))
+        return;
+    w = _MIN(rect->x2 - rect->x1, dc->width - sx);
+    h = _MIN(rect->y2 - rect->y1, dc->height - sy);
+    if ((w <= 0) || (h <= 0)) return;
+
+    ptr = BUFFER_PIXEL(dc, sx, sy);
+    for (y = rect->y1; y < (rect->y1 + h); y++, ptr += dc->pitch)
+        dest->engine->blit_line(dest, rect->x1, rect->x1 + w, y, ptr);
+}
+
+static rt_bool_t _dc_buffer_fini(rtgui_dc_t *self) {
+    struct rtgui_dc_buffer *dc = (struct rtgui_dc_buffer *)self;
+
+    if (!self || (self->type != RTGUI_DC_BUFFER)) return RT_FALSE;
+
+    /* the dc itself is freed by rtgui_dc_destory() */
+    rtgui_free(dc->pixel);
+    dc->pixel = RT_NULL;
+    return RT_TRUE;
+}
+
+/* Public functions ----------------------------------------------------------*/
+rtgui_dc_t *rtgui_dc_buffer_create(int width, int height) {
+    struct rtgui_dc_buffer *dc;
+    rt_uint8_t bits;
+
+    if ((width <= 0) || (height <= 0)) return RT_NULL;
+
+    bits = display()->bits_per_pixel;
+    if (bits < 8) {
+        LOG_E("no buffer dc for %d bpp", bits);
+        return RT_NULL;
+    }
+
+    dc = rtgui_malloc(sizeof(struct rtgui_dc_buffer));
+    if (!dc) {
+        LOG_E("no mem for dc");
+        return RT_NULL;
+    }
+
+    dc->_super.type = RTGUI_DC_BUFFER;
+    dc->_super.engine = &dc_buffer_engine;
+    dc->gc.foreground = default_foreground;
+    dc->gc.background = default_background;
+    dc->gc.textstyle = RTGUI_TEXTSTYLE_NORMAL;
+    dc->gc.textalign = RTGUI_ALIGN_LEFT | RTGUI_ALIGN_TOP;
+    dc->gc.font = rtgui_font_default();
+    dc->pixel_format = display()->pixel_format;
+    dc->bpp = _BIT2BYTE(bits);
+    dc->width = width;
+    dc->height = height;
+    /* keep lines word aligned */
+    dc->pitch = (width * dc->bpp + 3) & ~0x03;
+
+    dc->pixel = rtgui_malloc(dc->pitch * height);
+    if (!dc->pixel) {
+        LOG_E("no mem for pixel");
+        rtgui_free(dc);
+        return RT_NULL;
+    }
+    rt_memset(dc->pixel, 0x00, dc->pitch * height);
+
+    return &(dc->_super);
+}
+RTM_EXPORT(rtgui_dc_buffer_create);
+
+rt_uint8_t *rtgui_dc_buffer_get_pixel(rtgui_dc_t *dc) {
+    if (!dc || (dc->type != RTGUI_DC_BUFFER)) return RT_NULL;
+    return ((struct rtgui_dc_buffer *)dc)->pixel;
+}
+RTM_EXPORT(rtgui_dc_buffer_get_pixel);
@@ -92,16 +92,32 @@ static void _dc_client_draw_color_point(rtgui_dc_t *self, int x, int y,
     y += owner->extent.y1;
 
     if (rtgui_region_contains_point(&(owner->clip), x, y, &rect)) {
-        if (color)
-            display()->ops->set_pixel(&color, x, y);
+        if (!color) color = owner->gc.foreground;
+        color = rtgui_gfx_native_color(color);
+        display()->native_ops->set_pixel(&color, x, y);
+        rtgui_dc_damage(owner, x, y, x + 1, y + 1);
+    }
+}
+
+/* the first rect of clip not above y, the rects are sorted in y-x bands */
+static rtgui_rect_t *_dc_client_find_band(rtgui_rect_t *rect,
+    rtgui_rect_t *end, int y) {
+    rtgui_rect_t *mid;
+
+    while (rect < end) {
+        mid = rect + ((end - rect) >> 1);
+        if (mid->y2 <= y)
+            rect = mid + 1;
         else
-            display()->ops->set_pixel(&(owner->gc.foreground), x, y);
+            end = mid;
     }
+    return rect;
 }
 
 static void _dc_client_draw_vline(rtgui_dc_t *self, int x, int y1, int y2) {
     rtgui_widget_t *owner;
-    rtgui_rect_t *rect;
+    rtgui_rect_t *rect, *end;
+    rtgui_color_t pixel;
 
     if (!self || !rtgui_dc_get_visible(self)) return;
     owner = rt_container_of(self, rtgui_widget_t, dc_type);
@@ -110,35 +126,25 @@ static void _dc_client_draw_vline(rtgui_dc_t *self, int x, int y1, int y2) {
     y1 += owner->extent.y1;
     y2 += owner->extent.y1;
     if (y1 > y2) _int_swap(y1, y2);
-
-    if (rtgui_region_is_flat(&(owner->clip))) {
-        rect = &(owner->clip.extents);
-        if (!IS_VL_INTERSECT(rect, x, y1, y2)) return;
-
-        if (y1 < rect->y1) y1 = rect->y1;
-        if (y2 > rect->y2) y2 = rect->y2;
-        display()->ops->draw_vline(&(owner->gc.foreground), x, y1, y2);
-    } else {
-        register rt_uint32_t idx;
-        register rt_base_t draw_y1, draw_y2;
-
-        for (idx = 1; idx <= rtgui_region_num_rects(&(owner->clip)); idx++) {
-            rect = ((rtgui_rect_t *)(owner->clip.data + idx));
-            draw_y1 = y1;
-            draw_y2 = y2;
-            if (!IS_VL_INTERSECT(rect, x, y1, y2)) continue;
-
-            if (rect->y1 > y1) draw_y1 = rect->y1;
-            if (rect->y2 < y2) draw_y2 = rect->y2;
-            display()->ops->draw_vline(&(owner->gc.foreground), x, draw_y1,
-                draw_y2);
-        }
+    pixel = rtgui_gfx_native_color(owner->gc.foreground);
+    rtgui_dc_damage(owner, x, y1, x + 1, y2);
+
+    /* walk the bands overlapping the line, at most one rect per band */
+    rect = rtgui_region_rects(&(owner->clip));
+    end = rect + rtgui_region_num_rects(&(owner->clip));
+    for (rect = _dc_client_find_band(rect, end, y1);
+         (rect < end) && (rect->y1 < y2); rect++) {
+        if ((rect->x1 > x) || (rect->x2 <= x)) continue;
+
+        display()->native_ops->draw_vline(&pixel, x, _MAX(y1, rect->y1),
+            _MIN(y2, rect->y2));
     }
 }
 
 static void _dc_client_draw_hline(rtgui_dc_t *self, int x1, int x2, int y) {
     rtgui_widget_t *owner;
-    rtgui_rect_t *rect;
+    rtgui_rect_t *rect, *end;
+    rtgui_color_t pixel;
 
     if (!self || !rtgui_dc_get_visible(self)) return;
     owner = rt_container_of(self, rtgui_widget_t, dc_type);
@@ -147,55 +153,64 @@ static void _dc_client_draw_hline(rtgui_dc_t *self, int x1, int x2, int y) {
     x2 += owner->extent.x1;
     y  += owner->extent.y1;
     if (x1 > x2) _int_swap(x1, x2);
-
-    if (rtgui_region_is_flat(&(owner->clip))) {
-        rect = &(owner->clip.extents);
-        if (!IS_HL_INTERSECT(rect, x1, x2, y)) return;
-
-        if (rect->x1 > x1) x1 = rect->x1;
-        if (rect->x2 < x2) x2 = rect->x2;
-        display()->ops->draw_hline(&(owner->gc.foreground), x1, x2, y);
-    } else {
-        register rt_uint32_t idx;
-        register rt_base_t draw_x1, draw_x2;
-
-        for (idx = 1; idx <= rtgui_region_num_rects(&(owner->clip)); idx++) {
-            rect = ((rtgui_rect_t *)(owner->clip.data + idx));
-            draw_x1 = x1;
-            draw_x2 = x2;
-            if (!IS_HL_INTERSECT(rect, x1, x2, y)) continue;
-
-            if (rect->x1 > x1) draw_x1 = rect->x1;
-            if (rect->x2 < x2) draw_x2 = rect->x2;
-            display()->ops->draw_hline(&(owner->gc.foreground), draw_x1,
-                draw_x2, y);
-        }
+    pixel = rtgui_gfx_native_color(owner->gc.foreground);
+    rtgui_dc_damage(owner, x1, y, x2, y + 1);
+
+    /* only the band containing y */
+    rect = rtgui_region_rects(&(owner->clip));
+    end = rect + rtgui_region_num_rects(&(owner->clip));
+    for (rect = _dc_client_find_band(rect, end, y);
+         (rect < end) && (rect->y1 <= y); rect++) {
+        if (rect->x2 <= x1) continue;
+        if (rect->x1 >= x2) break;
+
+        display()->native_ops->draw_hline(&pixel, _MAX(x1, rect->x1),
+            _MIN(x2, rect->x2), y);
     }
 }
 
 static void _dc_client_fill_rect(rtgui_dc_t *self, rtgui_rect_t *rect) {
-    register rt_base_t idx;
     rtgui_widget_t *owner;
-    rtgui_color_t fc;
+    rtgui_rect_t area, draw;
+    rtgui_rect_t *clip, *end;
+    rtgui_color_t pixel;
+    int y;
 
     if (!self || !rtgui_dc_get_visible(self)) return;
     owner = rt_container_of(self, rtgui_widget_t, dc_type);
 
-    fc = owner->gc.foreground;
-    owner->gc.foreground = owner->gc.background;
-
-    /* fill rect */
-    for (idx = rect->y1; idx < rect->y2; idx++)
-        _dc_client_draw_hline(self, rect->x1, rect->x2, idx);
-
-    owner->gc.foreground = fc;
+    /* convert logic to device */
+    area = *rect;
+    rtgui_rect_move(&area, owner->extent.x1, owner->extent.y1);
+    pixel = rtgui_gfx_native_color(owner->gc.background);
+    rtgui_dc_damage(owner, area.x1, area.y1, area.x2, area.y2);
+
+    /* one bulk fill per visible clip rect of the overlapped bands */
+    clip = rtgui_region_rects(&(owner->clip));
+    end = clip + rtgui_region_num_rects(&(owner->clip));
+    for (clip = _dc_client_find_band(clip, end, area.y1);
+         (clip < end) && (clip->y1 < area.y2); clip++) {
+        if ((clip->x2 <= area.x1) || (clip->x1 >= area.x2)) continue;
+
+        draw.x1 = _MAX(area.x1, clip->x1);
+        draw.y1 = _MAX(area.y1, clip->y1);
+        draw.x2 = _MIN(area.x2, clip->x2);
+        draw.y2 = _MIN(area.y2, clip->y2);
+        if (display()->native_ops->fill_rect) {
+            display()->native_ops->fill_rect(&pixel, &draw);
+        } else {
+            for (y = draw.y1; y < draw.y2; y++)
+                display()->native_ops->draw_hline(&pixel, draw.x1, draw.x2,
+                    y);
+        }
+    }
 }
 
 static void _dc_client_blit_line(rtgui_dc_t *self, int x1, int x2, int y,
     rt_uint8_t *line_data) {
     rtgui_widget_t *owner;
-    rtgui_rect_t *rect;
-    rt_base_t offset;
+    rtgui_rect_t *rect, *end;
+    rt_base_t draw_x1, bpp;
 
     if (!self || !rtgui_dc_get_visible(self)) return;
     owner = rt_container_of(self, rtgui_widget_t, dc_type);
@@ -205,47 +220,35 @@ static void _dc_client_blit_line(rtgui_dc_t *self, int x1, int x2, int y,
     x2 += owner->extent.x1;
     y  += owner->extent.y1;
     if (x1 > x2) _int_swap(x1, x2);
-
-    if (rtgui_region_is_flat(&(owner->clip))) {
-        rect = &(owner->clip.extents);
-        if (!IS_HL_INTERSECT(rect, x1, x2, y)) return;
-
-        if (rect->x1 > x1) x1 = rect->x1;
-        if (rect->x2 < x2) x2 = rect->x2;
-        /* patch note:
-         * We need to adjust the offset when update widget clip!
-         * Of course at ordinary times for 0. General */
-        offset = (owner->clip.extents.x1 - owner->extent.x1) * \
-            _BIT2BYTE(display()->bits_per_pixel);
-        /* draw hline */
-        display()->ops->draw_raw_hline(line_data + offset, x1, x2, y);
-    } else {
-        register rt_ubase_t idx;
-        register rt_base_t draw_x1, draw_x2;
-
-        for (idx = 1; idx <= rtgui_region_num_rects(&(owner->clip)); idx++) {
-            rect = ((rtgui_rect_t *)(owner->clip.data + idx));
-            draw_x1 = x1;
-            draw_x2 = x2;
-            if (!IS_HL_INTERSECT(rect, x1, x2, y)) continue;
-
-            if (rect->x1 > x1) draw_x1 = rect->x1;
-            if (rect->x2 < x2) draw_x2 = rect->x2;
-            offset = (draw_x1 - x1) * _BIT2BYTE(display()->bits_per_pixel);
-            display()->ops->draw_raw_hline(line_data + offset, draw_x1,
-                draw_x2, y);
-        }
+    bpp = _BIT2BYTE(display()->bits_per_pixel);
+    rtgui_dc_damage(owner, x1, y, x2, y + 1);
+
+    /* only the band containing y, skip the clipped pixels */
+    rect = rtgui_region_rects(&(owner->clip));
+    end = rect + rtgui_region_num_rects(&(owner->clip));
+    for (rect = _dc_client_find_band(rect, end, y);
+         (rect < end) && (rect->y1 <= y); rect++) {
+        if (rect->x2 <= x1) continue;
+        if (rect->x1 >= x2) break;
+
+        draw_x1 = _MAX(x1, rect->x1);
+        display()->native_ops->draw_raw_hline(
+            line_data + (draw_x1 - x1) * bpp, draw_x1, _MIN(x2, rect->x2), y);
     }
 }
 
-static void _dc_client_blit(rtgui_dc_t *dc, struct rtgui_point *dc_point,
+static void _dc_client_blit(rtgui_dc_t *self, struct rtgui_point *dc_point,
     rtgui_dc_t *dest, rtgui_rect_t *rect) {
-    (void)dc;
-    (void)dc_point;
-    (void)dest;
-    (void)rect;
-    /* no blit in hardware dc? */
-    LOG_E("no client dc blit");
+    rtgui_widget_t *owner;
+    struct rtgui_point point;
+
+    if (!self || !rtgui_dc_get_visible(self)) return;
+    owner = rt_container_of(self, rtgui_widget_t, dc_type);
+
+    /* convert logic to device */
+    point.x = owner->extent.x1 + (dc_point ? dc_point->x : 0);
+    point.y = owner->extent.y1 + (dc_point ? dc_point->y : 0);
+    rtgui_dc_blit_screen(&point, dest, rect);
 }
 
 static rt_bool_t _dc_client_uninit(rtgui_dc_t *dc) {
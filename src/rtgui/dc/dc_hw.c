@@ -94,6 +94,7 @@ static rt_bool_t rtgui_dc_hw_fini(rtgui_dc_t *dc)
  */
 static void rtgui_dc_hw_draw_point(rtgui_dc_t *self, int x, int y) {
     struct rtgui_dc_hw *dc;
+    rtgui_color_t color;
 
     RT_ASSERT(self != RT_NULL);
     dc = (struct rtgui_dc_hw *) self;
@@ -106,7 +107,9 @@ static void rtgui_dc_hw_draw_point(rtgui_dc_t *self, int x, int y) {
     if (y > dc->owner->extent.y2) return;
 
     /* draw this point */
-    dc->hw_driver->ops->set_pixel(&(dc->owner->gc.foreground), x, y);
+    color = rtgui_gfx_native_color(dc->owner->gc.foreground);
+    dc->hw_driver->native_ops->set_pixel(&color, x, y);
+    rtgui_dc_damage(dc->owner, x, y, x + 1, y + 1);
 }
 
 static void rtgui_dc_hw_draw_color_point(rtgui_dc_t *self, int x, int y,
@@ -124,7 +127,9 @@ static void rtgui_dc_hw_draw_color_point(rtgui_dc_t *self, int x, int y,
     if (y > dc->owner->extent.y2) return;
 
     /* draw this point */
-    dc->hw_driver->ops->set_pixel(&color, x, y);
+    color = rtgui_gfx_native_color(color);
+    dc->hw_driver->native_ops->set_pixel(&color, x, y);
+    rtgui_dc_damage(dc->owner, x, y, x + 1, y + 1);
 }
 
 /*
@@ -132,6 +137,7 @@ static void rtgui_dc_hw_draw_color_point(rtgui_dc_t *self, int x, int y,
  */
 static void rtgui_dc_hw_draw_vline(rtgui_dc_t *self, int x, int y1, int y2) {
     struct rtgui_dc_hw *dc;
+    rtgui_color_t color;
 
     RT_ASSERT(self != RT_NULL);
     dc = (struct rtgui_dc_hw *)self;
@@ -151,7 +157,9 @@ static void rtgui_dc_hw_draw_vline(rtgui_dc_t *self, int x, int y1, int y2) {
     if (y2 > dc->owner->extent.y2) y2 = dc->owner->extent.y2;
 
     /* draw vline */
-    dc->hw_driver->ops->draw_vline(&(dc->owner->gc.foreground), x, y1, y2);
+    color = rtgui_gfx_native_color(dc->owner->gc.foreground);
+    dc->hw_driver->native_ops->draw_vline(&color, x, y1, y2);
+    rtgui_dc_damage(dc->owner, x, y1, x + 1, y2);
 }
 
 /*
@@ -159,6 +167,7 @@ static void rtgui_dc_hw_draw_vline(rtgui_dc_t *self, int x, int y1, int y2) {
  */
 static void rtgui_dc_hw_draw_hline(rtgui_dc_t *self, int x1, int x2, int y) {
     struct rtgui_dc_hw *dc;
+    rtgui_color_t color;
 
     RT_ASSERT(self != RT_NULL);
     dc = (struct rtgui_dc_hw *)self;
@@ -177,7 +186,9 @@ static void rtgui_dc_hw_draw_hline(rtgui_dc_t *self, int x1, int x2, int y) {
     if (x2 > dc->owner->extent.x2) x2 = dc->owner->extent.x2;
 
     /* draw hline */
-    dc->hw_driver->ops->draw_hline(&(dc->owner->gc.foreground), x1, x2, y);
+    color = rtgui_gfx_native_color(dc->owner->gc.foreground);
+    dc->hw_driver->native_ops->draw_hline(&color, x1, x2, y);
+    rtgui_dc_damage(dc->owner, x1, y, x2, y + 1);
 }
 
 static void rtgui_dc_hw_fill_rect(rtgui_dc_t *self, rtgui_rect_t *rect) {
@@ -190,7 +201,7 @@ static void rtgui_dc_hw_fill_rect(rtgui_dc_t *self, rtgui_rect_t *rect) {
     dc = (struct rtgui_dc_hw *)self;
 
     /* get background color */
-    color = dc->owner->gc.background;
+    color = rtgui_gfx_native_color(dc->owner->gc.background);
 
     /* convert logic to device */
     x1 = rect->x1 + dc->owner->extent.x1;
@@ -208,8 +219,19 @@ static void rtgui_dc_hw_fill_rect(rtgui_dc_t *self, rtgui_rect_t *rect) {
     if (y2 > dc->owner->extent.y2) y2 = dc->owner->extent.y2;
 
     /* fill rect */
-    for (; y1 <= y2; y1++)
-        dc->hw_driver->ops->draw_hline(&color, x1, x2, y1);
+    rtgui_dc_damage(dc->owner, x1, y1, x2, y2 + 1);
+    if (dc->hw_driver->native_ops->fill_rect) {
+        rtgui_rect_t area;
+
+        area.x1 = x1;
+        area.y1 = y1;
+        area.x2 = x2;
+        area.y2 = y2 + 1;
+        dc->hw_driver->native_ops->fill_rect(&color, &area);
+    } else {
+        for (; y1 <= y2; y1++)
+            dc->hw_driver->native_ops->draw_hline(&color, x1, x2, y1);
+    }
 }
 
 static void rtgui_dc_hw_blit_line(rtgui_dc_t *self, int x1, int x2, int y, rt_uint8_t *line_data)
@@ -233,22 +255,30 @@ static void rtgui_dc_hw_blit_line(rtgui_dc_t *self, int x1, int x2, int y, rt_ui
 
     if (x1 > dc->owner->extent.x2 || x2 < dc->owner->extent.x1)
         return;
-    if (x1 < dc->owner->extent.x1)
+    if (x1 < dc->owner->extent.x1) {
+        /* skip the clipped pixels */
+        line_data += (dc->owner->extent.x1 - x1) * \
+            _BIT2BYTE(dc->hw_driver->bits_per_pixel);
         x1 = dc->owner->extent.x1;
+    }
     if (x2 > dc->owner->extent.x2)
         x2 = dc->owner->extent.x2;
 
-    dc->hw_driver->ops->draw_raw_hline(line_data, x1, x2, y);
+    dc->hw_driver->native_ops->draw_raw_hline(line_data, x1, x2, y);
+    rtgui_dc_damage(dc->owner, x1, y, x2, y + 1);
 }
 
-static void rtgui_dc_hw_blit(rtgui_dc_t *dc, struct rtgui_point *dc_point,
+static void rtgui_dc_hw_blit(rtgui_dc_t *self, struct rtgui_point *dc_point,
     rtgui_dc_t *dest, rtgui_rect_t *rect) {
-    /* not blit in hardware dc */
-    (void)dc;
-    (void)dc_point;
-    (void)dest;
-    (void)rect;
-    /* no blit in hardware dc? */
-    LOG_E("no hw dc blit");
+    struct rtgui_dc_hw *dc;
+    struct rtgui_point point;
+
+    RT_ASSERT(self != RT_NULL);
+    dc = (struct rtgui_dc_hw *) self;
+
+    /* convert logic to device */
+    point.x = dc->owner->extent.x1 + (dc_point ? dc_point->x : 0);
+    point.y = dc->owner->extent.y1 + (dc_point ? dc_point->y : 0);
+    rtgui_dc_blit_screen(&point, dest, rect);
 }
 
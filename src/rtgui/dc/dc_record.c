@@ -0,0 +1,404 @@
+/*
+ * File      : dc_record.c
+ * This file is part of RT-Thread GUI Engine
+ * COPYRIGHT (C) 2006 - 2017, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2019-07-14     onelife      first version
+ * 2019-08-24     onelife      record color of point as is
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "include/rtgui.h"
+
+#ifdef RTGUI_USING_DISPLAY_LIST
+
+#ifdef RT_USING_ULOG
+# define LOG_LVL                    RTGUI_LOG_LEVEL
+# define LOG_TAG                    " DC_REC"
+# include "components/utilities/ulog/ulog.h"
+#else /* RT_USING_ULOG */
+# define LOG_E(format, args...)     rt_kprintf(format "\n", ##args)
+# define LOG_D                      LOG_E
+#endif /* RT_USING_ULOG */
+
+/* Private typedef -----------------------------------------------------------*/
+enum rtgui_dc_op {
+    DC_OP_HLINE = 0,
+    DC_OP_VLINE,
+    DC_OP_FILL,
+    DC_OP_BLIT,
+};
+
+/* one drawing command, followed by "size" bytes of line data for blit */
+struct rtgui_dc_cmd {
+    rt_uint8_t op;
+    rt_uint8_t run;                         /* hline of points */
+    rt_uint16_t size;
+    rt_int16_t x1, y1, x2, y2;
+    rtgui_color_t color;
+};
+
+struct rtgui_dc_list {
+    rt_uint16_t size;                       /* buffer size */
+    rt_uint16_t len;                        /* recorded length */
+    rt_uint16_t last;                       /* offset of last command */
+    rt_uint8_t record;                      /* nesting of recording */
+    rt_bool_t armed;                        /* record next drawing */
+    rt_bool_t replay;                       /* replaying */
+    rt_bool_t valid;                        /* the list matches screen */
+    rt_bool_t overflow;
+    rt_uint8_t *buf;
+};
+
+/* Private define ------------------------------------------------------------*/
+#define RECORD(dc)                          ((struct rtgui_dc_record *)(dc))
+#define CMD_AT(list, ofs)                   \
+    ((struct rtgui_dc_cmd *)((list)->buf + (ofs)))
+#define CMD_SIZE(size)                      \
+    (sizeof(struct rtgui_dc_cmd) + (((size) + 3) & ~0x03))
+
+/* Private function prototypes -----------------------------------------------*/
+static void _dc_record_draw_point(rtgui_dc_t *dc, int x, int y);
+static void _dc_record_draw_color_point(rtgui_dc_t *dc, int x, int y,
+    rtgui_color_t color);
+static void _dc_record_draw_vline(rtgui_dc_t *dc, int x, int y1, int y2);
+static void _dc_record_draw_hline(rtgui_dc_t *dc, int x1, int x2, int y);
+static void _dc_record_fill_rect(rtgui_dc_t *dc, rtgui_rect_t *rect);
+static void _dc_record_blit_line(rtgui_dc_t *self, int x1, int x2, int y,
+    rt_uint8_t *line_data);
+static void _dc_record_blit(rtgui_dc_t *dc, struct rtgui_point *dc_point,
+    rtgui_dc_t *dest, rtgui_rect_t *rect);
+static rt_bool_t _dc_record_fini(rtgui_dc_t *dc);
+
+/* Private variables ---------------------------------------------------------*/
+const rtgui_dc_engine_t dc_record_engine = {
+    _dc_record_draw_point,
+    _dc_record_draw_color_point,
+    _dc_record_draw_vline,
+    _dc_record_draw_hline,
+    _dc_record_fill_rect,
+    _dc_record_blit_line,
+    _dc_record_blit,
+    _dc_record_fini,
+};
+
+/* Private functions ---------------------------------------------------------*/
+static struct rtgui_dc_cmd *_dc_record_add(rtgui_dc_t *self, rt_uint8_t op,
+    rt_uint16_t size) {
+    struct rtgui_dc_list *list = RECORD(self)->owner->dlist;
+    struct rtgui_dc_cmd *cmd;
+
+    if (!list || list->overflow) return RT_NULL;
+    if ((list->len + CMD_SIZE(size)) > list->size) {
+        /* too much to record, draw by owner next time */
+        list->overflow = RT_TRUE;
+        return RT_NULL;
+    }
+
+    cmd = CMD_AT(list, list->len);
+    cmd->op = op;
+    cmd->run = RT_FALSE;
+    cmd->size = size;
+    list->last = list->len;
+    list->len += CMD_SIZE(size);
+    return cmd;
+}
+
+/* points in a row (e.g. glyph) are merged to a run */
+static void _dc_record_point(rtgui_dc_t *self, int x, int y,
+    rtgui_color_t color) {
+    struct rtgui_dc_list *list = RECORD(self)->owner->dlist;
+    struct rtgui_dc_cmd *cmd;
+
+    if (list && list->len) {
+        cmd = CMD_AT(list, list->last);
+        if (cmd->run && (cmd->y1 == y) && (cmd->x2 == x) && \
+            (cmd->color == color)) {
+            cmd->x2++;
+            return;
+        }
+    }
+
+    cmd = _dc_record_add(self, DC_OP_HLINE, 0);
+    if (!cmd) return;
+    cmd->run = RT_TRUE;
+    cmd->x1 = x;
+    cmd->y1 = y;
+    cmd->x2 = x + 1;
+    cmd->y2 = y + 1;
+    cmd->color = color;
+}
+
+static void _dc_record_draw_point(rtgui_dc_t *self, int x, int y) {
+    rtgui_dc_t *dc = RECORD(self)->dc;
+
+    dc->engine->draw_point(dc, x, y);
+    _dc_record_point(self, x, y, rtgui_dc_get_gc(dc)->foreground);
+}
+
+static void _dc_record_draw_color_point(rtgui_dc_t *self, int x, int y,
+    rtgui_color_t color) {
+    rtgui_dc_t *dc = RECORD(self)->dc;
+
+    dc->engine->draw_color_point(dc, x, y, color);
+    _dc_record_point(self, x, y, color);
+}
+
+static void _dc_record_draw_vline(rtgui_dc_t *self, int x, int y1, int y2) {
+    rtgui_dc_t *dc = RECORD(self)->dc;
+    struct rtgui_dc_cmd *cmd;
+
+    dc->engine->draw_vline(dc, x, y1, y2);
+
+    cmd = _dc_record_add(self, DC_OP_VLINE, 0);
+    if (!cmd) return;
+    cmd->x1 = x;
+    cmd->y1 = y1;
+    cmd->x2 = x + 1;
+    cmd->y2 = y2;
+    cmd->color = rtgui_dc_get_gc(dc)->foreground;
+}
+
+static void _dc_record_draw_hline(rtgui_dc_t *self, int x1, int x2, int y) {
+    rtgui_dc_t *dc = RECORD(self)->dc;
+    struct rtgui_dc_cmd *cmd;
+
+    dc->engine->draw_hline(dc, x1, x2, y);
+
+    cmd = _dc_record_add(self, DC_OP_HLINE, 0);
+    if (!cmd) return;
+    cmd->x1 = x1;
+    cmd->y1 = y;
+    cmd->x2 = x2;
+    cmd->y2 = y + 1;
+    cmd->color = rtgui_dc_get_gc(dc)->foreground;
+}
+
+static void _dc_record_fill_rect(rtgui_dc_t *self, rtgui_rect_t *rect) {
+    rtgui_dc_t *dc = RECORD(self)->dc;
+    struct rtgui_dc_cmd *cmd;
+
+    dc->engine->fill_rect(dc, rect);
+
+    cmd = _dc_record_add(self, DC_OP_FILL, 0);
+    if (!cmd) return;
+    cmd->x1 = rect->x1;
+    cmd->y1 = rect->y1;
+    cmd->x2 = rect->x2;
+    cmd->y2 = rect->y2;
+    cmd->color = rtgui_dc_get_gc(dc)->background;
+}
+
+static void _dc_record_blit_line(rtgui_dc_t *self, int x1, int x2, int y,
+    rt_uint8_t *line_data) {
+    rtgui_dc_t *dc = RECORD(self)->dc;
+    struct rtgui_dc_cmd *cmd;
+    rt_uint32_t size;
+
+    dc->engine->blit_line(dc, x1, x2, y, line_data);
+
+    size = _ABS(x2 - x1) * \
+           _BIT2BYTE(rtgui_get_gfx_device()->bits_per_pixel);
+    if (size > 0xffff) {
+        RECORD(self)->owner->dlist->overflow = RT_TRUE;
+        return;
+    }
+    cmd = _dc_record_add(self, DC_OP_BLIT, size);
+    if (!cmd) return;
+    cmd->x1 = x1;
+    cmd->y1 = y;
+    cmd->x2 = x2;
+    cmd->y2 = y + 1;
+    cmd->color = 0;
+    rt_memcpy(cmd + 1, line_data, size);
+}
+
+static void _dc_record_blit(rtgui_dc_t *self, struct rtgui_point *dc_point,
+    rtgui_dc_t *dest, rtgui_rect_t *rect) {
+    rtgui_dc_t *dc = RECORD(self)->dc;
+
+    /* as source, nothing to record */
+    dc->engine->blit(dc, dc_point, dest, rect);
+}
+
+static rt_bool_t _dc_record_fini(rtgui_dc_t *self) {
+    (void)self;
+    /* freed by rtgui_dc_record_end() */
+    return RT_FALSE;
+}
+
+/* Public functions ----------------------------------------------------------*/
+rt_err_t rtgui_dc_list_attach(rtgui_widget_t *owner, rt_uint32_t size) {
+    struct rtgui_dc_list *list;
+
+    if (!owner || !size || (size > 0xffff)) return -RT_EINVAL;
+    rtgui_dc_list_detach(owner);
+
+    list = rtgui_malloc(sizeof(struct rtgui_dc_list) + size);
+    if (!list) {
+        LOG_E("no mem for list");
+        return -RT_ENOMEM;
+    }
+    rt_memset(list, 0x00, sizeof(struct rtgui_dc_list));
+    list->size = size;
+    list->buf = (rt_uint8_t *)(list + 1);
+    owner->dlist = list;
+
+    return RT_EOK;
+}
+RTM_EXPORT(rtgui_dc_list_attach);
+
+void rtgui_dc_list_detach(rtgui_widget_t *owner) {
+    if (!owner || !owner->dlist) return;
+    rtgui_free(owner->dlist);
+    owner->dlist = RT_NULL;
+}
+RTM_EXPORT(rtgui_dc_list_detach);
+
+void rtgui_dc_list_dirty(rtgui_widget_t *owner) {
+    if (!owner || !owner->dlist) return;
+    owner->dlist->valid = RT_FALSE;
+}
+RTM_EXPORT(rtgui_dc_list_dirty);
+
+rt_bool_t rtgui_dc_list_replay(rtgui_widget_t *owner) {
+    struct rtgui_dc_list *list;
+    struct rtgui_dc_cmd *cmd;
+    rtgui_rect_t clip;
+    rtgui_gc_t *gc, save;
+    rtgui_dc_t *dc;
+    rt_uint32_t ofs;
+
+    if (!owner || !owner->dlist) return RT_FALSE;
+    list = owner->dlist;
+
+    if (!list->valid) {
+        /* record the drawing by owner */
+        list->len = 0;
+        list->overflow = RT_FALSE;
+        list->armed = RT_TRUE;
+        return RT_FALSE;
+    }
+
+    list->replay = RT_TRUE;
+    dc = rtgui_dc_begin_drawing(owner);
+    list->replay = RT_FALSE;
+    if (!dc) return RT_TRUE;
+
+    /* visible area in logic coordinate */
+    clip = owner->clip.extents;
+    rtgui_rect_move(&clip, -owner->extent.x1, -owner->extent.y1);
+    gc = rtgui_dc_get_gc(dc);
+    save = *gc;
+
+    for (ofs = 0; ofs < list->len; ofs += CMD_SIZE(cmd->size)) {
+        cmd = CMD_AT(list, ofs);
+
+        /* skip the commands out of clip */
+        if ((_MAX(cmd->x1, cmd->x2) <= clip.x1) || \
+            (_MIN(cmd->x1, cmd->x2) >= clip.x2) || \
+            (_MAX(cmd->y1, cmd->y2) <= clip.y1) || \
+            (_MIN(cmd->y1, cmd->y2) >= clip.y2))
+            continue;
+
+        switch (cmd->op) {
+        case DC_OP_HLINE:
+            gc->foreground = cmd->color;
+            dc->engine->draw_hline(dc, cmd->x1, cmd->x2, cmd->y1);
+            break;
+
+        case DC_OP_VLINE:
+            gc->foreground = cmd->color;
+            dc->engine->draw_vline(dc, cmd->x1, cmd->y1, cmd->y2);
+            break;
+
+        case DC_OP_FILL:
+        {
+            rtgui_rect_t rect;
+
+            rect.x1 = cmd->x1;
+            rect.y1 = cmd->y1;
+            rect.x2 = cmd->x2;
+            rect.y2 = cmd->y2;
+            gc->background = cmd->color;
+            dc->engine->fill_rect(dc, &rect);
+            break;
+        }
+
+        case DC_OP_BLIT:
+            dc->engine->blit_line(dc, cmd->x1, cmd->x2, cmd->y1,
+                (rt_uint8_t *)(cmd + 1));
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    *gc = save;
+    rtgui_dc_end_drawing(dc, RT_TRUE);
+    return RT_TRUE;
+}
+RTM_EXPORT(rtgui_dc_list_replay);
+
+/* called by rtgui_dc_begin_drawing() with the created dc (may be RT_NULL) */
+rtgui_dc_t *rtgui_dc_record_begin(rtgui_widget_t *owner, rtgui_dc_t *dc) {
+    struct rtgui_dc_list *list = owner->dlist;
+    struct rtgui_dc_record *rec;
+    rt_bool_t armed;
+
+    if (!list || list->replay) return dc;
+    armed = list->armed;
+    list->armed = RT_FALSE;
+    if (!dc) return dc;
+
+    if (!armed && !list->record) {
+        /* drawn out of recording */
+        list->valid = RT_FALSE;
+        return dc;
+    }
+
+    rec = rtgui_malloc(sizeof(struct rtgui_dc_record));
+    if (!rec) {
+        LOG_E("no mem for dc");
+        list->valid = RT_FALSE;
+        return dc;
+    }
+    rec->_super.type = RTGUI_DC_RECORD;
+    rec->_super.engine = &dc_record_engine;
+    rec->dc = dc;
+    rec->owner = owner;
+    list->record++;
+
+    return &(rec->_super);
+}
+
+/* called by rtgui_dc_end_drawing(), returns the drawing dc */
+rtgui_dc_t *rtgui_dc_record_end(rtgui_dc_t *dc) {
+    struct rtgui_dc_list *list = RECORD(dc)->owner->dlist;
+    rtgui_dc_t *drawing = RECORD(dc)->dc;
+
+    if (list && list->record) {
+        list->record--;
+        if (!list->record) list->valid = !list->overflow;
+    }
+    rtgui_free(dc);
+    return drawing;
+}
+
+#endif /* RTGUI_USING_DISPLAY_LIST */
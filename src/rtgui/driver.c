@@ -27,7 +27,11 @@
 #include "include/rtgui.h"
 
 #if defined(CONFIG_TOUCH_DEVICE_NAME) || defined(CONFIG_KEY_DEVICE_NAME)
-# include "components/arduino/drv_common.h"
+# ifdef RTGUI_USING_SIMULATOR
+#  include "include/simulator.h"
+# else
+#  include "components/arduino/drv_common.h"
+# endif
 #endif
 
 #ifdef RT_USING_ULOG
@@ -40,14 +44,85 @@
 #endif /* RT_USING_ULOG */
 
 /* Private typedef -----------------------------------------------------------*/
+#ifdef RTGUI_USING_BAND_BUFFER
+struct rtgui_band {
+    rtgui_rect_t area;                      /* area to draw */
+    rtgui_rect_t rect;                      /* current band */
+    rt_uint8_t *pixels;                     /* band buffer in native format */
+    rt_uint8_t *mask;                       /* bitmap of drawn pixels */
+    rt_uint16_t pitch;
+    rt_uint16_t mask_pitch;
+    rt_uint8_t bpp;                         /* byte per pixel */
+    /* saved ops when drawing to band */
+    const struct rtgui_graphic_driver_ops *dev_ops;
+    const struct rtgui_graphic_ext_ops *ext_ops;
+};
+#endif
+
 /* Private define ------------------------------------------------------------*/
 #define display()                   rtgui_get_gfx_device()
-#define graphic_ops()               ((struct rtgui_graphic_driver_ops *) \
-                                    display()->device->user_data)
+#ifdef RTGUI_USING_BAND_BUFFER
+/* device ops, not the band ops */
+# define graphic_ops()              (_band.dev_ops ? _band.dev_ops : \
+                                    _gfx_drv.native_ops)
+# ifndef RTGUI_BAND_HEIGHT
+#  define RTGUI_BAND_HEIGHT         (16)
+# endif
+# define BAND_PIXEL(x, y)           (_band.pixels + \
+                                    _band.pitch * ((y) - _band.rect.y1) + \
+                                    _band.bpp * ((x) - _band.rect.x1))
+# define BAND_MASK(y)               (_band.mask + \
+                                    _band.mask_pitch * ((y) - _band.rect.y1))
+# define BAND_IS_SET(mask, x)       ((mask)[(x) >> 3] & (1 << ((x) & 0x07)))
+#else
+# define graphic_ops()              (_gfx_drv.native_ops)
+#endif
+#ifdef RTGUI_USING_ASYNC_UPDATE
+# ifndef RTGUI_UPDATE_QUEUE_SIZE
+#  define RTGUI_UPDATE_QUEUE_SIZE   (4)
+# endif
+# ifndef RTGUI_UPDATE_PRIORITY
+#  define RTGUI_UPDATE_PRIORITY     (RTGUI_SERVER_PRIORITY)
+# endif
+# ifndef RTGUI_UPDATE_STACK_SIZE
+#  define RTGUI_UPDATE_STACK_SIZE   (512)
+# endif
+# define UPDATE_DONE_FLAG           (0x01)
+#endif
+#ifndef RTGUI_DAMAGE_MAX_RECTS
+# define RTGUI_DAMAGE_MAX_RECTS     (4)
+#endif
+#ifndef RTGUI_DAMAGE_MERGE_PERCENT
+# define RTGUI_DAMAGE_MERGE_PERCENT (70)
+#endif
 
 /* Private function prototypes -----------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 static rtgui_gfx_driver_t _gfx_drv;
+#ifdef RTGUI_USING_BAND_BUFFER
+    static struct rtgui_band _band;
+#endif
+#ifdef RTGUI_USING_DOUBLE_BUFFER
+    static rt_uint8_t *_back_buffer = RT_NULL;
+    static rt_bool_t _flip_support;
+    static rtgui_gfx_update_hook_t _overlay_hook = RT_NULL;
+    static rtgui_rect_t _overlay_rect;
+#endif
+#ifdef RTGUI_USING_ASYNC_UPDATE
+    static rt_bool_t _update_inited = RT_FALSE;
+    static struct rt_mutex _update_lock;
+    static struct rt_semaphore _update_free;
+    static struct rt_semaphore _update_ready;
+    static struct rt_event _update_done;
+    /* queued rects, the first one is being sent */
+    static struct rt_device_rect_info _update_queue[RTGUI_UPDATE_QUEUE_SIZE];
+    static rt_uint8_t _update_head = 0;
+    static rt_uint8_t _update_num = 0;
+    static rtgui_gfx_update_hook_t _update_hook = RT_NULL;
+#endif
+static rt_bool_t _damage_inited = RT_FALSE;
+static struct rt_mutex _damage_lock;
+static rtgui_region_t _damage;
 #ifdef CONFIG_TOUCH_DEVICE_NAME
     static rt_bool_t _touch_done = RT_FALSE;
     static rt_device_t _touch;
@@ -66,154 +141,163 @@ static void _draw_raw_hline(rt_uint8_t *pixels, int x1, int x2, int y) {
         graphic_ops()->draw_raw_hline(pixels, x2, x2, y);
 }
 
-#if (CONFIG_USING_MONO)
-static void _mono_set_pixel(rtgui_color_t *c, int x, int y) {
-    rtgui_color_t pixel = rtgui_color_to_mono(*c);
-    graphic_ops()->set_pixel(&pixel, x, y);
-}
-
-static void _mono_get_pixel(rtgui_color_t *c, int x, int y) {
-    rtgui_color_t pixel;
-
-    graphic_ops()->get_pixel(&pixel, x, y);
-    *c = rtgui_color_from_mono(pixel);
-}
-
-static void _mono_draw_hline(rtgui_color_t *c, int x1, int x2, int y) {
-    rtgui_color_t pixel = rtgui_color_to_mono(*c);
-    graphic_ops()->draw_hline(&pixel, x1, x2, y);
-}
-
-static void _mono_draw_vline(rtgui_color_t *c, int x, int y1, int y2) {
-    rtgui_color_t pixel = rtgui_color_to_mono(*c);
-    graphic_ops()->draw_vline(&pixel, x, y1, y2);
-}
-
-static const struct rtgui_graphic_driver_ops _mono_ops = {
-    _mono_set_pixel,
-    _mono_get_pixel,
-    _mono_draw_hline,
-    _mono_draw_vline,
-    _draw_raw_hline,
-};
-#endif /* CONFIG_USING_MONO */
+/* the color of "pixel" is already converted */
+static void _fill_rect(rtgui_color_t *pixel, rtgui_rect_t *rect) {
+    int y;
 
-#if (CONFIG_USING_RGB565)
-static void _rgb565_set_pixel(rtgui_color_t *c, int x, int y) {
-    rtgui_color_t pixel = (rtgui_color_t)rtgui_color_to_565(*c);
-    graphic_ops()->set_pixel(&pixel, x, y);
+    if (graphic_ops()->fill_rect) {
+        graphic_ops()->fill_rect(pixel, rect);
+        return;
+    }
+    for (y = rect->y1; y < rect->y2; y++)
+        graphic_ops()->draw_hline(pixel, rect->x1, rect->x2, y);
 }
 
-static void _rgb565_get_pixel(rtgui_color_t *c, int x, int y) {
-    graphic_ops()->get_pixel(c, x, y);
-    // *c = rtgui_color_from_565((rt_uint16_t)pixel);
-}
+static void _blit_rect(rt_uint8_t *pixels, rt_uint32_t pitch,
+    rtgui_rect_t *rect) {
+    int y;
 
-static void _rgb565_draw_hline(rtgui_color_t *c, int x1, int x2, int y) {
-    rtgui_color_t pixel = (rtgui_color_t)rtgui_color_to_565(*c);
-    graphic_ops()->draw_hline(&pixel, x1, x2, y);
+    if (graphic_ops()->blit_rect) {
+        graphic_ops()->blit_rect(pixels, pitch, rect);
+        return;
+    }
+    for (y = rect->y1; y < rect->y2; y++, pixels += pitch)
+        _draw_raw_hline(pixels, rect->x1, rect->x2, y);
 }
 
-static void _rgb565_draw_vline(rtgui_color_t *c, int x, int y1, int y2) {
-    rtgui_color_t pixel = (rtgui_color_t)rtgui_color_to_565(*c);
-    graphic_ops()->draw_vline(&pixel, x, y1, y2);
+/* store native pixel in the layout of draw_raw_hline */
+static void _put_raw_pixel(rt_uint8_t *pixels, int i, rtgui_color_t pixel) {
+    switch (display()->bits_per_pixel) {
+    case 1:
+        if (pixel)
+            pixels[i >> 3] |= (1 << (i & 0x07));
+        else
+            pixels[i >> 3] &= ~(1 << (i & 0x07));
+        break;
+    case 16:
+        pixels += i << 1;
+        pixels[0] = pixel & 0xff;
+        pixels[1] = (pixel >> 8) & 0xff;
+        break;
+    case 24:
+        pixels += i * 3;
+        pixels[0] = pixel & 0xff;
+        pixels[1] = (pixel >> 8) & 0xff;
+        pixels[2] = (pixel >> 16) & 0xff;
+        break;
+    default:
+        pixels += i << 2;
+        pixels[0] = pixel & 0xff;
+        pixels[1] = (pixel >> 8) & 0xff;
+        pixels[2] = (pixel >> 16) & 0xff;
+        pixels[3] = (pixel >> 24) & 0xff;
+        break;
+    }
 }
 
-static const struct rtgui_graphic_driver_ops _rgb565_ops = {
-    _rgb565_set_pixel,
-    _rgb565_get_pixel,
-    _rgb565_draw_hline,
-    _rgb565_draw_vline,
-    _draw_raw_hline,
-};
-#endif /* CONFIG_USING_RGB565 */
+/* pixel formats of non-framebuffer device:
+   X(name, format, to_native, from_native) */
+#define _AS_IS(c)                   (c)
 
+#if (CONFIG_USING_MONO)
+# define _MONO_FORMAT(X)            X(mono, MONO, rtgui_color_to_mono, \
+                                    rtgui_color_from_mono)
+#else
+# define _MONO_FORMAT(X)
+#endif
+#if (CONFIG_USING_RGB565)
+/* device returns rtgui color when reading RGB565 pixel */
+# define _RGB565_FORMAT(X)          X(rgb565, RGB565, rtgui_color_to_565, \
+                                    _AS_IS)
+#else
+# define _RGB565_FORMAT(X)
+#endif
 #if (CONFIG_USING_RGB565P)
-static void _rgb565p_set_pixel(rtgui_color_t *c, int x, int y) {
-    rtgui_color_t pixel = (rtgui_color_t)rtgui_color_to_565p(*c);
-    graphic_ops()->set_pixel(&pixel, x, y);
-}
-
-static void _rgb565p_get_pixel(rtgui_color_t *c, int x, int y) {
-    rtgui_color_t pixel;
-
-    graphic_ops()->get_pixel(&pixel, x, y);
-    *c = rtgui_color_from_565p((rt_uint16_t)pixel);
-}
-
-static void _rgb565p_draw_hline(rtgui_color_t *c, int x1, int x2, int y) {
-    rtgui_color_t pixel = (rtgui_color_t)rtgui_color_to_565p(*c);
-    graphic_ops()->draw_hline(&pixel, x1, x2, y);
-}
-
-static void _rgb565p_draw_vline(rtgui_color_t *c, int x, int y1, int y2) {
-    rtgui_color_t pixel = (rtgui_color_t)rtgui_color_to_565p(*c);
-    graphic_ops()->draw_vline(&pixel, x, y1, y2);
-}
-
-static const struct rtgui_graphic_driver_ops _rgb565p_ops = {
-    _rgb565p_set_pixel,
-    _rgb565p_get_pixel,
-    _rgb565p_draw_hline,
-    _rgb565p_draw_vline,
-    _draw_raw_hline,
-};
-#endif /* CONFIG_USING_RGB565P */
-
+# define _RGB565P_FORMAT(X)         X(rgb565p, RGB565P, rtgui_color_to_565p, \
+                                    rtgui_color_from_565p)
+#else
+# define _RGB565P_FORMAT(X)
+#endif
 #if (CONFIG_USING_RGB888)
-static void _rgb888_set_pixel(rtgui_color_t *c, int x, int y) {
-    rtgui_color_t pixel = (rtgui_color_t)rtgui_color_to_888(*c);
-    graphic_ops()->set_pixel(&pixel, x, y);
-}
-
-static void _rgb888_get_pixel(rtgui_color_t *c, int x, int y) {
-    rtgui_color_t pixel;
-
-    graphic_ops()->get_pixel(&pixel, x, y);
-    *c = rtgui_color_from_888((rt_uint32_t)pixel);
-}
+# define _RGB888_FORMAT(X)          X(rgb888, RGB888, rtgui_color_to_888, \
+                                    rtgui_color_from_888)
+#else
+# define _RGB888_FORMAT(X)
+#endif
 
-static void _rgb888_draw_hline(rtgui_color_t *c, int x1, int x2, int y) {
-    rtgui_color_t pixel = rtgui_color_to_888(*c);
-    graphic_ops()->draw_hline(&pixel, x1, x2, y);
-}
+#define _PIXEL_FORMATS(X)           _MONO_FORMAT(X) _RGB565_FORMAT(X) \
+                                    _RGB565P_FORMAT(X) _RGB888_FORMAT(X)
+
+/* convert the color once, then call device ops */
+#define _DEFINE_PIXEL_OPS(name, format, to_native, from_native)             \
+static void _##name##_set_pixel(rtgui_color_t *c, int x, int y) {           \
+    rtgui_color_t pixel = (rtgui_color_t)to_native(*c);                     \
+    graphic_ops()->set_pixel(&pixel, x, y);                                 \
+}                                                                           \
+                                                                            \
+static void _##name##_get_pixel(rtgui_color_t *c, int x, int y) {           \
+    rtgui_color_t pixel;                                                    \
+                                                                            \
+    graphic_ops()->get_pixel(&pixel, x, y);                                 \
+    *c = from_native(pixel);                                                \
+}                                                                           \
+                                                                            \
+static void _##name##_draw_hline(rtgui_color_t *c, int x1, int x2, int y) { \
+    rtgui_color_t pixel = (rtgui_color_t)to_native(*c);                     \
+    graphic_ops()->draw_hline(&pixel, x1, x2, y);                           \
+}                                                                           \
+                                                                            \
+static void _##name##_draw_vline(rtgui_color_t *c, int x, int y1, int y2) { \
+    rtgui_color_t pixel = (rtgui_color_t)to_native(*c);                     \
+    graphic_ops()->draw_vline(&pixel, x, y1, y2);                           \
+}                                                                           \
+                                                                            \
+static void _##name##_fill_rect(rtgui_color_t *c, rtgui_rect_t *rect) {     \
+    rtgui_color_t pixel = (rtgui_color_t)to_native(*c);                     \
+    _fill_rect(&pixel, rect);                                               \
+}                                                                           \
+                                                                            \
+static void _##name##_read_raw_hline(rt_uint8_t *pixels, int x1, int x2,    \
+    int y) {                                                                \
+    rtgui_color_t pixel;                                                    \
+    int x;                                                                  \
+                                                                            \
+    if (graphic_ops()->read_raw_hline) {                                    \
+        graphic_ops()->read_raw_hline(pixels, x1, x2, y);                   \
+        return;                                                             \
+    }                                                                       \
+    for (x = x1; x < x2; x++) {                                             \
+        graphic_ops()->get_pixel(&pixel, x, y);                             \
+        pixel = (rtgui_color_t)to_native(from_native(pixel));               \
+        _put_raw_pixel(pixels, x - x1, pixel);                              \
+    }                                                                       \
+}                                                                           \
+                                                                            \
+static const struct rtgui_graphic_driver_ops _##name##_ops = {             \
+    _##name##_set_pixel,                                                    \
+    _##name##_get_pixel,                                                    \
+    _##name##_draw_hline,                                                   \
+    _##name##_draw_vline,                                                   \
+    _draw_raw_hline,                                                        \
+    _##name##_fill_rect,                                                    \
+    _blit_rect,                                                             \
+    _##name##_read_raw_hline,                                               \
+};
 
-static void _rgb888_draw_vline(rtgui_color_t *c, int x, int y1, int y2) {
-    rtgui_color_t pixel = (rtgui_color_t)rtgui_color_to_888(*c);
-    graphic_ops()->draw_vline(&pixel, x, y1, y2);
-}
+_PIXEL_FORMATS(_DEFINE_PIXEL_OPS)
 
-static const struct rtgui_graphic_driver_ops _rgb888_ops = {
-    _rgb888_set_pixel,
-    _rgb888_get_pixel,
-    _rgb888_draw_hline,
-    _rgb888_draw_vline,
-    _draw_raw_hline,
-};
-#endif /* CONFIG_USING_RGB888 */
+#undef _DEFINE_PIXEL_OPS
 
 static const struct rtgui_graphic_driver_ops *_get_pixel_ops(rt_uint32_t fmt) {
     switch (fmt) {
 
-    #if (CONFIG_USING_MONO)
-    case RTGRAPHIC_PIXEL_FORMAT_MONO:
-        return &_mono_ops;
-    #endif
+    #define _PIXEL_OPS_CASE(name, format, to_native, from_native) \
+    case RTGRAPHIC_PIXEL_FORMAT_##format:                           \
+        return &_##name##_ops;
 
-    #if (CONFIG_USING_RGB565)
-    case RTGRAPHIC_PIXEL_FORMAT_RGB565:
-        return &_rgb565_ops;
-    #endif
+    _PIXEL_FORMATS(_PIXEL_OPS_CASE)
 
-    #if (CONFIG_USING_RGB565P)
-    case RTGRAPHIC_PIXEL_FORMAT_RGB565P:
-        return &_rgb565p_ops;
-    #endif
-
-    #if (CONFIG_USING_RGB888)
-    case RTGRAPHIC_PIXEL_FORMAT_RGB888:
-        return &_rgb888_ops;
-    #endif
+    #undef _PIXEL_OPS_CASE
 
     default:
         return RT_NULL;
@@ -317,6 +401,18 @@ static void _frame_mono_draw_raw_hline(rt_uint8_t *pixels, int x1, int x2,
     }
 }
 
+static void _frame_mono_read_raw_hline(rt_uint8_t *pixels, int x1, int x2,
+    int y) {
+    rt_uint8_t *ptr = &BUFFER()[(y >> 3) * WIDTH() + x1];
+    rt_uint8_t mask = 1 << (y & 0x07);
+    int i;
+
+    rt_memset(pixels, 0x00, _BIT2BYTE(x2 - x1));
+    for (i = 0; i < (x2 - x1); i++, ptr++) {
+        if (*ptr & mask)
+            pixels[i >> 3] |= (1 << (i & 0x07));
+    }
+}
 
 const struct rtgui_graphic_driver_ops _frame_mono_ops = {
     _frame_mono_set_pixel,
@@ -324,6 +420,9 @@ const struct rtgui_graphic_driver_ops _frame_mono_ops = {
     _frame_mono_draw_hline,
     _frame_mono_draw_vline,
     _frame_mono_draw_raw_hline,
+    RT_NULL,
+    RT_NULL,
+    _frame_mono_read_raw_hline,
 };
 
 #undef BUFFER
@@ -341,6 +440,99 @@ static void _frame_draw_raw_hline(rt_uint8_t *pixels, int x1, int x2, int y) {
     rt_memcpy(ptr, pixels,
         (x2 - x1) * _BIT2BYTE(display()->bits_per_pixel));
 }
+
+static void _frame_read_raw_hline(rt_uint8_t *pixels, int x1, int x2, int y) {
+    rt_uint8_t *ptr = (rt_uint8_t *)PIXEL(x1, y);
+
+    rt_memcpy(pixels, ptr,
+        (x2 - x1) * _BIT2BYTE(display()->bits_per_pixel));
+}
+
+static void _frame_blit_rect(rt_uint8_t *pixels, rt_uint32_t pitch,
+    rtgui_rect_t *rect) {
+    rt_uint8_t *ptr = (rt_uint8_t *)PIXEL(rect->x1, rect->y1);
+    rt_uint32_t len = (rect->x2 - rect->x1) * \
+        _BIT2BYTE(display()->bits_per_pixel);
+    int y;
+
+    for (y = rect->y1; y < rect->y2; y++) {
+        rt_memcpy(ptr, pixels, len);
+        ptr += display()->pitch;
+        pixels += pitch;
+    }
+}
+#endif
+
+/* spans shorter than this (in bytes) are faster by the plain loop */
+#define FILL_SPAN_MIN               (64)
+
+#if (CONFIG_USING_RGB565 || CONFIG_USING_RGB565P)
+/* fill a span of 16-bit pixels: align to double word, then store 4 pixels a
+   time */
+rt_inline void _frame_fill_span16(rt_uint16_t *ptr, rt_uint16_t pixel,
+    rt_base_t len) {
+    rt_uint64_t *dword;
+    rt_uint64_t pixels;
+
+    if (len < (FILL_SPAN_MIN >> 1)) {
+        for (; len > 0; len--)
+            *ptr++ = pixel;
+        return;
+    }
+
+    for (; (len > 0) && ((rt_ubase_t)ptr & 0x06); len--)
+        *ptr++ = pixel;
+
+    dword = (rt_uint64_t *)ptr;
+    pixels = ((rt_uint32_t)pixel << 16) | pixel;
+    pixels |= pixels << 32;
+    for (; len >= 16; len -= 16, dword += 4) {
+        dword[0] = pixels;
+        dword[1] = pixels;
+        dword[2] = pixels;
+        dword[3] = pixels;
+    }
+    for (; len >= 4; len -= 4)
+        *dword++ = pixels;
+
+    for (ptr = (rt_uint16_t *)dword; len > 0; len--)
+        *ptr++ = pixel;
+}
+#endif
+
+#if (CONFIG_USING_RGB888 || CONFIG_USING_ARGB888)
+/* fill a span of 32-bit pixels: align to double word, then store 2 pixels a
+   time */
+rt_inline void _frame_fill_span32(rt_uint32_t *ptr, rt_uint32_t pixel,
+    rt_base_t len) {
+    rt_uint64_t *dword;
+    rt_uint64_t pixels;
+
+    if (len < (FILL_SPAN_MIN >> 2)) {
+        for (; len > 0; len--)
+            *ptr++ = pixel;
+        return;
+    }
+
+    if ((len > 0) && ((rt_ubase_t)ptr & 0x04)) {
+        *ptr++ = pixel;
+        len--;
+    }
+
+    dword = (rt_uint64_t *)ptr;
+    pixels = ((rt_uint64_t)pixel << 32) | pixel;
+    for (; len >= 8; len -= 8, dword += 4) {
+        dword[0] = pixels;
+        dword[1] = pixels;
+        dword[2] = pixels;
+        dword[3] = pixels;
+    }
+    for (; len >= 2; len -= 2)
+        *dword++ = pixels;
+
+    if (len > 0)
+        *(rt_uint32_t *)dword = pixel;
+}
 #endif
 
 #if (CONFIG_USING_RGB565)
@@ -354,21 +546,28 @@ static void _frame_rgb565_get_pixel(rtgui_color_t *c, int x, int y) {
 }
 
 static void _frame_rgb565_draw_hline(rtgui_color_t *c, int x1, int x2, int y) {
+    _frame_fill_span16((rt_uint16_t *)PIXEL(x1, y), rtgui_color_to_565(*c),
+        x2 - x1);
+}
+
+static void _frame_rgb565_draw_vline(rtgui_color_t *c, int x , int y1, int y2) {
     rt_uint16_t pixel = rtgui_color_to_565(*c);
-    rt_uint16_t *ptr = (rt_uint16_t *)PIXEL(x1, y);
-    int x;
+    rt_uint8_t *ptr = (rt_uint8_t *)PIXEL(x, y1);
+    rt_uint32_t pitch = display()->pitch;
+    int y;
 
-    for (x = x1; x < x2; x++, ptr++)
-        *ptr = pixel;
+    for (y = y1; y < y2; y++, ptr += pitch)
+        *(rt_uint16_t *)ptr = pixel;
 }
 
-static void _frame_rgb565_draw_vline(rtgui_color_t *c, int x , int y1, int y2) {
+static void _frame_rgb565_fill_rect(rtgui_color_t *c, rtgui_rect_t *rect) {
     rt_uint16_t pixel = rtgui_color_to_565(*c);
-    rt_uint16_t *ptr = (rt_uint16_t *)PIXEL(x, y1);
+    rt_uint8_t *line = (rt_uint8_t *)PIXEL(rect->x1, rect->y1);
+    rt_uint32_t pitch = display()->pitch;
     int y;
 
-    for (y = y1; y < y2; y++, ptr += display()->width)
-        *ptr = pixel;
+    for (y = rect->y1; y < rect->y2; y++, line += pitch)
+        _frame_fill_span16((rt_uint16_t *)line, pixel, rect->x2 - rect->x1);
 }
 
 const struct rtgui_graphic_driver_ops _frame_rgb565_ops = {
@@ -377,6 +576,9 @@ const struct rtgui_graphic_driver_ops _frame_rgb565_ops = {
     _frame_rgb565_draw_hline,
     _frame_rgb565_draw_vline,
     _frame_draw_raw_hline,
+    _frame_rgb565_fill_rect,
+    _frame_blit_rect,
+    _frame_read_raw_hline,
 };
 #endif /* CONFIG_USING_RGB565 */
 
@@ -391,21 +593,28 @@ static void _frame_rgb565p_get_pixel(rtgui_color_t *c, int x, int y) {
 }
 
 static void _frame_rgb565p_draw_hline(rtgui_color_t *c, int x1, int x2, int y) {
+    _frame_fill_span16((rt_uint16_t *)PIXEL(x1, y), rtgui_color_to_565p(*c),
+        x2 - x1);
+}
+
+static void _frame_rgb565p_draw_vline(rtgui_color_t *c, int x, int y1, int y2) {
     rt_uint16_t pixel = rtgui_color_to_565p(*c);
-    rt_uint16_t *ptr = (rt_uint16_t *)PIXEL(x1, y);
-    int x;
+    rt_uint8_t *ptr = (rt_uint8_t *)PIXEL(x, y1);
+    rt_uint32_t pitch = display()->pitch;
+    int y;
 
-    for (x = x1; x < x2; x++, ptr++)
-        *ptr = pixel;
+    for (y = y1; y < y2; y++, ptr += pitch)
+        *(rt_uint16_t *)ptr = pixel;
 }
 
-static void _frame_rgb565p_draw_vline(rtgui_color_t *c, int x, int y1, int y2) {
+static void _frame_rgb565p_fill_rect(rtgui_color_t *c, rtgui_rect_t *rect) {
     rt_uint16_t pixel = rtgui_color_to_565p(*c);
-    rt_uint16_t *ptr = (rt_uint16_t *)PIXEL(x, y1);
+    rt_uint8_t *line = (rt_uint8_t *)PIXEL(rect->x1, rect->y1);
+    rt_uint32_t pitch = display()->pitch;
     int y;
 
-    for (y = y1; y < y2; y++, ptr += display()->width)
-        *ptr = pixel;
+    for (y = rect->y1; y < rect->y2; y++, line += pitch)
+        _frame_fill_span16((rt_uint16_t *)line, pixel, rect->x2 - rect->x1);
 }
 
 const struct rtgui_graphic_driver_ops _frame_rgb565p_ops = {
@@ -414,6 +623,9 @@ const struct rtgui_graphic_driver_ops _frame_rgb565p_ops = {
     _frame_rgb565p_draw_hline,
     _frame_rgb565p_draw_vline,
     _frame_draw_raw_hline,
+    _frame_rgb565p_fill_rect,
+    _frame_blit_rect,
+    _frame_read_raw_hline,
 };
 #endif /* CONFIG_USING_RGB565P */
 
@@ -434,36 +646,48 @@ static void _frame_rgb888_get_pixel(rtgui_color_t *c, int x, int y) {
     #endif
 }
 
-static void _frame_rgb888_draw_hline(rtgui_color_t *c, int x1, int x2, int y) {
-    rtgui_color_t *ptr = (rtgui_color_t *)PIXEL(x1, y);
-    int x;
+#ifdef RTGUI_USING_RGB888_AS_32BIT
+# define RGB888_PIXEL(c)            (c)
+#else
+# define RGB888_PIXEL(c)            ((c) & 0x00ffffff)
+#endif
 
-    for (x = x1; x < x2; x++, ptr++)
-        #ifdef RTGUI_USING_RGB888_AS_32BIT
-            *ptr = *c;
-        #else
-            *ptr = *c & 0x00ffffff;
-        #endif
+static void _frame_rgb888_draw_hline(rtgui_color_t *c, int x1, int x2, int y) {
+    _frame_fill_span32((rt_uint32_t *)PIXEL(x1, y), RGB888_PIXEL(*c),
+        x2 - x1);
 }
 
 static void _frame_rgb888_draw_vline(rtgui_color_t *c, int x, int y1, int y2) {
-    rtgui_color_t *ptr = (rtgui_color_t *)PIXEL(x, y1);
+    rtgui_color_t pixel = RGB888_PIXEL(*c);
+    rt_uint8_t *ptr = (rt_uint8_t *)PIXEL(x, y1);
+    rt_uint32_t pitch = display()->pitch;
     int y;
 
-    for (y = y1; y < y2; y++, ptr += display()->width)
-        #ifdef RTGUI_USING_RGB888_AS_32BIT
-            *ptr = *c;
-        #else
-            *ptr = *c & 0x00ffffff;
-        #endif
+    for (y = y1; y < y2; y++, ptr += pitch)
+        *(rtgui_color_t *)ptr = pixel;
 }
 
+static void _frame_rgb888_fill_rect(rtgui_color_t *c, rtgui_rect_t *rect) {
+    rtgui_color_t pixel = RGB888_PIXEL(*c);
+    rt_uint8_t *line = (rt_uint8_t *)PIXEL(rect->x1, rect->y1);
+    rt_uint32_t pitch = display()->pitch;
+    int y;
+
+    for (y = rect->y1; y < rect->y2; y++, line += pitch)
+        _frame_fill_span32((rt_uint32_t *)line, pixel, rect->x2 - rect->x1);
+}
+
+#undef RGB888_PIXEL
+
 const struct rtgui_graphic_driver_ops _frame_rgb888_ops = {
     _frame_rgb888_set_pixel,
     _frame_rgb888_get_pixel,
     _frame_rgb888_draw_hline,
     _frame_rgb888_draw_vline,
     _frame_draw_raw_hline,
+    _frame_rgb888_fill_rect,
+    _frame_blit_rect,
+    _frame_read_raw_hline,
 };
 #endif /* CONFIG_USING_RGB888 */
 
@@ -473,23 +697,30 @@ static void _frame_argb888_set_pixel(rtgui_color_t *c, int x, int y) {
 }
 
 static void _frame_argb888_get_pixel(rtgui_color_t *c, int x, int y) {
-    *(rtgui_color_t *)PIXEL(x, y) = *c;
+    *c = *(rtgui_color_t *)PIXEL(x, y);
 }
 
 static void _frame_argb888_draw_hline(rtgui_color_t *c, int x1, int x2, int y) {
-    rtgui_color_t *ptr = (rtgui_color_t *)PIXEL(x1, y);
-    int x;
-
-    for (x = x1; x < x2; x++, ptr++)
-        *ptr = *c;
+    _frame_fill_span32((rt_uint32_t *)PIXEL(x1, y), *c, x2 - x1);
 }
 
 static void _frame_argb888_draw_vline(rtgui_color_t *c, int x, int y1, int y2) {
-    rtgui_color_t *ptr = (rtgui_color_t *)PIXEL(x, y1);
+    rtgui_color_t pixel = *c;
+    rt_uint8_t *ptr = (rt_uint8_t *)PIXEL(x, y1);
+    rt_uint32_t pitch = display()->pitch;
+    int y;
+
+    for (y = y1; y < y2; y++, ptr += pitch)
+        *(rtgui_color_t *)ptr = pixel;
+}
+
+static void _frame_argb888_fill_rect(rtgui_color_t *c, rtgui_rect_t *rect) {
+    rt_uint8_t *line = (rt_uint8_t *)PIXEL(rect->x1, rect->y1);
+    rt_uint32_t pitch = display()->pitch;
     int y;
 
-    for (y = y1; y < y2; y++, ptr += display()->width)
-        *ptr = *c;
+    for (y = rect->y1; y < rect->y2; y++, line += pitch)
+        _frame_fill_span32((rt_uint32_t *)line, *c, rect->x2 - rect->x1);
 }
 
 const struct rtgui_graphic_driver_ops _frame_argb888_ops = {
@@ -498,6 +729,9 @@ const struct rtgui_graphic_driver_ops _frame_argb888_ops = {
     _frame_argb888_draw_hline,
     _frame_argb888_draw_vline,
     _frame_draw_raw_hline,
+    _frame_argb888_fill_rect,
+    _frame_blit_rect,
+    _frame_read_raw_hline,
 };
 #endif /* CONFIG_USING_ARGB888 */
 
@@ -542,6 +776,395 @@ static const struct rtgui_graphic_driver_ops *_get_frame_ops(rt_uint32_t fmt) {
 
 #endif /* RTGUI_USING_FRAMEBUFFER */
 
+#ifdef RTGUI_USING_BAND_BUFFER
+static void _band_mark(int x1, int x2, int y) {
+    rt_uint8_t *mask = BAND_MASK(y);
+
+    x1 -= _band.rect.x1;
+    x2 -= _band.rect.x1;
+    for (; (x1 < x2) && (x1 & 0x07); x1++)
+        mask[x1 >> 3] |= 1 << (x1 & 0x07);
+    for (; (x1 + 8) <= x2; x1 += 8)
+        mask[x1 >> 3] = 0xff;
+    for (; x1 < x2; x1++)
+        mask[x1 >> 3] |= 1 << (x1 & 0x07);
+}
+
+/* the span is already clipped */
+static void _band_fill(rtgui_color_t *c, int x1, int x2, int y) {
+    rt_uint8_t *ptr = BAND_PIXEL(x1, y);
+    int x;
+
+    if (_band.bpp == 2) {
+        for (x = x1; x < x2; x++, ptr += 2)
+            *(rt_uint16_t *)ptr = (rt_uint16_t)*c;
+    } else {
+        for (x = x1; x < x2; x++, ptr += 4)
+            *(rt_uint32_t *)ptr = (rt_uint32_t)*c;
+    }
+    _band_mark(x1, x2, y);
+}
+
+static void _band_set_pixel(rtgui_color_t *c, int x, int y) {
+    if ((x < _band.rect.x1) || (x >= _band.rect.x2) || \
+        (y < _band.rect.y1) || (y >= _band.rect.y2))
+        return;
+    _band_fill(c, x, x + 1, y);
+}
+
+/* pixels drawn in current band are read from band, others from device */
+static void _band_get_pixel(rtgui_color_t *c, int x, int y) {
+    if ((x >= _band.rect.x1) && (x < _band.rect.x2) && \
+        (y >= _band.rect.y1) && (y < _band.rect.y2) && \
+        BAND_IS_SET(BAND_MASK(y), x - _band.rect.x1)) {
+        if (_band.bpp == 2)
+            *c = *(rt_uint16_t *)BAND_PIXEL(x, y);
+        else
+            *c = *(rt_uint32_t *)BAND_PIXEL(x, y);
+        #if (CONFIG_USING_RGB565)
+            /* same as RGB565 device, return rtgui color */
+            if (RTGRAPHIC_PIXEL_FORMAT_RGB565 == _gfx_drv.pixel_format)
+                *c = rtgui_color_from_565((rt_uint16_t)*c);
+        #endif
+        return;
+    }
+    _band.dev_ops->get_pixel(c, x, y);
+}
+
+/* pixel from device get_pixel() to raw pixel */
+static rtgui_color_t _band_raw_pixel(rtgui_color_t pixel) {
+    switch (_gfx_drv.pixel_format) {
+
+    #define _BAND_RAW_CASE(name, format, to_native, from_native) \
+    case RTGRAPHIC_PIXEL_FORMAT_##format:                           \
+        return (rtgui_color_t)to_native(from_native(pixel));
+
+    _PIXEL_FORMATS(_BAND_RAW_CASE)
+
+    #undef _BAND_RAW_CASE
+
+    default:
+        return pixel;
+    }
+}
+
+static void _band_read_raw_hline(rt_uint8_t *pixels, int x1, int x2, int y) {
+    rtgui_color_t pixel;
+    rt_uint8_t *mask;
+    int x, start;
+
+    if (_band.dev_ops->read_raw_hline) {
+        _band.dev_ops->read_raw_hline(pixels, x1, x2, y);
+    } else {
+        for (x = x1; x < x2; x++) {
+            _band.dev_ops->get_pixel(&pixel, x, y);
+            _put_raw_pixel(pixels, x - x1, _band_raw_pixel(pixel));
+        }
+    }
+    if ((y < _band.rect.y1) || (y >= _band.rect.y2)) return;
+
+    /* overlay the drawn runs */
+    mask = BAND_MASK(y);
+    x = _MAX(x1, _band.rect.x1) - _band.rect.x1;
+    x2 = _MIN(x2, _band.rect.x2) - _band.rect.x1;
+    while (x < x2) {
+        for (; (x < x2) && !BAND_IS_SET(mask, x); x++);
+        for (start = x; (x < x2) && BAND_IS_SET(mask, x); x++);
+        if (start < x)
+            rt_memcpy(pixels + (_band.rect.x1 + start - x1) * _band.bpp,
+                BAND_PIXEL(_band.rect.x1 + start, y), (x - start) * _band.bpp);
+    }
+}
+
+static void _band_draw_hline(rtgui_color_t *c, int x1, int x2, int y) {
+    if ((y < _band.rect.y1) || (y >= _band.rect.y2)) return;
+    if (x1 < _band.rect.x1) x1 = _band.rect.x1;
+    if (x2 > _band.rect.x2) x2 = _band.rect.x2;
+    if (x1 >= x2) return;
+    _band_fill(c, x1, x2, y);
+}
+
+static void _band_draw_vline(rtgui_color_t *c, int x, int y1, int y2) {
+    if ((x < _band.rect.x1) || (x >= _band.rect.x2)) return;
+    if (y1 < _band.rect.y1) y1 = _band.rect.y1;
+    if (y2 > _band.rect.y2) y2 = _band.rect.y2;
+    for (; y1 < y2; y1++)
+        _band_fill(c, x, x + 1, y1);
+}
+
+static void _band_draw_raw_hline(rt_uint8_t *pixels, int x1, int x2, int y) {
+    if ((y < _band.rect.y1) || (y >= _band.rect.y2)) return;
+    if (x1 < _band.rect.x1) {
+        pixels += (_band.rect.x1 - x1) * _band.bpp;
+        x1 = _band.rect.x1;
+    }
+    if (x2 > _band.rect.x2) x2 = _band.rect.x2;
+    if (x1 >= x2) return;
+    rt_memcpy(BAND_PIXEL(x1, y), pixels, (x2 - x1) * _band.bpp);
+    _band_mark(x1, x2, y);
+}
+
+static void _band_fill_rect(rtgui_color_t *c, rtgui_rect_t *rect) {
+    int y;
+
+    for (y = rect->y1; y < rect->y2; y++)
+        _band_draw_hline(c, rect->x1, rect->x2, y);
+}
+
+static void _band_blit_rect(rt_uint8_t *pixels, rt_uint32_t pitch,
+    rtgui_rect_t *rect) {
+    int y;
+
+    for (y = rect->y1; y < rect->y2; y++, pixels += pitch)
+        _band_draw_raw_hline(pixels, rect->x1, rect->x2, y);
+}
+
+static const struct rtgui_graphic_driver_ops _band_ops = {
+    _band_set_pixel,
+    _band_get_pixel,
+    _band_draw_hline,
+    _band_draw_vline,
+    _band_draw_raw_hline,
+    _band_fill_rect,
+    _band_blit_rect,
+    _band_read_raw_hline,
+};
+
+/* send drawn pixels of current band to device */
+static void _band_flush(void) {
+    rtgui_rect_t *rect = &_band.rect;
+    rt_uint8_t *mask;
+    int w, x, start, y;
+    rt_bool_t full;
+
+    w = rect->x2 - rect->x1;
+
+    /* one bulk transfer if all pixels are drawn */
+    full = RT_TRUE;
+    for (y = rect->y1; full && (y < rect->y2); y++) {
+        mask = BAND_MASK(y);
+        for (x = 0; x < w; x++) {
+            if (!BAND_IS_SET(mask, x)) {
+                full = RT_FALSE;
+                break;
+            }
+        }
+    }
+    if (full && _band.dev_ops->blit_rect) {
+        _band.dev_ops->blit_rect(_band.pixels, _band.pitch, rect);
+        return;
+    }
+
+    /* otherwise send drawn runs line by line */
+    for (y = rect->y1; y < rect->y2; y++) {
+        mask = BAND_MASK(y);
+        for (x = 0; x < w; ) {
+            for (; (x < w) && !BAND_IS_SET(mask, x); x++);
+            for (start = x; (x < w) && BAND_IS_SET(mask, x); x++);
+            if (start < x)
+                _band.dev_ops->draw_raw_hline(
+                    BAND_PIXEL(rect->x1 + start, y),
+                    rect->x1 + start, rect->x1 + x, y);
+        }
+    }
+}
+
+static void _band_init(void) {
+    rt_uint8_t bpp = _BIT2BYTE(_gfx_drv.bits_per_pixel);
+
+    if (_band.pixels) rtgui_free(_band.pixels);
+    if (_band.mask) rtgui_free(_band.mask);
+    _band.pixels = RT_NULL;
+    _band.mask = RT_NULL;
+
+    /* only for device without framebuffer and 16/32-bit pixel */
+    if (_gfx_drv.framebuffer || ((bpp != 2) && (bpp != 4))) return;
+
+    _band.bpp = bpp;
+    _band.pixels = rtgui_malloc(_gfx_drv.width * bpp * RTGUI_BAND_HEIGHT);
+    _band.mask = rtgui_malloc(_BIT2BYTE(_gfx_drv.width) * RTGUI_BAND_HEIGHT);
+    if (!_band.pixels || !_band.mask) {
+        LOG_E("no mem for band");
+        if (_band.pixels) rtgui_free(_band.pixels);
+        if (_band.mask) rtgui_free(_band.mask);
+        _band.pixels = RT_NULL;
+        _band.mask = RT_NULL;
+    }
+}
+#endif /* RTGUI_USING_BAND_BUFFER */
+
+#ifdef RTGUI_USING_ASYNC_UPDATE
+static void _update_entry(void *param) {
+    struct rt_device_rect_info info;
+    rtgui_rect_t rect;
+    (void)param;
+
+    while (1) {
+        if (RT_EOK != rt_sem_take(&_update_ready, RT_WAITING_FOREVER))
+            continue;
+
+        rt_mutex_take(&_update_lock, RT_WAITING_FOREVER);
+        info = _update_queue[_update_head];
+        rt_mutex_release(&_update_lock);
+
+        rt_device_control(_gfx_drv.device, RTGRAPHIC_CTRL_RECT_UPDATE, &info);
+
+        /* remove from queue after sent */
+        rt_mutex_take(&_update_lock, RT_WAITING_FOREVER);
+        _update_head = (_update_head + 1) % RTGUI_UPDATE_QUEUE_SIZE;
+        _update_num--;
+        rt_mutex_release(&_update_lock);
+        rt_sem_release(&_update_free);
+        (void)rt_event_send(&_update_done, UPDATE_DONE_FLAG);
+
+        if (_update_hook) {
+            rect.x1 = info.x;
+            rect.y1 = info.y;
+            rect.x2 = info.x + info.width;
+            rect.y2 = info.y + info.height;
+            _update_hook(&rect);
+        }
+    }
+}
+
+static rt_err_t _update_init(void) {
+    rt_thread_t tid;
+    rt_err_t ret;
+
+    do {
+        ret = rt_mutex_init(&_update_lock, "update", RT_IPC_FLAG_FIFO);
+        if (RT_EOK != ret) break;
+        ret = rt_sem_init(&_update_free, "upd_free", RTGUI_UPDATE_QUEUE_SIZE,
+            RT_IPC_FLAG_FIFO);
+        if (RT_EOK != ret) break;
+        ret = rt_sem_init(&_update_ready, "upd_rdy", 0, RT_IPC_FLAG_FIFO);
+        if (RT_EOK != ret) break;
+        ret = rt_event_init(&_update_done, "upd_done", RT_IPC_FLAG_FIFO);
+        if (RT_EOK != ret) break;
+
+        tid = rt_thread_create(
+            "gui_upd",
+            _update_entry, RT_NULL,
+            RTGUI_UPDATE_STACK_SIZE,
+            RTGUI_UPDATE_PRIORITY,
+            RTGUI_SERVER_TIMESLICE);
+        if (!tid) {
+            ret = -RT_ENOMEM;
+            break;
+        }
+        rt_thread_startup(tid);
+        _update_inited = RT_TRUE;
+    } while (0);
+
+    if (RT_EOK != ret) {
+        LOG_E("create update thread err");
+    }
+    return ret;
+}
+
+static void _update_enqueue(struct rt_device_rect_info *info) {
+    /* wait when queue is full */
+    rt_sem_take(&_update_free, RT_WAITING_FOREVER);
+
+    rt_mutex_take(&_update_lock, RT_WAITING_FOREVER);
+    _update_queue[(_update_head + _update_num) % RTGUI_UPDATE_QUEUE_SIZE] = \
+        *info;
+    _update_num++;
+    rt_mutex_release(&_update_lock);
+    rt_sem_release(&_update_ready);
+}
+#endif /* RTGUI_USING_ASYNC_UPDATE */
+
+#ifdef RTGUI_USING_DOUBLE_BUFFER
+static void _double_buffer_init(void) {
+    rt_size_t size;
+
+    if (_back_buffer) rtgui_free(_back_buffer);
+    _back_buffer = RT_NULL;
+    _flip_support = RT_TRUE;
+
+    /* not for mono */
+    if (!_gfx_drv.framebuffer || (_gfx_drv.bits_per_pixel < 8)) return;
+
+    size = _gfx_drv.pitch * _gfx_drv.height;
+    _back_buffer = rtgui_malloc(size);
+    if (!_back_buffer) {
+        LOG_E("no mem for back buffer");
+        return;
+    }
+    rt_memcpy(_back_buffer, _gfx_drv.scanout, size);
+    _gfx_drv.framebuffer = _back_buffer;
+}
+
+static void _double_buffer_copy(rt_uint8_t *dst, rt_uint8_t *src,
+    struct rt_device_rect_info *info) {
+    rt_uint32_t offset, len, y;
+
+    offset = _gfx_drv.pitch * info->y + \
+        _BIT2BYTE(_gfx_drv.bits_per_pixel) * info->x;
+    len = _BIT2BYTE(_gfx_drv.bits_per_pixel) * info->width;
+    dst += offset;
+    src += offset;
+    for (y = 0; y < info->height; y++) {
+        rt_memcpy(dst, src, len);
+        dst += _gfx_drv.pitch;
+        src += _gfx_drv.pitch;
+    }
+}
+
+/* show back buffer by swapping scan-out address */
+static rt_bool_t _double_buffer_flip(rtgui_rect_t *rects, rt_uint32_t num) {
+    struct rt_device_rect_info info;
+    rt_uint8_t *back;
+    rt_uint32_t idx;
+
+    if (!_flip_support || (_gfx_drv.scanout == _gfx_drv.framebuffer))
+        return RT_FALSE;
+    /* not swap when drawing */
+    if (RT_EOK != rtgui_screen_lock(RT_WAITING_NO)) return RT_FALSE;
+
+    if (RT_EOK != rt_device_control(_gfx_drv.device, RTGUI_GRAPHIC_CTRL_FLIP,
+        _gfx_drv.framebuffer)) {
+        _flip_support = RT_FALSE;
+        rtgui_screen_unlock();
+        return RT_FALSE;
+    }
+
+    back = _gfx_drv.scanout;
+    _gfx_drv.scanout = _gfx_drv.framebuffer;
+    _gfx_drv.framebuffer = back;
+    /* sync the new back buffer */
+    rtgui_gfx_fence_screen(&_gfx_drv, RT_NULL);
+    /* remove overlay from the old scanout */
+    if (_overlay_hook) {
+        rtgui_rect_t area;
+
+        rtgui_gfx_get_rect(&_gfx_drv, &area);
+        rtgui_rect_intersect(&_overlay_rect, &area);
+        if ((area.x1 < area.x2) && (area.y1 < area.y2)) {
+            info.x = area.x1;
+            info.y = area.y1;
+            info.width = area.x2 - area.x1;
+            info.height = area.y2 - area.y1;
+            _double_buffer_copy(_gfx_drv.framebuffer, _gfx_drv.scanout,
+                &info);
+        }
+    }
+    for (idx = 0; idx < num; idx++) {
+        info.x = rects[idx].x1;
+        info.y = rects[idx].y1;
+        info.width = rects[idx].x2 - rects[idx].x1;
+        info.height = rects[idx].y2 - rects[idx].y1;
+        _double_buffer_copy(_gfx_drv.framebuffer, _gfx_drv.scanout, &info);
+    }
+    /* new scanout has no overlay */
+    if (_overlay_hook) _overlay_hook(RT_NULL);
+
+    rtgui_screen_unlock();
+    return RT_TRUE;
+}
+#endif /* RTGUI_USING_DOUBLE_BUFFER */
+
 /* Public functions ----------------------------------------------------------*/
 rt_err_t rtgui_set_gfx_device(rt_device_t dev) {
     struct rt_device_graphic_info info;
@@ -555,6 +1178,21 @@ rt_err_t rtgui_set_gfx_device(rt_device_t dev) {
         ret = rt_device_control(dev, RTGRAPHIC_CTRL_GET_INFO, &info);
         if (RT_EOK != ret) break;
 
+        #ifdef RTGUI_USING_ASYNC_UPDATE
+            if (!_update_inited) {
+                ret = _update_init();
+                if (RT_EOK != ret) break;
+            }
+        #endif
+
+        /* init damage region */
+        if (!_damage_inited) {
+            ret = rt_mutex_init(&_damage_lock, "damage", RT_IPC_FLAG_FIFO);
+            if (RT_EOK != ret) break;
+            rtgui_region_init_empty(&_damage);
+            _damage_inited = RT_TRUE;
+        }
+
         /* check if not init */
         if (!_gfx_drv.width || !_gfx_drv.height) {
             rtgui_rect_t rect;
@@ -575,6 +1213,10 @@ rt_err_t rtgui_set_gfx_device(rt_device_t dev) {
         _gfx_drv.bits_per_pixel = info.bits_per_pixel;
         _gfx_drv.pitch = _gfx_drv.width / 8 * _gfx_drv.bits_per_pixel;
         _gfx_drv.framebuffer = info.framebuffer;
+        _gfx_drv.scanout = info.framebuffer;
+        #ifdef RTGUI_USING_DOUBLE_BUFFER
+            _double_buffer_init();
+        #endif
 
         /* get extent ops */
         ret = rt_device_control(dev, RTGRAPHIC_CTRL_GET_EXT, &_gfx_drv.ext_ops);
@@ -582,23 +1224,32 @@ rt_err_t rtgui_set_gfx_device(rt_device_t dev) {
             _gfx_drv.ext_ops = RT_NULL;
             ret = RT_EOK;
         }
+        #ifdef RTGUI_USING_DOUBLE_BUFFER
+            /* device draws to scanout, not to back buffer */
+            if (_back_buffer) _gfx_drv.ext_ops = RT_NULL;
+        #endif
 
         /* get ops */
-        if (!_gfx_drv.framebuffer) {
-            _gfx_drv.ops = _get_pixel_ops(_gfx_drv.pixel_format);
-        } else {
-            #ifdef RTGUI_USING_FRAMEBUFFER
+        _gfx_drv.native_ops = \
+            (const struct rtgui_graphic_driver_ops *)dev->user_data;
+        _gfx_drv.ops = _get_pixel_ops(_gfx_drv.pixel_format);
+        #ifdef RTGUI_USING_FRAMEBUFFER
+            if (_gfx_drv.framebuffer) {
+                /* framebuffer ops take rtgui color */
                 _gfx_drv.ops = _get_frame_ops(_gfx_drv.pixel_format);
-            #else
-                _gfx_drv.ops = _get_pixel_ops(_gfx_drv.pixel_format);
-            #endif
-        }
-        if (!_gfx_drv.ops) {
+                _gfx_drv.native_ops = _gfx_drv.ops;
+            }
+        #endif
+        if (!_gfx_drv.ops || !_gfx_drv.native_ops) {
             LOG_E("no gfx ops");
             ret = -RT_ERROR;
             break;
         }
 
+        #ifdef RTGUI_USING_BAND_BUFFER
+            _band_init();
+        #endif
+
         #ifdef RTGUI_USING_HW_CURSOR
             rtgui_cursor_set_image(RTGUI_CURSOR_ARROW);
         #endif
@@ -610,6 +1261,30 @@ RTM_EXPORT(rtgui_set_gfx_device);
 
 RTGUI_REFERENCE_GETTER(gfx_device, rtgui_gfx_driver_t, &_gfx_drv);
 
+rtgui_color_t rtgui_gfx_raw_color(rtgui_color_t c) {
+    switch (_gfx_drv.pixel_format) {
+
+    #define _RAW_COLOR_CASE(name, format, to_native, from_native) \
+    case RTGRAPHIC_PIXEL_FORMAT_##format:                           \
+        return (rtgui_color_t)to_native(c);
+
+    _PIXEL_FORMATS(_RAW_COLOR_CASE)
+
+    #undef _RAW_COLOR_CASE
+
+    default:
+        return c;
+    }
+}
+RTM_EXPORT(rtgui_gfx_raw_color);
+
+rtgui_color_t rtgui_gfx_native_color(rtgui_color_t c) {
+    /* framebuffer ops take rtgui color */
+    if (_gfx_drv.native_ops == _gfx_drv.ops) return c;
+    return rtgui_gfx_raw_color(c);
+}
+RTM_EXPORT(rtgui_gfx_native_color);
+
 void rtgui_gfx_get_rect(const rtgui_gfx_driver_t *drv, rtgui_rect_t *rect) {
     RT_ASSERT(rect != RT_NULL);
 
@@ -640,11 +1315,208 @@ void rtgui_gfx_update_screen(const rtgui_gfx_driver_t *drv,
         info.width -= info.x;
         info.height -= info.y;
 
+        #ifdef RTGUI_USING_DOUBLE_BUFFER
+            /* copy from back buffer */
+            if (drv->scanout != drv->framebuffer) {
+                rtgui_rect_t area;
+
+                area.x1 = info.x;
+                area.y1 = info.y;
+                area.x2 = info.x + info.width;
+                area.y2 = info.y + info.height;
+                rtgui_gfx_fence_screen(drv, &area);
+                _double_buffer_copy(drv->scanout, drv->framebuffer, &info);
+                if (_overlay_hook) _overlay_hook(&area);
+            }
+        #endif
+        #ifdef RTGUI_USING_ASYNC_UPDATE
+            if (_update_inited) {
+                _update_enqueue(&info);
+                return;
+            }
+        #endif
         rt_device_control(drv->device, RTGRAPHIC_CTRL_RECT_UPDATE, &info);
     }
 }
 RTM_EXPORT(rtgui_gfx_update_screen);
 
+/* wait until the rect (or all if RT_NULL) is not being updated to device */
+void rtgui_gfx_fence_screen(const rtgui_gfx_driver_t *drv,
+    rtgui_rect_t *rect) {
+    #ifdef RTGUI_USING_ASYNC_UPDATE
+        struct rt_device_rect_info *info;
+        rt_bool_t busy;
+        rt_uint8_t idx;
+
+        if (!drv->device || !_update_inited) return;
+
+        do {
+            busy = RT_FALSE;
+            rt_mutex_take(&_update_lock, RT_WAITING_FOREVER);
+            for (idx = 0; idx < _update_num; idx++) {
+                info = &_update_queue[(_update_head + idx) % \
+                    RTGUI_UPDATE_QUEUE_SIZE];
+                if (!rect || ((rect->x1 < (int)(info->x + info->width)) && \
+                    (rect->x2 >= (int)info->x) && \
+                    (rect->y1 < (int)(info->y + info->height)) && \
+                    (rect->y2 >= (int)info->y))) {
+                    busy = RT_TRUE;
+                    break;
+                }
+            }
+            rt_mutex_release(&_update_lock);
+
+            if (busy)
+                (void)rt_event_recv(&_update_done, UPDATE_DONE_FLAG,
+                    RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR,
+                    RT_TICK_PER_SECOND / 100 + 1, RT_NULL);
+        } while (busy);
+    #else
+        (void)drv;
+        (void)rect;
+    #endif
+}
+RTM_EXPORT(rtgui_gfx_fence_screen);
+
+#ifdef RTGUI_USING_ASYNC_UPDATE
+    RTGUI_SETTER(gfx_update_hook, rtgui_gfx_update_hook_t, _update_hook);
+#endif
+#ifdef RTGUI_USING_DOUBLE_BUFFER
+    RTGUI_SETTER(gfx_overlay_hook, rtgui_gfx_update_hook_t, _overlay_hook);
+    RTGUI_SETTER(gfx_overlay_rect, rtgui_rect_t, _overlay_rect);
+#endif
+
+/* add rect to damage region, which will be updated by
+   rtgui_gfx_commit_screen() */
+void rtgui_gfx_damage_screen(const rtgui_gfx_driver_t *drv,
+    rtgui_rect_t *rect) {
+    rtgui_rect_t area;
+
+    if (!drv->device || !_damage_inited) return;
+
+    area = *rect;
+    if (area.x1 < 0) area.x1 = 0;
+    if (area.y1 < 0) area.y1 = 0;
+    if (area.x2 > drv->width) area.x2 = drv->width;
+    if (area.y2 > drv->height) area.y2 = drv->height;
+    if ((area.x1 >= area.x2) || (area.y1 >= area.y2)) return;
+
+    rt_mutex_take(&_damage_lock, RT_WAITING_FOREVER);
+    if (SUCCESS != rtgui_region_union_rect(&_damage, &_damage, &area)) {
+        /* no memory, update directly */
+        rtgui_gfx_update_screen(drv, &area);
+    }
+    rt_mutex_release(&_damage_lock);
+}
+RTM_EXPORT(rtgui_gfx_damage_screen);
+
+/* update damage region in one pass, either by rects or by bounding box */
+void rtgui_gfx_commit_screen(const rtgui_gfx_driver_t *drv) {
+    rtgui_rect_t *rects, *extents;
+    rt_uint32_t num, idx, area;
+
+    if (!drv->device || !_damage_inited) return;
+
+    rt_mutex_take(&_damage_lock, RT_WAITING_FOREVER);
+    do {
+        if (!rtgui_region_not_empty(&_damage)) break;
+
+        extents = rtgui_region_extents(&_damage);
+        num = rtgui_region_num_rects(&_damage);
+        rects = rtgui_region_rects(&_damage);
+
+        /* area covered by the rects */
+        for (idx = 0, area = 0; idx < num; idx++)
+            area += (rects[idx].x2 - rects[idx].x1) * \
+                    (rects[idx].y2 - rects[idx].y1);
+        #ifdef RTGUI_USING_DOUBLE_BUFFER
+            if (_double_buffer_flip(rects, num)) {
+                rtgui_region_empty(&_damage);
+                break;
+            }
+        #endif
+        /* merge to bounding box when too many rects, or when the rects cover
+           at least MERGE_PERCENT of it (little area is updated for nothing) */
+        if ((num > RTGUI_DAMAGE_MAX_RECTS) || ((area * 100) >= \
+            ((rt_uint32_t)(extents->x2 - extents->x1) * \
+             (extents->y2 - extents->y1) * RTGUI_DAMAGE_MERGE_PERCENT))) {
+            rtgui_gfx_update_screen(drv, extents);
+        } else {
+            for (idx = 0; idx < num; idx++)
+                rtgui_gfx_update_screen(drv, &rects[idx]);
+        }
+        rtgui_region_empty(&_damage);
+    } while (0);
+    rt_mutex_release(&_damage_lock);
+}
+RTM_EXPORT(rtgui_gfx_commit_screen);
+
+#ifdef RTGUI_USING_BAND_BUFFER
+/* start drawing the area band by band, the drawing code should be repeated
+   until rtgui_gfx_band_next() returns RT_FALSE:
+    if (rtgui_gfx_band_start(&rect)) {
+        do {
+            draw();
+        } while (rtgui_gfx_band_next());
+    }
+ */
+rt_bool_t rtgui_gfx_band_start(const rtgui_rect_t *rect) {
+    rtgui_rect_t area;
+    int w;
+
+    /* not available or already started */
+    if (!_band.pixels || _band.dev_ops) return RT_FALSE;
+
+    /* (x2, y2) may be included */
+    area = *rect;
+    area.x2++;
+    area.y2++;
+    if (area.x1 < 0) area.x1 = 0;
+    if (area.y1 < 0) area.y1 = 0;
+    if (area.x2 > _gfx_drv.width) area.x2 = _gfx_drv.width;
+    if (area.y2 > _gfx_drv.height) area.y2 = _gfx_drv.height;
+    if ((area.x1 >= area.x2) || (area.y1 >= area.y2)) return RT_FALSE;
+
+    rtgui_screen_lock(RT_WAITING_FOREVER);
+    w = area.x2 - area.x1;
+    _band.area = area;
+    _band.rect = area;
+    _band.rect.y2 = _MIN(area.y1 + RTGUI_BAND_HEIGHT, area.y2);
+    _band.pitch = w * _band.bpp;
+    _band.mask_pitch = _BIT2BYTE(w);
+    rt_memset(_band.mask, 0x00, _band.mask_pitch * RTGUI_BAND_HEIGHT);
+
+    /* redirect drawing to band */
+    _band.dev_ops = _gfx_drv.native_ops;
+    _band.ext_ops = _gfx_drv.ext_ops;
+    _gfx_drv.native_ops = &_band_ops;
+    _gfx_drv.ext_ops = RT_NULL;
+    return RT_TRUE;
+}
+RTM_EXPORT(rtgui_gfx_band_start);
+
+/* flush current band and move to next one */
+rt_bool_t rtgui_gfx_band_next(void) {
+    if (!_band.dev_ops) return RT_FALSE;
+
+    _band_flush();
+    if (_band.rect.y2 >= _band.area.y2) {
+        /* done */
+        _gfx_drv.native_ops = _band.dev_ops;
+        _gfx_drv.ext_ops = _band.ext_ops;
+        _band.dev_ops = RT_NULL;
+        rtgui_screen_unlock();
+        return RT_FALSE;
+    }
+
+    _band.rect.y1 = _band.rect.y2;
+    _band.rect.y2 = _MIN(_band.rect.y1 + RTGUI_BAND_HEIGHT, _band.area.y2);
+    rt_memset(_band.mask, 0x00, _band.mask_pitch * RTGUI_BAND_HEIGHT);
+    return RT_TRUE;
+}
+RTM_EXPORT(rtgui_gfx_band_next);
+#endif /* RTGUI_USING_BAND_BUFFER */
+
 rt_uint8_t *rtgui_gfx_get_framebuffer(const rtgui_gfx_driver_t *drv) {
     if (!drv)
         return _gfx_drv.framebuffer;
@@ -652,6 +1524,121 @@ rt_uint8_t *rtgui_gfx_get_framebuffer(const rtgui_gfx_driver_t *drv) {
 }
 RTM_EXPORT(rtgui_gfx_get_framebuffer);
 
+/* read rect (x2, y2 not included) in the layout of draw_raw_hline, should be
+   called with screen locked */
+rt_err_t rtgui_gfx_read_rect(const rtgui_gfx_driver_t *drv,
+    rtgui_rect_t *rect, rt_uint8_t *pixels, rt_uint32_t pitch) {
+    int y;
+
+    RT_ASSERT(rect != RT_NULL);
+    RT_ASSERT(pixels != RT_NULL);
+
+    if (!drv)
+        drv = &_gfx_drv;
+    if ((rect->x1 < 0) || (rect->y1 < 0) || (rect->x1 >= rect->x2) || \
+        (rect->y1 >= rect->y2) || (rect->x2 > drv->width) || \
+        (rect->y2 > drv->height))
+        return -RT_EINVAL;
+
+#ifdef RTGUI_USING_BAND_BUFFER
+    if ((drv == &_gfx_drv) && _band.dev_ops) {
+        /* the band holds pixels not yet sent to device */
+        if (!_band.dev_ops->read_raw_hline && !_band.dev_ops->get_pixel)
+            return -RT_ENOSYS;
+        for (y = rect->y1; y < rect->y2; y++, pixels += pitch)
+            _band_read_raw_hline(pixels, rect->x1, rect->x2, y);
+        return RT_EOK;
+    }
+#endif
+
+    if (drv->framebuffer && (drv->bits_per_pixel >= 8)) {
+        /* copy from framebuffer */
+        rt_uint32_t bpp = _BIT2BYTE(drv->bits_per_pixel);
+        rt_uint32_t len = (rect->x2 - rect->x1) * bpp;
+        rt_uint8_t *ptr = drv->framebuffer + drv->pitch * rect->y1 + \
+            bpp * rect->x1;
+
+        if ((len == drv->pitch) && (pitch == drv->pitch)) {
+            /* whole lines in one copy */
+            rt_memcpy(pixels, ptr, len * (rect->y2 - rect->y1));
+            return RT_EOK;
+        }
+        for (y = rect->y1; y < rect->y2; y++) {
+            rt_memcpy(pixels, ptr, len);
+            ptr += drv->pitch;
+            pixels += pitch;
+        }
+        return RT_EOK;
+    }
+
+    if (!drv->ops || !drv->ops->read_raw_hline)
+        return -RT_ENOSYS;
+    for (y = rect->y1; y < rect->y2; y++, pixels += pitch)
+        drv->ops->read_raw_hline(pixels, rect->x1, rect->x2, y);
+    return RT_EOK;
+}
+RTM_EXPORT(rtgui_gfx_read_rect);
+
+/* copy pixels of rect moved by (-dx, -dy) to rect (x2, y2 not included),
+   should be called with screen locked */
+rt_err_t rtgui_gfx_copy_rect(const rtgui_gfx_driver_t *drv,
+    rtgui_rect_t *rect, int dx, int dy) {
+    struct rtgui_gfx_copy_info info;
+    rtgui_rect_t area;
+
+    RT_ASSERT(rect != RT_NULL);
+
+    if (!drv)
+        drv = &_gfx_drv;
+    /* both source and destination on screen */
+    area.x1 = _MIN(rect->x1, rect->x1 - dx);
+    area.y1 = _MIN(rect->y1, rect->y1 - dy);
+    area.x2 = _MAX(rect->x2, rect->x2 - dx);
+    area.y2 = _MAX(rect->y2, rect->y2 - dy);
+    if ((rect->x1 >= rect->x2) || (rect->y1 >= rect->y2) || \
+        (area.x1 < 0) || (area.y1 < 0) || \
+        (area.x2 > drv->width) || (area.y2 > drv->height))
+        return -RT_EINVAL;
+    if (!dx && !dy)
+        return RT_EOK;
+
+    #ifdef RTGUI_USING_BAND_BUFFER
+        /* the band is not flushed yet */
+        if (_band.dev_ops)
+            return -RT_EBUSY;
+    #endif
+
+    if (drv->framebuffer && (drv->bits_per_pixel >= 8)) {
+        rt_uint32_t bpp = _BIT2BYTE(drv->bits_per_pixel);
+        rt_uint32_t len = (rect->x2 - rect->x1) * bpp;
+        rt_int32_t offset = drv->pitch * dy + (rt_int32_t)bpp * dx;
+        rt_int32_t pitch = drv->pitch;
+        rt_uint8_t *ptr;
+        int y;
+
+        /* walk rows away from the source, memmove handles the row itself */
+        ptr = drv->framebuffer + bpp * rect->x1;
+        if (dy > 0) {
+            ptr += drv->pitch * (rect->y2 - 1);
+            pitch = -pitch;
+        } else {
+            ptr += drv->pitch * rect->y1;
+        }
+        for (y = rect->y1; y < rect->y2; y++, ptr += pitch)
+            rt_memmove(ptr, ptr - offset, len);
+        return RT_EOK;
+    }
+
+    if (!drv->device)
+        return -RT_ENOSYS;
+    info.rect = *rect;
+    info.dx = dx;
+    info.dy = dy;
+    rtgui_gfx_fence_screen(drv, &area);
+    return rt_device_control(drv->device, RTGUI_GRAPHIC_CTRL_COPY, &info);
+}
+RTM_EXPORT(rtgui_gfx_copy_rect);
+
 
 #ifdef CONFIG_TOUCH_DEVICE_NAME
 static void touch_available(void) {
@@ -160,14 +160,15 @@ static void fnt_font_close(rtgui_font_t *font) {
 static const rt_uint8_t *_fnt_font_get_data(rtgui_font_t *font,
     rt_uint16_t code) {
     rtgui_fnt_font_t *fnt_font;
-    rt_uint32_t offset, size;
+    rt_uint32_t offset;
 
     fnt_font = font->data;
     offset = fnt_font->offset[code - font->start];
-    size = fnt_font->width[code - font->start] * 2;
 
     #if (CONFIG_USING_FONT_FILE)
         if (fnt_font->fname) {
+            rt_uint32_t size = fnt_font->width[code - font->start] * 2;
+
             do {
                 if (fnt_font->fd < 0) {
                     LOG_E("no fd %s", fnt_font->fname);
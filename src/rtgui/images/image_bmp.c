@@ -538,7 +538,9 @@ rt_err_t rtgui_image_bmp_init(void) {
 
 #if defined(RT_USING_DFS) && defined(RT_USING_FINSH)
 #include "components/finsh/finsh.h"
+/* In multiple of sector size, all writes are aligned */
 #define WRITE_BUFFER_SIZE           (512)
+#define BMP_LINE_SIZE(w, bits)      ((((w) * (bits) + 31) >> 5) << 2)
 
 #pragma pack(push)
 #pragma pack(2)
@@ -565,216 +567,283 @@ struct bmp_header {
 };
 #pragma pack(pop)
 
-static rt_uint32_t bmp_write_header(int file, rt_uint8_t *buf, rt_uint32_t w,
+/* buffered file writer */
+struct bmp_writer {
+    int file;
+    rt_uint8_t *buf;
+    rt_uint32_t len;
+};
+
+static rt_err_t bmp_flush(struct bmp_writer *wr) {
+    if (!wr->len) return RT_EOK;
+    if (write(wr->file, wr->buf, wr->len) != (int)wr->len) {
+        LOG_E("bad write");
+        return -RT_EIO;
+    }
+    wr->len = 0;
+    return RT_EOK;
+}
+
+static rt_err_t bmp_write(struct bmp_writer *wr, const void *data,
+    rt_uint32_t size) {
+    const rt_uint8_t *ptr = data;
+    rt_uint32_t len;
+
+    while (size) {
+        len = _MIN(size, WRITE_BUFFER_SIZE - wr->len);
+        if (ptr) {
+            rt_memcpy(wr->buf + wr->len, ptr, len);
+            ptr += len;
+        } else {
+            /* padding */
+            rt_memset(wr->buf + wr->len, 0x00, len);
+        }
+        wr->len += len;
+        size -= len;
+        if (WRITE_BUFFER_SIZE == wr->len) {
+            if (RT_EOK != bmp_flush(wr)) return -RT_EIO;
+        }
+    }
+    return RT_EOK;
+}
+
+static rt_err_t bmp_write_header(struct bmp_writer *wr, rt_uint32_t w,
     rt_uint32_t h, rt_uint8_t bits_per_pixel) {
-    struct bmp_header *hdr = (struct bmp_header *)buf;
-    rt_uint32_t *color = (rt_uint32_t *)buf;
-    rt_uint32_t img_size = w * h;
+    struct bmp_header hdr;
+    rt_uint32_t color[3];
+    rt_uint32_t img_size = BMP_LINE_SIZE(w, bits_per_pixel) * h;
     rt_uint32_t color_size;
 
-    if (1 == bits_per_pixel)
-        img_size >>= 3;
-    else if (2 == bits_per_pixel)
-        img_size >>= 2;
-    else if (4 == bits_per_pixel)
-        img_size >>= 1;
-    else
-        img_size *= _BIT2BYTE(bits_per_pixel);
-
     if (bits_per_pixel <= 8) {
         color_size = 1 << (bits_per_pixel + 2);
-    } else {
+    } else if (16 == bits_per_pixel) {
         color_size = 12;
+    } else {
+        color_size = 0;
     }
 
     /* BMP header */
-    hdr->bfType = 0x4d42;           /* "BM" */
-    hdr->bfSize = sizeof(struct bmp_header) + color_size + img_size;
-    hdr->bfReserved1 = 0;
-    hdr->bfReserved2 = 0;
-    hdr->bfOffBits = sizeof(struct bmp_header) + color_size;
+    hdr.bfType = 0x4d42;            /* "BM" */
+    hdr.bfSize = sizeof(struct bmp_header) + color_size + img_size;
+    hdr.bfReserved1 = 0;
+    hdr.bfReserved2 = 0;
+    hdr.bfOffBits = sizeof(struct bmp_header) + color_size;
     /* DIB header (BITMAPV2INFOHEADER: BITMAPINFOHEADER + RGB bit masks) */
-    hdr->biSize = 40;
-    hdr->biWidth = w;
-    hdr->biHeight = h;
-    hdr->biPlanes = 1;              /* Fixed */
-    hdr->biBitCount = bits_per_pixel;
-    hdr->biCompression = (bits_per_pixel <= 8) ? BI_RGB : BI_BITFIELDS;
-    hdr->biSizeImage = img_size;
-    hdr->biXPelsPerMeter = 0;
-    hdr->biYPelsPerMeter = 0;
-    hdr->biClrUsed = 0;
-    hdr->biClrImportant = 0;
-    if (write(file, buf, sizeof(struct bmp_header)) < 0) {
-        LOG_E("bad write");
-        return 0;
-    }
+    hdr.biSize = 40;
+    hdr.biWidth = w;
+    hdr.biHeight = h;
+    hdr.biPlanes = 1;               /* Fixed */
+    hdr.biBitCount = bits_per_pixel;
+    hdr.biCompression = (16 == bits_per_pixel) ? BI_BITFIELDS : BI_RGB;
+    hdr.biSizeImage = img_size;
+    hdr.biXPelsPerMeter = 0;
+    hdr.biYPelsPerMeter = 0;
+    hdr.biClrUsed = 0;
+    hdr.biClrImportant = 0;
+    if (RT_EOK != bmp_write(wr, &hdr, sizeof(hdr))) return -RT_EIO;
 
     /* bit masks or palette */
-    if (hdr->biCompression == BI_BITFIELDS) {
-        *(color++) = 0x0000F800;        /* Red Mask */
-        *(color++) = 0x000007E0;        /* Green Mask */
-        *(color++) = 0x0000001F;        /* Blue Mask */
-    } else if (bits_per_pixel == 1) {
-        *(color++) = 0x00000000;        /* Black */
-        *(color++) = 0x00ffffff;        /* White */
-    } else {
+    if (16 == bits_per_pixel) {
+        color[0] = 0x0000F800;      /* Red Mask */
+        color[1] = 0x000007E0;      /* Green Mask */
+        color[2] = 0x0000001F;      /* Blue Mask */
+    } else if (1 == bits_per_pixel) {
+        color[0] = 0x00000000;      /* Black */
+        color[1] = 0x00ffffff;      /* White */
+    } else if (color_size) {
         LOG_E("not implemented");
-        return 0;
+        return -RT_ERROR;
     }
-    if (write(file, buf, color_size) < 0) {
-        LOG_E("bad write");
-        return 0;
+    return bmp_write(wr, color, color_size);
+}
+
+/* convert a line of native pixels to BMP format in place */
+static void bmp_convert_line(rt_uint8_t *line, rt_uint32_t w,
+    rt_uint8_t pixel_format) {
+    rt_uint32_t i;
+
+    switch (pixel_format) {
+    case RTGRAPHIC_PIXEL_FORMAT_MONO:
+    {
+        /* LSB first -> MSB first */
+        rt_uint8_t in, out, bit;
+
+        for (i = 0; i < _BIT2BYTE(w); i++) {
+            in = line[i];
+            for (out = 0, bit = 0; bit < 8; bit++, in >>= 1)
+                out = (out << 1) | (in & 0x01);
+            line[i] = out;
+        }
+        break;
     }
 
-    return sizeof(struct bmp_header) + color_size;
+    case RTGRAPHIC_PIXEL_FORMAT_RGB565:
+        #ifdef RTGUI_BIG_ENDIAN_OUTPUT
+        {
+            rt_uint8_t tmp;
+
+            for (i = 0; i < (w << 1); i += 2) {
+                tmp = line[i];
+                line[i] = line[i + 1];
+                line[i + 1] = tmp;
+            }
+        }
+        #endif
+        break;
+
+    case RTGRAPHIC_PIXEL_FORMAT_RGB565P:
+    {
+        rt_uint16_t pixel;
+
+        /* BGR565 -> RGB565 */
+        for (i = 0; i < (w << 1); i += 2) {
+            pixel = line[i] | (line[i + 1] << 8);
+            pixel = ((pixel & 0x001f) << 11) | (pixel & 0x07e0) | \
+                    ((pixel & 0xf800) >> 11);
+            line[i] = pixel & 0xff;
+            line[i + 1] = pixel >> 8;
+        }
+        break;
+    }
+
+    default:
+        /* RGB888 and ARGB888 (as 32bpp BI_RGB, alpha ignored) are already in
+           BMP order */
+        break;
+    }
 }
 
-/* Grab screen and save as BMP file */
-rt_err_t screenshot(const char *filename) {
-    int file = -1;
-    rt_uint8_t *buf = RT_NULL;
+/* Grab screen and save as BMP file
+ * - to_ram: copy the whole screen to RAM and encode after unlock, falls back
+ *   to encode line by line with screen locked if no enough memory */
+static rt_err_t bmp_screenshot(const char *filename, rt_bool_t to_ram) {
+    struct bmp_writer wr = { -1, RT_NULL, 0 };
+    rt_uint8_t *pixels = RT_NULL;
     rt_bool_t locked = RT_FALSE;
     rt_err_t ret = RT_EOK;
 
     do {
         rt_uint32_t w = display()->width;
         rt_uint32_t h = display()->height;
-        rt_uint32_t len, i;
-        rtgui_color_t pixel;
-        rt_uint32_t x;
+        rt_uint8_t bits = display()->bits_per_pixel;
+        rt_uint32_t raw_size, line_size;
+        rtgui_rect_t rect;
         rt_int32_t y;
 
-        if (!display()->ops->get_pixel) {
-            LOG_E("no pixel read");
+        switch (display()->pixel_format) {
+        case RTGRAPHIC_PIXEL_FORMAT_MONO:
+        case RTGRAPHIC_PIXEL_FORMAT_RGB565:
+        case RTGRAPHIC_PIXEL_FORMAT_RGB565P:
+        case RTGRAPHIC_PIXEL_FORMAT_RGB888:
+        case RTGRAPHIC_PIXEL_FORMAT_ARGB888:
+            break;
+        default:
+            ret = -RT_ERROR;
+            break;
+        }
+        if (RT_EOK != ret) {
+            LOG_E("not implemented");
             break;
         }
 
-        buf = rtgui_malloc(WRITE_BUFFER_SIZE);
-        if (RT_NULL == buf) {
+        raw_size = (1 == bits) ? _BIT2BYTE(w) : w * _BIT2BYTE(bits);
+        line_size = BMP_LINE_SIZE(w, bits);
+
+        if (to_ram) {
+            pixels = rtgui_malloc(raw_size * h);
+            if (!pixels) {
+                LOG_D("no mem for snapshot");
+                to_ram = RT_FALSE;
+            }
+        }
+        if (!pixels) {
+            pixels = rtgui_malloc(line_size);
+            if (!pixels) {
+                ret = -RT_ENOMEM;
+                LOG_E("no mem");
+                break;
+            }
+            rt_memset(pixels, 0x00, line_size);
+        }
+        wr.buf = rtgui_malloc(WRITE_BUFFER_SIZE);
+        if (!wr.buf) {
+            ret = -RT_ENOMEM;
             LOG_E("no mem");
             break;
         }
-        file = open(filename, O_CREAT | O_WRONLY);
-        if (file < 0) {
+        wr.file = open(filename, O_CREAT | O_WRONLY);
+        if (wr.file < 0) {
             ret = -RT_EIO;
             LOG_E("bad file");
             break;
         }
-        rt_kprintf("\n00%%\r");
 
-        /* header */
-        if (bmp_write_header(file, buf, w, h, display()->bits_per_pixel) == 0) {
-            ret = -RT_EIO;
-            break;
-        }
+        ret = bmp_write_header(&wr, w, h, bits);
+        if (RT_EOK != ret) break;
 
-        rtgui_screen_lock(RT_WAITING_FOREVER);
+        ret = rtgui_screen_lock(RT_WAITING_FOREVER);
+        if (RT_EOK != ret) break;
         locked = RT_TRUE;
 
-        switch (display()->pixel_format) {
-        case RTGRAPHIC_PIXEL_FORMAT_MONO:
-        {
-            if (!display()->framebuffer) {
-                ret = -RT_ERROR;
-                LOG_E("no framebuffer");
-                break;
-            }
-
-            /* data */
-            len = WRITE_BUFFER_SIZE;
-            i = 0;
-            rt_memset(buf, 0x00, len);
-
-            for (y = h - 1; y >= 0; y--) {
-                rt_kprintf("%02d%%\r", (h - 1 - y) * 100 / h);
-                for (x = 0; x < w; x++) {
-                    display()->ops->get_pixel(&pixel, x, y);
-                    if (i >= len) {
-                        if (write(file, buf, len) < 0) {
-                            ret = -RT_EIO;
-                            LOG_E("bad write");
-                            break;
-                        }
-                        fsync(file);
-                        i = 0;
-                        rt_memset(buf, 0x00, len);
-                    }
-                    if (pixel != black)
-                        buf[i] |= (1 << (7 - (x & 0x07)));
-                    if ((x & 0x07) == 0x07)
-                        i++;
-                }
-                if (RT_EOK != ret) break;
-            }
+        if (to_ram) {
+            rtgui_rect_init(&rect, 0, 0, w, h);
+            ret = rtgui_gfx_read_rect(RT_NULL, &rect, pixels, raw_size);
+            rtgui_screen_unlock();
+            locked = RT_FALSE;
             if (RT_EOK != ret) break;
-            if (i) {
-                if (write(file, buf, i) < 0) {
-                    ret = -RT_EIO;
-                    LOG_E("bad write");
-                }
-            }
-            break;
         }
 
-        case RTGRAPHIC_PIXEL_FORMAT_RGB565:
-        {
-            rt_uint16_t *c;
-
-            len = WRITE_BUFFER_SIZE / sizeof(rt_uint16_t);
-            i = 0;
-            c = (rt_uint16_t *)buf;
-
-            for (y = h - 1; y >= 0; y--) {
-                rt_kprintf("%02d%%\r", (h - 1 - y) * 100 / h);
-                for (x = 0; x < w; x++) {
-                    display()->ops->get_pixel(&pixel, x, y);
-                    if (i >= len) {
-                        if (write(file, buf, sizeof(rt_uint16_t) * i) < 0) {
-                            ret = -RT_EIO;
-                            LOG_E("bad write");
-                            break;
-                        }
-                        i = 0;
-                    }
-                    *(c + i++) = ((pixel & 0x00f80000) >> 8) | \
-                                 ((pixel & 0x0000fc00) >> 5) | \
-                                 ((pixel & 0x000000f8) >> 3);
-                }
+        /* bottom-up */
+        for (y = h - 1; y >= 0; y--) {
+            rt_uint8_t *line;
+
+            if (to_ram) {
+                line = pixels + raw_size * y;
+            } else {
+                rtgui_rect_init(&rect, 0, y, w, 1);
+                ret = rtgui_gfx_read_rect(RT_NULL, &rect, pixels, raw_size);
                 if (RT_EOK != ret) break;
+                line = pixels;
             }
+            bmp_convert_line(line, w, display()->pixel_format);
+            ret = bmp_write(&wr, line, raw_size);
+            if (RT_EOK != ret) break;
+            ret = bmp_write(&wr, RT_NULL, line_size - raw_size);
             if (RT_EOK != ret) break;
-            if (i) {
-                if (write(file, buf, sizeof(rt_uint16_t) * i) < 0) {
-                    ret = -RT_EIO;
-                    LOG_E("bad write");
-                }
-            }
-            break;
         }
+        if (RT_EOK != ret) break;
 
-        default:
-            ret = -RT_ERROR;
-            LOG_E("not implemented");
-            break;
-        }
-        rt_kprintf("Done %s\n", filename);
+        ret = bmp_flush(&wr);
     } while (0);
 
     if (locked) rtgui_screen_unlock();
-    if (file >= 0) {
-        fsync(file);
-        close(file);
+    if (wr.file >= 0) {
+        fsync(wr.file);
+        close(wr.file);
     }
-    if (buf) rtgui_free(buf);
+    if (wr.buf) rtgui_free(wr.buf);
+    if (pixels) rtgui_free(pixels);
 
+    if (RT_EOK == ret)
+        rt_kprintf("Done %s\n", filename);
     return ret;
 }
+
+rt_err_t screenshot(const char *filename) {
+    return bmp_screenshot(filename, RT_FALSE);
+}
 FINSH_FUNCTION_EXPORT(screenshot, usage: screenshot(filename));
 
+rt_err_t snapshot(const char *filename) {
+    return bmp_screenshot(filename, RT_TRUE);
+}
+FINSH_FUNCTION_EXPORT(snapshot, usage: snapshot(filename));
+
 int prtscn(int argc, char **argv) {
+    if ((argc == 3) && !rt_strcmp(argv[2], "-r"))
+        return snapshot(argv[1]);
     if (argc != 2) {
-        rt_kprintf("\nusage: prtscn(filename)\n");
+        rt_kprintf("\nusage: prtscn(filename [-r])\n");
         return -1;
     }
     return screenshot(argv[1]);
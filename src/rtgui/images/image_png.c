@@ -151,7 +151,8 @@ static rt_bool_t png_load(rtgui_image_t *img, rtgui_filerw_t *file,
             png->bitDepth = 8;
             break;
         case RTGRAPHIC_PIXEL_FORMAT_RGB565:
-            png->colorType = LCT_RGB;
+            /* keep alpha for blending */
+            png->colorType = LCT_RGBA;
             png->bitDepth = 8;
             break;
         case RTGRAPHIC_PIXEL_FORMAT_RGB888:
@@ -215,9 +216,29 @@ static rt_bool_t png_load(rtgui_image_t *img, rtgui_filerw_t *file,
                 png->pitch = w;
                 break;
             case RTGRAPHIC_PIXEL_FORMAT_RGB565:
-                png->pixel_format = RTGRAPHIC_PIXEL_FORMAT_RGB888;
+            {
+                rtgui_blit_line_func blit_line;
+                rt_uint8_t *src, *dst;
+                rt_uint32_t y;
+
+                /* pack to RGB565 + A8 in place, a line is 3/4 of decoded */
+                blit_line = rtgui_get_blit_line_func(
+                    RTGRAPHIC_PIXEL_FORMAT_ARGB888,
+                    RTGRAPHIC_PIXEL_FORMAT_ARGB565);
+                if (!blit_line || ret) {
+                    err = -RT_ERROR;
+                    break;
+                }
+                src = dst = png->pixels;
+                for (y = 0; y < h; y++) {
+                    blit_line(dst, src, w << 2, 0, RT_NULL);
+                    src += w << 2;
+                    dst += w * 3;
+                }
+                png->pixel_format = RTGRAPHIC_PIXEL_FORMAT_ARGB565;
                 png->pitch = w * 3;
                 break;
+            }
             case RTGRAPHIC_PIXEL_FORMAT_RGB888:
                 png->pixel_format = RTGRAPHIC_PIXEL_FORMAT_RGB888;
                 png->pitch = w * 3;
@@ -271,55 +292,72 @@ static void png_unload(rtgui_image_t *img) {
 
 static void png_blit(rtgui_image_t *img, rtgui_dc_t *dc, rtgui_rect_t *rect) {
     struct rtgui_image_png *png;
+    rt_uint8_t *line = RT_NULL;
 
     if (!img || !dc || !rect || !img->data) return;
 
     png = (struct rtgui_image_png *)img->data;
 
     do {
-        rt_uint16_t w, h;
-        rt_uint32_t pitch;
+        rt_uint16_t w, h, x, y;
+        rt_uint8_t src_bpp, dst_bpp;
+        rtgui_blit_line_func blit_line;
+        rtgui_color_t fill;
+        rt_uint8_t *ptr;
 
         w = _MIN(img->w, RECT_W(*rect));
         h = _MIN(img->h, RECT_H(*rect));
-        pitch = w * _BIT2BYTE(display()->bits_per_pixel);
 
         if (!png->is_loaded) {
             LOG_W("PNG is not loaded!");
             break;
-        } else {
-            rt_uint16_t y;
-            rt_uint8_t *ptr;
-
-            if (png->pixel_format != display()->pixel_format) {
-                rtgui_blit_line_func blit_line;
-                rt_uint8_t *src, *dst;
-
-                blit_line = rtgui_get_blit_line_func(png->pixel_format,
-                    display()->pixel_format);
-                if (!blit_line) {
-                    LOG_E("no blit func");
-                    break;
-                }
-
-                /* process the image */
-                src = png->pixels;
-                dst = png->pixels;
-                for (y = 0; y < h; y++) {
-                    blit_line(dst, src, png->pitch, 0, RT_NULL);
-                    src += png->pitch;
-                    dst += pitch;
-                }
-            }
+        }
 
-            /* output the image */
+        /* output the image */
+        if (png->pixel_format == display()->pixel_format) {
             for (y = 0; y < h; y++) {
-                ptr = png->pixels + y * pitch;
-                dc->engine->blit_line(dc, rect->x1, rect->x1 + w - 1,
+                ptr = png->pixels + y * png->pitch;
+                dc->engine->blit_line(dc, rect->x1, rect->x1 + w,
                     rect->y1 + y, ptr);
             }
+            break;
+        }
+
+        /* blend the image over dc */
+        blit_line = rtgui_get_blit_line_func(png->pixel_format,
+            display()->pixel_format);
+        if (!blit_line) {
+            LOG_E("no blit func");
+            break;
+        }
+        src_bpp = png->pitch / img->w;
+        dst_bpp = _BIT2BYTE(display()->bits_per_pixel);
+        line = rtgui_malloc(w * dst_bpp);
+        if (!line) {
+            LOG_E("no mem for line");
+            break;
+        }
+        /* background for pixels can't be read back */
+        fill = rtgui_gfx_raw_color(rtgui_dc_get_gc(dc)->background);
+
+        for (y = 0; y < h; y++) {
+            ptr = png->pixels + y * png->pitch;
+            if (RT_EOK != rtgui_dc_read_line(dc, rect->x1, rect->x1 + w,
+                rect->y1 + y, line)) {
+                for (x = 0; x < w; x++) {
+                    if (2 == dst_bpp)
+                        ((rt_uint16_t *)line)[x] = (rt_uint16_t)fill;
+                    else
+                        rt_memcpy(line + x * dst_bpp, &fill, dst_bpp);
+                }
+            }
+            blit_line(line, ptr, w * src_bpp, 0, RT_NULL);
+            dc->engine->blit_line(dc, rect->x1, rect->x1 + w,
+                rect->y1 + y, line);
         }
     }  while (0);
+
+    if (line) rtgui_free(line);
 }
 
 /* Public functions ----------------------------------------------------------*/
@@ -22,6 +22,7 @@
  * 2009-10-16     Bernard      first version
  */
 /* Includes ------------------------------------------------------------------*/
+#include "include/rthw.h" // rt_hw_interrupt_disable()
 #include "include/rtgui.h"
 #include "include/region.h"
 
@@ -118,12 +119,109 @@ static rtgui_region_data_t  _bad_region_data = {
  */
 
 /* Private functions ---------------------------------------------------------*/
+#ifdef RTGUI_USING_REGION_ARENA
+/* region data of a clip update pass, bumped from arena, which is reset when
+   no block alive; each block starts with one word of its size in words */
+# define ARENA_WORDS                (RTGUI_REGION_ARENA_SIZE / 4)
+# define ARENA_NO_LAST              (ARENA_WORDS)
+# define IS_IN_ARENA(ptr)           \
+    (((rt_uint32_t *)(ptr) >= _arena.pool) && \
+     ((rt_uint32_t *)(ptr) < (_arena.pool + ARENA_WORDS)))
+
+static struct rtgui_region_arena {
+    rt_uint32_t pool[ARENA_WORDS];
+    rt_uint32_t top;                        /* first free word */
+    rt_uint32_t last;                       /* header of the last block */
+    rt_uint32_t alive;                      /* blocks not freed */
+    rt_thread_t owner;                      /* thread of the pass */
+    rt_uint32_t depth;                      /* nested passes */
+} _arena = {
+    {0}, 0, ARENA_NO_LAST, 0, RT_NULL, 0,
+};
+
+static void *_data_alloc(rt_uint32_t size) {
+    rt_uint32_t words = (size + 3) >> 2;
+    rt_base_t level;
+    void *ptr = RT_NULL;
+
+    level = rt_hw_interrupt_disable();
+    if ((_arena.owner == rt_thread_self()) && \
+        ((_arena.top + 1 + words) <= ARENA_WORDS)) {
+        _arena.last = _arena.top;
+        _arena.pool[_arena.top] = words;
+        ptr = &_arena.pool[_arena.top + 1];
+        _arena.top += 1 + words;
+        _arena.alive++;
+    }
+    rt_hw_interrupt_enable(level);
+
+    /* not in a pass or arena is full */
+    if (!ptr) ptr = rtgui_malloc(size);
+    return ptr;
+}
+
+static void _data_free(void *ptr) {
+    rt_uint32_t *hdr = (rt_uint32_t *)ptr - 1;
+    rt_base_t level;
+
+    if (!IS_IN_ARENA(ptr)) {
+        rtgui_free(ptr);
+        return;
+    }
+
+    level = rt_hw_interrupt_disable();
+    if (!--_arena.alive) {
+        _arena.top = 0;
+        _arena.last = ARENA_NO_LAST;
+    } else if (hdr == &_arena.pool[_arena.last]) {
+        _arena.top = _arena.last;
+        _arena.last = ARENA_NO_LAST;
+    }
+    rt_hw_interrupt_enable(level);
+}
+
+static void *_data_realloc(void *ptr, rt_uint32_t size) {
+    rt_uint32_t words = (size + 3) >> 2;
+    rt_uint32_t *hdr = (rt_uint32_t *)ptr - 1;
+    rt_uint32_t old;
+    rt_base_t level;
+    void *new_ptr;
+
+    if (!IS_IN_ARENA(ptr)) return rtgui_realloc(ptr, size);
+    old = *hdr;
+
+    /* resize the last block in place */
+    level = rt_hw_interrupt_disable();
+    if ((hdr == &_arena.pool[_arena.last]) && ((words <= old) || \
+        ((_arena.owner == rt_thread_self()) && \
+         ((_arena.last + 1 + words) <= ARENA_WORDS)))) {
+        *hdr = words;
+        _arena.top = _arena.last + 1 + words;
+        rt_hw_interrupt_enable(level);
+        return ptr;
+    }
+    rt_hw_interrupt_enable(level);
+    if (words <= old) return ptr;
+
+    new_ptr = _data_alloc(size);
+    if (!new_ptr) return RT_NULL;
+    rt_memcpy(new_ptr, ptr, old << 2);
+    _data_free(ptr);
+    return new_ptr;
+}
+
+#else /* RTGUI_USING_REGION_ARENA */
+# define _data_alloc(size)          rtgui_malloc(size)
+# define _data_free(ptr)            rtgui_free(ptr)
+# define _data_realloc(ptr, size)   rtgui_realloc(ptr, size)
+#endif /* RTGUI_USING_REGION_ARENA */
+
 #define allocData(n)                        \
-    rtgui_malloc(REGION_SIZE_OF_N_RECTS(n))
+    _data_alloc(REGION_SIZE_OF_N_RECTS(n))
 
 #define freeData(rgn)                       \
     if ((rgn)->data && (rgn)->data->size) { \
-        rtgui_free((rgn)->data);            \
+        _data_free((rgn)->data);            \
     }
 
 #define RECTALLOC_BAIL(rgn, n, bail) \
@@ -158,7 +256,7 @@ if (!(rgn)->data || (((rgn)->data->numRects + (n)) > (rgn)->data->size)) \
 #define _resize_data(rgn, num)              \
     if (((num) < ((rgn)->data->size >> 1)) && ((rgn)->data->size > 50)) { \
         rtgui_region_data_t *newData = (rtgui_region_data_t *)\
-            rtgui_realloc((rgn)->data, REGION_SIZE_OF_N_RECTS(num)); \
+            _data_realloc((rgn)->data, REGION_SIZE_OF_N_RECTS(num)); \
         if (newData) {                      \
             newData->size = (num);          \
             (rgn)->data = newData;          \
@@ -199,7 +297,7 @@ static r_op_status_t _alloc_rects(rtgui_region_t *rgn, rt_uint32_t n) {
                     n = 250;
             }
             n += rgn->data->numRects;
-            data = (rtgui_region_data_t *)rtgui_realloc(
+            data = (rtgui_region_data_t *)_data_realloc(
                 rgn->data, REGION_SIZE_OF_N_RECTS(n));
             if (!data) break;
             rgn->data = data;
@@ -241,6 +339,70 @@ static r_op_status_t _alloc_rects(rtgui_region_t *rgn, rt_uint32_t n) {
 #endif /* (RTGUI_LOG_LEVEL >= LOG_LVL_DBG) */
 
 /* Public functions ----------------------------------------------------------*/
+/* start a pass, region data allocated by this thread is from the arena until
+   the outermost rtgui_region_arena_end(), returns RT_TRUE if a pass started */
+rt_bool_t rtgui_region_arena_begin(void) {
+#ifdef RTGUI_USING_REGION_ARENA
+    rt_thread_t self = rt_thread_self();
+    rt_bool_t started = RT_FALSE;
+    rt_base_t level;
+
+    if (!self) return RT_FALSE;
+    level = rt_hw_interrupt_disable();
+    if (!_arena.owner) {
+        _arena.owner = self;
+        _arena.depth = 1;
+        started = RT_TRUE;
+    } else if (_arena.owner == self) {
+        _arena.depth++;
+    }
+    rt_hw_interrupt_enable(level);
+    return started;
+#else
+    return RT_FALSE;
+#endif
+}
+RTM_EXPORT(rtgui_region_arena_begin);
+
+void rtgui_region_arena_end(void) {
+#ifdef RTGUI_USING_REGION_ARENA
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    if (_arena.owner && (_arena.owner == rt_thread_self()))
+        if (!--_arena.depth) _arena.owner = RT_NULL;
+    rt_hw_interrupt_enable(level);
+#endif
+}
+RTM_EXPORT(rtgui_region_arena_end);
+
+/* move data of region outliving the pass to heap, otherwise the arena is not
+   reset until the region is freed */
+void rtgui_region_arena_keep(rtgui_region_t *rgn) {
+#ifdef RTGUI_USING_REGION_ARENA
+    rtgui_region_data_t *data;
+    rt_uint32_t num;
+
+    if (!rgn->data || !IS_IN_ARENA(rgn->data)) return;
+
+    num = rgn->data->numRects;
+    if (!num) {
+        _data_free(rgn->data);
+        rgn->data = &_null_region_data;
+        return;
+    }
+    data = rtgui_malloc(REGION_SIZE_OF_N_RECTS(num));
+    if (!data) return;
+    rt_memcpy(data, rgn->data, REGION_SIZE_OF_N_RECTS(num));
+    data->size = num;
+    _data_free(rgn->data);
+    rgn->data = data;
+#else
+    (void)rgn;
+#endif
+}
+RTM_EXPORT(rtgui_region_arena_keep);
+
 void rtgui_region_init_empty(rtgui_region_t *rgn) {
     rgn->extents = _null_rect;
     rgn->data = &_null_region_data;
@@ -708,7 +870,7 @@ static r_op_status_t region_op(
     }
 
     if (backup)
-        rtgui_free(backup);
+        _data_free(backup);
 
     num2 = dstRgn->data->numRects;
     if (0 == num2) {
@@ -1612,9 +1774,10 @@ r_op_status_t rtgui_region_subtract(rtgui_region_t *regD, rtgui_region_t *regM,
        do yucky substraction for overlaps, and
        just throw away rectangles in region 2 that aren't in region 1 */
     if (SUCCESS != region_op(regD, regM, regS, _subtract_func, RT_TRUE,
-        RT_FALSE, &notUsed))
+        RT_FALSE, &notUsed)) {
         LOG_W("_subtract_func err");
         return FAILURE;
+    }
 
     /*
      * Can't alter RegD's extents before we call region_op because
@@ -0,0 +1,678 @@
+/*
+ * File      : simulator.c
+ * This file is part of RT-Thread GUI Engine
+ * COPYRIGHT (C) 2006 - 2017, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2019-07-05     onelife      first version
+ * 2019-07-13     onelife      add mock graphic extension ops
+ * 2019-07-14     onelife      add transfer speed of display
+ * 2019-08-24     onelife      add flip and copy control
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "include/rtgui.h"
+
+#ifdef RTGUI_USING_SIMULATOR
+
+#include "include/simulator.h"
+
+#ifdef RT_USING_ULOG
+# define LOG_LVL                    RTGUI_LOG_LEVEL
+# define LOG_TAG                    "GUI_SIM"
+# include "components/utilities/ulog/ulog.h"
+#else /* RT_USING_ULOG */
+# define LOG_E(format, args...)     rt_kprintf(format "\n", ##args)
+# define LOG_D                      LOG_E
+#endif /* RT_USING_ULOG */
+
+/* Private typedef -----------------------------------------------------------*/
+struct rtgui_sim_lcd {
+    struct rt_device parent;
+    struct rt_device_graphic_info info;
+    rt_uint8_t *buffer;                     /* allocated framebuffer */
+    rt_uint32_t pitch;
+    rt_uint8_t bpp;                         /* byte per pixel */
+    struct rtgui_sim_stat stat;
+};
+
+struct rtgui_sim_input {
+    struct rt_device parent;
+    void (*indicator)(void);
+    rt_bool_t ready;                        /* has unread data */
+};
+
+/* Private define ------------------------------------------------------------*/
+#ifndef RTGUI_SIM_PRIORITY
+# define RTGUI_SIM_PRIORITY         (RTGUI_SERVER_PRIORITY)
+#endif
+#ifndef RTGUI_SIM_STACK_SIZE
+# define RTGUI_SIM_STACK_SIZE       (1024)
+#endif
+#define SIM_LINE_SIZE               (64)
+#define LCD_PIXEL(x, y)             (_lcd.info.framebuffer + \
+                                    _lcd.pitch * (y) + _lcd.bpp * (x))
+
+/* Private function prototypes -----------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static struct rtgui_sim_lcd _lcd;
+static struct rtgui_sim_input _touch;
+static struct rtgui_sim_input _key;
+static rtgui_touch_t _touch_data;
+static rtgui_key_t _key_data;
+static rt_bool_t _sim_inited = RT_FALSE;
+static rt_bool_t _sim_playing = RT_FALSE;
+static rt_uint32_t _sim_speed = 0;
+static struct rt_semaphore _sim_done;
+
+/* Private functions ---------------------------------------------------------*/
+static void _lcd_store(rt_uint8_t *ptr, rtgui_color_t pixel, int num) {
+    switch (_lcd.bpp) {
+    case 2:
+        for (; num > 0; num--, ptr += 2)
+            *(rt_uint16_t *)ptr = (rt_uint16_t)pixel;
+        break;
+    case 3:
+        for (; num > 0; num--, ptr += 3) {
+            ptr[0] = pixel & 0xff;
+            ptr[1] = (pixel >> 8) & 0xff;
+            ptr[2] = (pixel >> 16) & 0xff;
+        }
+        break;
+    default:
+        for (; num > 0; num--, ptr += 4)
+            *(rt_uint32_t *)ptr = (rt_uint32_t)pixel;
+        break;
+    }
+}
+
+static void _lcd_count(int pixels) {
+    _lcd.stat.op_calls++;
+    _lcd.stat.op_pixels += pixels;
+}
+
+static void _lcd_set_pixel(rtgui_color_t *c, int x, int y) {
+    _lcd_store(LCD_PIXEL(x, y), *c, 1);
+    _lcd_count(1);
+}
+
+static void _lcd_get_pixel(rtgui_color_t *c, int x, int y) {
+    rt_uint8_t *ptr = LCD_PIXEL(x, y);
+
+    switch (_lcd.bpp) {
+    case 2:
+        *c = *(rt_uint16_t *)ptr;
+        #if (CONFIG_USING_RGB565)
+            /* same as RGB565 device, return rtgui color */
+            if (RTGRAPHIC_PIXEL_FORMAT_RGB565 == _lcd.info.pixel_format)
+                *c = rtgui_color_from_565((rt_uint16_t)*c);
+        #endif
+        break;
+    case 3:
+        *c = ptr[0] | (ptr[1] << 8) | (ptr[2] << 16);
+        break;
+    default:
+        *c = *(rt_uint32_t *)ptr;
+        break;
+    }
+    _lcd_count(0);
+}
+
+static void _lcd_draw_hline(rtgui_color_t *c, int x1, int x2, int y) {
+    _lcd_store(LCD_PIXEL(x1, y), *c, x2 - x1);
+    _lcd_count(x2 - x1);
+}
+
+static void _lcd_draw_vline(rtgui_color_t *c, int x, int y1, int y2) {
+    rt_uint8_t *ptr = LCD_PIXEL(x, y1);
+    int y;
+
+    for (y = y1; y < y2; y++, ptr += _lcd.pitch)
+        _lcd_store(ptr, *c, 1);
+    _lcd_count(y2 - y1);
+}
+
+static void _lcd_draw_raw_hline(rt_uint8_t *pixels, int x1, int x2, int y) {
+    rt_memcpy(LCD_PIXEL(x1, y), pixels, (x2 - x1) * _lcd.bpp);
+    _lcd_count(x2 - x1);
+}
+
+static void _lcd_fill_rect(rtgui_color_t *c, rtgui_rect_t *rect) {
+    rt_uint8_t *ptr = LCD_PIXEL(rect->x1, rect->y1);
+    int w = rect->x2 - rect->x1;
+    int y;
+
+    for (y = rect->y1; y < rect->y2; y++, ptr += _lcd.pitch)
+        _lcd_store(ptr, *c, w);
+    _lcd_count(w * (rect->y2 - rect->y1));
+}
+
+static void _lcd_blit_rect(rt_uint8_t *pixels, rt_uint32_t pitch,
+    rtgui_rect_t *rect) {
+    rt_uint8_t *ptr = LCD_PIXEL(rect->x1, rect->y1);
+    rt_uint32_t size = (rect->x2 - rect->x1) * _lcd.bpp;
+    int y;
+
+    for (y = rect->y1; y < rect->y2; y++, ptr += _lcd.pitch, pixels += pitch)
+        rt_memcpy(ptr, pixels, size);
+    _lcd_count((rect->x2 - rect->x1) * (rect->y2 - rect->y1));
+}
+
+static void _lcd_read_raw_hline(rt_uint8_t *pixels, int x1, int x2, int y) {
+    rt_memcpy(pixels, LCD_PIXEL(x1, y), (x2 - x1) * _lcd.bpp);
+    _lcd_count(0);
+}
+
+#ifdef RTGUI_USING_SIM_EXT_OPS
+/* mock graphic extension ops: same pixels as dc, only counted separately
+ * - coordinates are inclusive */
+static void _lcd_ext_hline(rtgui_color_t pixel, int x1, int x2, int y) {
+    x1 = _MAX(x1, 0);
+    x2 = _MIN(x2, _lcd.info.width - 1);
+    if ((y < 0) || (y >= _lcd.info.height) || (x1 > x2)) return;
+    _lcd_store(LCD_PIXEL(x1, y), pixel, x2 - x1 + 1);
+    _lcd.stat.ext_pixels += x2 - x1 + 1;
+}
+
+/* largest dx of (dx, dy) inside the ellipse, dx of previous row as hint */
+static int _lcd_ext_span(int rx, int ry, int dy, int dx) {
+    rt_int64_t rx2 = (rt_int64_t)rx * rx;
+    rt_int64_t ry2 = (rt_int64_t)ry * ry;
+
+    while ((dx >= 0) && \
+        (((rt_int64_t)dx * dx * ry2 + (rt_int64_t)dy * dy * rx2) > \
+         (rx2 * ry2)))
+        dx--;
+    return dx;
+}
+
+static void _lcd_ext_oval(rtgui_color_t *c, int x, int y, int rx, int ry,
+    rt_bool_t fill) {
+    rtgui_color_t pixel = rtgui_gfx_native_color(*c);
+    int dy, dx, next, left;
+
+    _lcd.stat.ext_calls++;
+    dx = _lcd_ext_span(rx, ry, 0, rx);
+    for (dy = 0; dy <= ry; dy++, dx = next) {
+        next = (dy < ry) ? _lcd_ext_span(rx, ry, dy + 1, dx) : -1;
+        /* outline connects to the span of next row */
+        left = fill ? 0 : _MIN(next + 1, dx);
+        if (!left) {
+            _lcd_ext_hline(pixel, x - dx, x + dx, y + dy);
+            if (dy) _lcd_ext_hline(pixel, x - dx, x + dx, y - dy);
+            continue;
+        }
+        _lcd_ext_hline(pixel, x - dx, x - left, y + dy);
+        _lcd_ext_hline(pixel, x + left, x + dx, y + dy);
+        if (!dy) continue;
+        _lcd_ext_hline(pixel, x - dx, x - left, y - dy);
+        _lcd_ext_hline(pixel, x + left, x + dx, y - dy);
+    }
+}
+
+static void _lcd_ext_draw_line(rtgui_color_t *c, int x1, int y1, int x2,
+    int y2) {
+    rtgui_color_t pixel = rtgui_gfx_native_color(*c);
+    int dx = _ABS(x2 - x1), sx = (x1 < x2) ? 1 : -1;
+    int dy = -_ABS(y2 - y1), sy = (y1 < y2) ? 1 : -1;
+    int err = dx + dy, err2;
+
+    _lcd.stat.ext_calls++;
+    while (1) {
+        _lcd_ext_hline(pixel, x1, x1, y1);
+        if ((x1 == x2) && (y1 == y2)) break;
+        err2 = 2 * err;
+        if (err2 >= dy) {
+            err += dy;
+            x1 += sx;
+        }
+        if (err2 <= dx) {
+            err += dx;
+            y1 += sy;
+        }
+    }
+}
+
+static void _lcd_ext_draw_rect(rtgui_color_t *c, int x1, int y1, int x2,
+    int y2) {
+    rtgui_color_t pixel = rtgui_gfx_native_color(*c);
+    int y;
+
+    _lcd.stat.ext_calls++;
+    _lcd_ext_hline(pixel, x1, x2, y1);
+    if (y2 > y1) _lcd_ext_hline(pixel, x1, x2, y2);
+    for (y = y1 + 1; y < y2; y++) {
+        _lcd_ext_hline(pixel, x1, x1, y);
+        if (x2 > x1) _lcd_ext_hline(pixel, x2, x2, y);
+    }
+}
+
+static void _lcd_ext_fill_rect(rtgui_color_t *c, int x1, int y1, int x2,
+    int y2) {
+    rtgui_color_t pixel = rtgui_gfx_native_color(*c);
+    int y;
+
+    _lcd.stat.ext_calls++;
+    for (y = y1; y <= y2; y++)
+        _lcd_ext_hline(pixel, x1, x2, y);
+}
+
+static void _lcd_ext_draw_circle(rtgui_color_t *c, int x, int y, int r) {
+    _lcd_ext_oval(c, x, y, r, r, RT_FALSE);
+}
+
+static void _lcd_ext_fill_circle(rtgui_color_t *c, int x, int y, int r) {
+    _lcd_ext_oval(c, x, y, r, r, RT_TRUE);
+}
+
+static void _lcd_ext_draw_ellipse(rtgui_color_t *c, int x, int y, int rx,
+    int ry) {
+    _lcd_ext_oval(c, x, y, rx, ry, RT_FALSE);
+}
+
+static void _lcd_ext_fill_ellipse(rtgui_color_t *c, int x, int y, int rx,
+    int ry) {
+    _lcd_ext_oval(c, x, y, rx, ry, RT_TRUE);
+}
+
+static const struct rtgui_graphic_ext_ops _lcd_ext_ops = {
+    _lcd_ext_draw_line,
+    _lcd_ext_draw_rect,
+    _lcd_ext_fill_rect,
+    _lcd_ext_draw_circle,
+    _lcd_ext_fill_circle,
+    _lcd_ext_draw_ellipse,
+    _lcd_ext_fill_ellipse,
+};
+#endif /* RTGUI_USING_SIM_EXT_OPS */
+
+/* native ops, used when not RTGUI_USING_FRAMEBUFFER */
+static const struct rtgui_graphic_driver_ops _lcd_ops = {
+    _lcd_set_pixel,
+    _lcd_get_pixel,
+    _lcd_draw_hline,
+    _lcd_draw_vline,
+    _lcd_draw_raw_hline,
+    _lcd_fill_rect,
+    _lcd_blit_rect,
+    _lcd_read_raw_hline,
+};
+
+static rt_err_t _lcd_control(rt_device_t dev, int cmd, void *args) {
+    (void)dev;
+
+    switch (cmd) {
+    case RTGRAPHIC_CTRL_GET_INFO:
+        rt_memcpy(args, &_lcd.info, sizeof(_lcd.info));
+        break;
+
+    case RTGRAPHIC_CTRL_RECT_UPDATE:
+    {
+        struct rt_device_rect_info *info = args;
+        rt_uint32_t pixels = info->width * info->height;
+        rt_uint32_t ms;
+
+        /* nothing to send, only count */
+        _lcd.stat.updates++;
+        _lcd.stat.update_pixels += pixels;
+        if (!_sim_speed) break;
+
+        /* slow device, the caller is blocked as if waiting for DMA */
+        ms = (pixels + _sim_speed - 1) / _sim_speed;
+        _lcd.stat.update_ms += ms;
+        rt_thread_delay(rt_tick_from_millisecond(ms));
+        break;
+    }
+
+    case RTGUI_GRAPHIC_CTRL_FLIP:
+        /* scan out from the given buffer */
+        _lcd.info.framebuffer = args;
+        _lcd.stat.flips++;
+        break;
+
+    case RTGUI_GRAPHIC_CTRL_COPY:
+    {
+        struct rtgui_gfx_copy_info *info = args;
+        rt_uint32_t len = (info->rect.x2 - info->rect.x1) * _lcd.bpp;
+        rt_int32_t offset = _lcd.pitch * info->dy + _lcd.bpp * info->dx;
+        rt_int32_t pitch = _lcd.pitch;
+        rt_uint8_t *ptr;
+        int y;
+
+        /* not for mono */
+        if (!_lcd.parent.user_data) return -RT_ENOSYS;
+        /* walk rows away from the source */
+        if (info->dy > 0) {
+            ptr = LCD_PIXEL(info->rect.x1, info->rect.y2 - 1);
+            pitch = -pitch;
+        } else {
+            ptr = LCD_PIXEL(info->rect.x1, info->rect.y1);
+        }
+        for (y = info->rect.y1; y < info->rect.y2; y++, ptr += pitch)
+            rt_memmove(ptr, ptr - offset, len);
+        _lcd.stat.copies++;
+        break;
+    }
+
+    #ifdef RTGUI_USING_SIM_EXT_OPS
+    case RTGRAPHIC_CTRL_GET_EXT:
+        /* not for mono */
+        if (!_lcd.parent.user_data) return -RT_ENOSYS;
+        *(const struct rtgui_graphic_ext_ops **)args = &_lcd_ext_ops;
+        break;
+    #endif
+
+    case RTGRAPHIC_CTRL_POWERON:
+    case RTGRAPHIC_CTRL_POWEROFF:
+        break;
+
+    default:
+        return -RT_ENOSYS;
+    }
+
+    return RT_EOK;
+}
+
+static rt_size_t _touch_read(rt_device_t dev, rt_off_t pos, void *buf,
+    rt_size_t size) {
+    rt_size_t num = _touch.ready ? 1 : 0;
+    (void)dev;
+    (void)pos;
+    (void)size;
+
+    /* same as touch device, return the pointer of last data */
+    *(rtgui_touch_t **)buf = &_touch_data;
+    _touch.ready = RT_FALSE;
+    return num;
+}
+
+static rt_size_t _key_read(rt_device_t dev, rt_off_t pos, void *buf,
+    rt_size_t size) {
+    (void)dev;
+    (void)pos;
+    (void)size;
+
+    if (!_key.ready) return 0;
+    rt_memcpy(buf, &_key_data, sizeof(rtgui_key_t));
+    _key.ready = RT_FALSE;
+    return 1;
+}
+
+static rt_err_t _input_control(rt_device_t dev, int cmd, void *args) {
+    struct rtgui_sim_input *input = (struct rtgui_sim_input *)dev;
+
+    if (RT_DEVICE_CTRL_SET_RX_INDICATOR != cmd) return -RT_ENOSYS;
+    input->indicator = (void (*)(void))args;
+    return RT_EOK;
+}
+
+#ifdef RT_USING_DEVICE_OPS
+    static const struct rt_device_ops _lcd_dev_ops = {
+        RT_NULL, RT_NULL, RT_NULL, RT_NULL, RT_NULL, _lcd_control,
+    };
+    static const struct rt_device_ops _touch_dev_ops = {
+        RT_NULL, RT_NULL, RT_NULL, _touch_read, RT_NULL, _input_control,
+    };
+    static const struct rt_device_ops _key_dev_ops = {
+        RT_NULL, RT_NULL, RT_NULL, _key_read, RT_NULL, _input_control,
+    };
+# define _SET_DEVICE_OPS(dev, name, _read, _control) \
+    (dev)->ops = &_##name##_dev_ops
+#else
+# define _SET_DEVICE_OPS(dev, name, _read, _control) { \
+    (dev)->read = _read;                                 \
+    (dev)->control = _control;                           \
+}
+#endif
+
+static void _sim_input_send(struct rtgui_sim_input *input) {
+    input->ready = RT_TRUE;
+    if (input->indicator) input->indicator();
+}
+
+static rt_bool_t _sim_read_line(rtgui_filerw_t *script, char *line,
+    rt_uint32_t size) {
+    rt_uint32_t len = 0;
+    char ch;
+
+    while (1 == rtgui_filerw_read(script, &ch, 1, 1)) {
+        if ('\n' == ch) break;
+        if ((len + 1) < size) line[len++] = ch;
+    }
+    line[len] = '\0';
+    return (len || !rtgui_filerw_eof(script));
+}
+
+static void _sim_skip_space(const char **str) {
+    while ((' ' == **str) || ('\t' == **str) || ('\r' == **str))
+        (*str)++;
+}
+
+static rt_bool_t _sim_get_int(const char **str, int *val) {
+    rt_bool_t neg = RT_FALSE;
+    rt_bool_t got = RT_FALSE;
+
+    _sim_skip_space(str);
+    if ('-' == **str) {
+        neg = RT_TRUE;
+        (*str)++;
+    }
+    for (*val = 0; (**str >= '0') && (**str <= '9'); (*str)++) {
+        *val = *val * 10 + (**str - '0');
+        got = RT_TRUE;
+    }
+    if (neg) *val = -*val;
+    return got;
+}
+
+static rt_bool_t _sim_match(const char **str, const char *word) {
+    rt_size_t len = rt_strlen(word);
+
+    _sim_skip_space(str);
+    if (rt_strncmp(*str, word, len)) return RT_FALSE;
+    if ((*str)[len] && (' ' != (*str)[len]) && ('\t' != (*str)[len]))
+        return RT_FALSE;
+    *str += len;
+    return RT_TRUE;
+}
+
+static void _sim_do_line(const char *line) {
+    rtgui_touch_type_t type = RTGUI_TOUCH_NONE;
+    int delay, x, y;
+
+    _sim_skip_space(&line);
+    if (!*line || ('#' == *line)) return;
+    if (!_sim_get_int(&line, &delay)) {
+        LOG_E("bad script: %s", line);
+        return;
+    }
+    if (delay > 0) rt_thread_delay(rt_tick_from_millisecond(delay));
+
+    if (_sim_match(&line, "down")) {
+        type = RTGUI_TOUCH_DOWN;
+    } else if (_sim_match(&line, "move")) {
+        type = RTGUI_TOUCH_MOTION;
+    } else if (_sim_match(&line, "up")) {
+        type = RTGUI_TOUCH_UP;
+    } else if (_sim_match(&line, "keydown")) {
+        _key_data.type = RTGUI_KEYDOWN;
+    } else if (_sim_match(&line, "keyup")) {
+        _key_data.type = RTGUI_KEYUP;
+    } else {
+        LOG_E("bad event: %s", line);
+        return;
+    }
+
+    if (RTGUI_TOUCH_NONE != type) {
+        /* new session at touch down, id should never be 0 */
+        if (RTGUI_TOUCH_DOWN == type) _touch_data.id++;
+        _touch_data.type = type;
+        if (_sim_get_int(&line, &x) && _sim_get_int(&line, &y)) {
+            _touch_data.point.x = x;
+            _touch_data.point.y = y;
+        }
+        _sim_input_send(&_touch);
+    } else {
+        if (!_sim_get_int(&line, &x)) {
+            LOG_E("no key: %s", line);
+            return;
+        }
+        _key_data.key = (rtgui_kbd_key_t)x;
+        _key_data.mod = _sim_get_int(&line, &y) ? \
+            (rtgui_kbd_mod_t)y : RTGUI_KMOD_NONE;
+        _sim_input_send(&_key);
+    }
+}
+
+static void _sim_play_entry(void *param) {
+    rtgui_filerw_t *script = param;
+    char line[SIM_LINE_SIZE];
+
+    while (_sim_read_line(script, line, sizeof(line)))
+        _sim_do_line(line);
+
+    rtgui_filerw_close(script);
+    _sim_playing = RT_FALSE;
+    (void)rt_sem_release(&_sim_done);
+    LOG_D("script done");
+}
+
+/* Public functions ----------------------------------------------------------*/
+rt_err_t rtgui_sim_init(rt_uint16_t width, rt_uint16_t height,
+    rt_uint8_t pixel_format, rt_uint8_t *framebuffer) {
+    rt_uint8_t bits;
+    rt_err_t ret;
+
+    if (_sim_inited) return -RT_EBUSY;
+
+    switch (pixel_format) {
+    case RTGRAPHIC_PIXEL_FORMAT_MONO:
+        bits = 1;
+        break;
+    case RTGRAPHIC_PIXEL_FORMAT_RGB565:
+    case RTGRAPHIC_PIXEL_FORMAT_RGB565P:
+        bits = 16;
+        break;
+    case RTGRAPHIC_PIXEL_FORMAT_RGB888:
+        bits = RTGUI_RGB888_PIXEL_BITS;
+        break;
+    case RTGRAPHIC_PIXEL_FORMAT_ARGB888:
+        bits = 32;
+        break;
+    default:
+        LOG_E("bad format %d", pixel_format);
+        return -RT_EINVAL;
+    }
+
+    do {
+        rt_memset(&_lcd, 0x00, sizeof(_lcd));
+        _lcd.info.pixel_format = pixel_format;
+        _lcd.info.bits_per_pixel = bits;
+        _lcd.info.width = width;
+        _lcd.info.height = height;
+        _lcd.bpp = _BIT2BYTE(bits);
+        _lcd.pitch = width / 8 * bits;
+        if (!framebuffer) {
+            _lcd.buffer = rtgui_malloc(_lcd.pitch * height);
+            if (!_lcd.buffer) {
+                LOG_E("no mem for fb");
+                ret = -RT_ENOMEM;
+                break;
+            }
+            rt_memset(_lcd.buffer, 0x00, _lcd.pitch * height);
+            framebuffer = _lcd.buffer;
+        }
+        _lcd.info.framebuffer = framebuffer;
+        /* mono is accessed only by framebuffer ops */
+        _lcd.parent.user_data = (1 == bits) ? RT_NULL : (void *)&_lcd_ops;
+        _lcd.parent.type = RT_Device_Class_Graphic;
+        _SET_DEVICE_OPS(&_lcd.parent, lcd, RT_NULL, _lcd_control);
+        ret = rt_device_register(&_lcd.parent, RTGUI_SIM_LCD_NAME,
+            RT_DEVICE_FLAG_RDWR);
+        if (RT_EOK != ret) break;
+
+        rt_memset(&_touch, 0x00, sizeof(_touch));
+        _touch.parent.type = RT_Device_Class_Char;
+        _SET_DEVICE_OPS(&_touch.parent, touch, _touch_read, _input_control);
+        ret = rt_device_register(&_touch.parent, RTGUI_SIM_TOUCH_NAME,
+            RT_DEVICE_FLAG_RDONLY);
+        if (RT_EOK != ret) break;
+
+        rt_memset(&_key, 0x00, sizeof(_key));
+        _key.parent.type = RT_Device_Class_Char;
+        _SET_DEVICE_OPS(&_key.parent, key, _key_read, _input_control);
+        ret = rt_device_register(&_key.parent, RTGUI_SIM_KEY_NAME,
+            RT_DEVICE_FLAG_RDONLY);
+        if (RT_EOK != ret) break;
+
+        ret = rt_sem_init(&_sim_done, "sim_done", 0, RT_IPC_FLAG_FIFO);
+        if (RT_EOK != ret) break;
+
+        _sim_inited = RT_TRUE;
+    } while (0);
+
+    if ((RT_EOK != ret) && _lcd.buffer) {
+        rtgui_free(_lcd.buffer);
+        _lcd.buffer = RT_NULL;
+    }
+    return ret;
+}
+RTM_EXPORT(rtgui_sim_init);
+
+void rtgui_sim_get_stat(struct rtgui_sim_stat *stat, rt_bool_t reset) {
+    if (stat)
+        rt_memcpy(stat, &_lcd.stat, sizeof(_lcd.stat));
+    if (reset)
+        rt_memset(&_lcd.stat, 0x00, sizeof(_lcd.stat));
+}
+RTM_EXPORT(rtgui_sim_get_stat);
+
+rt_uint8_t *rtgui_sim_get_scanout(void) {
+    return _lcd.info.framebuffer;
+}
+RTM_EXPORT(rtgui_sim_get_scanout);
+
+void rtgui_sim_set_speed(rt_uint32_t pixels_per_ms) {
+    _sim_speed = pixels_per_ms;
+}
+RTM_EXPORT(rtgui_sim_set_speed);
+
+rt_err_t rtgui_sim_play(rtgui_filerw_t *script) {
+    rt_thread_t tid;
+
+    if (!_sim_inited || !script) return -RT_EINVAL;
+    if (_sim_playing) return -RT_EBUSY;
+
+    _sim_playing = RT_TRUE;
+    tid = rt_thread_create("gui_sim", _sim_play_entry, script,
+        RTGUI_SIM_STACK_SIZE, RTGUI_SIM_PRIORITY, RTGUI_SERVER_TIMESLICE);
+    if (!tid) {
+        _sim_playing = RT_FALSE;
+        LOG_E("create sim failed");
+        return -RT_ENOMEM;
+    }
+    return rt_thread_startup(tid);
+}
+RTM_EXPORT(rtgui_sim_play);
+
+rt_err_t rtgui_sim_wait(rt_int32_t timeout) {
+    if (!_sim_inited) return -RT_EINVAL;
+    return rt_sem_take(&_sim_done, timeout);
+}
+RTM_EXPORT(rtgui_sim_wait);
+
+#endif /* RTGUI_USING_SIMULATOR */
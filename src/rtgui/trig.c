@@ -0,0 +1,106 @@
+/*
+ * File      : trig.c
+ * This file is part of RT-Thread GUI Engine
+ * COPYRIGHT (C) 2006 - 2017, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2019-07-12     onelife      first version
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "include/trig.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define ANGLE_90                            RTGUI_ANGLE(90)
+#define ANGLE_360                           RTGUI_ANGLE(360)
+#define ANGLE_MASK                          ((1 << RTGUI_ANGLE_SHIFT) - 1)
+
+/* Private function prototypes -----------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* sin(0 - 90 degree) in Q15 */
+static const rt_uint16_t sin_table[91] = {
+        0,   572,  1144,  1715,  2286,  2856,  3425,  3993,  4560,  5126,
+     5690,  6252,  6813,  7371,  7927,  8481,  9032,  9580, 10126, 10668,
+    11207, 11743, 12275, 12803, 13328, 13848, 14365, 14876, 15384, 15886,
+    16384, 16877, 17364, 17847, 18324, 18795, 19261, 19720, 20174, 20622,
+    21063, 21498, 21926, 22348, 22763, 23170, 23571, 23965, 24351, 24730,
+    25102, 25466, 25822, 26170, 26510, 26842, 27166, 27482, 27789, 28088,
+    28378, 28660, 28932, 29197, 29452, 29698, 29935, 30163, 30382, 30592,
+    30792, 30983, 31164, 31336, 31499, 31651, 31795, 31928, 32052, 32166,
+    32270, 32365, 32449, 32524, 32588, 32643, 32688, 32723, 32748, 32763,
+    32768,
+};
+
+/* Private functions ---------------------------------------------------------*/
+/* sin of angle in [0, 90] degree */
+static rt_int32_t _quarter_sin(rt_int32_t angle) {
+    rt_int32_t idx = angle >> RTGUI_ANGLE_SHIFT;
+    rt_int32_t frac = angle & ANGLE_MASK;
+
+    if (!frac) return sin_table[idx];
+    return sin_table[idx] + (((sin_table[idx + 1] - sin_table[idx]) * frac) >>
+        RTGUI_ANGLE_SHIFT);
+}
+
+/* Public functions ----------------------------------------------------------*/
+rt_int32_t rtgui_sin(rt_int32_t angle) {
+    angle %= ANGLE_360;
+    if (angle < 0) angle += ANGLE_360;
+
+    if (angle <= ANGLE_90)
+        return _quarter_sin(angle);
+    else if (angle <= 2 * ANGLE_90)
+        return _quarter_sin(2 * ANGLE_90 - angle);
+    else if (angle <= 3 * ANGLE_90)
+        return -_quarter_sin(angle - 2 * ANGLE_90);
+    return -_quarter_sin(ANGLE_360 - angle);
+}
+RTM_EXPORT(rtgui_sin);
+
+rt_int32_t rtgui_cos(rt_int32_t angle) {
+    return rtgui_sin(angle + ANGLE_90);
+}
+RTM_EXPORT(rtgui_cos);
+
+rt_int32_t rtgui_sin_mul(rt_int32_t angle, rt_int32_t r) {
+    return (rtgui_sin(angle) * r) / RTGUI_TRIG_ONE;
+}
+RTM_EXPORT(rtgui_sin_mul);
+
+rt_int32_t rtgui_cos_mul(rt_int32_t angle, rt_int32_t r) {
+    return (rtgui_cos(angle) * r) / RTGUI_TRIG_ONE;
+}
+RTM_EXPORT(rtgui_cos_mul);
+
+rt_uint32_t rtgui_isqrt(rt_uint32_t n) {
+    rt_uint32_t root = 0;
+    rt_uint32_t bit = 1UL << 30;
+
+    while (bit > n) bit >>= 2;
+    while (bit) {
+        if (n >= root + bit) {
+            n -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+RTM_EXPORT(rtgui_isqrt);
@@ -99,6 +99,7 @@ static rt_bool_t _button_event_handler(void *obj, rtgui_evt_generic_t *evt) {
 
     switch (evt->base.type) {
     case RTGUI_EVENT_PAINT:
+        if (rtgui_dc_list_replay(TO_WIDGET(obj))) break;
         _theme_draw_button(btn);
         break;
 
@@ -113,6 +114,7 @@ static rt_bool_t _button_event_handler(void *obj, rtgui_evt_generic_t *evt) {
         else
             BUTTON_FLAG_CLEAR(btn, PRESS);
 
+        rtgui_dc_list_dirty(TO_WIDGET(btn));
         rtgui_widget_update(TO_WIDGET(btn));
 
         if (!IS_BUTTON_FLAG(btn, PRESS) && btn->on_button)
@@ -128,6 +130,7 @@ static rt_bool_t _button_event_handler(void *obj, rtgui_evt_generic_t *evt) {
             /* not on this btn */
             BUTTON_FLAG_CLEAR(btn, PRESS);
             LOG_D("unpress btn");
+            rtgui_dc_list_dirty(TO_WIDGET(btn));
             rtgui_widget_update(TO_WIDGET(btn));
             break;
         }
@@ -142,6 +145,7 @@ static rt_bool_t _button_event_handler(void *obj, rtgui_evt_generic_t *evt) {
                 BUTTON_FLAG_SET(btn, PRESS);
 
             LOG_D("push btn press: %d", IS_BUTTON_FLAG(btn, PRESS));
+            rtgui_dc_list_dirty(TO_WIDGET(btn));
             rtgui_widget_update(TO_WIDGET(btn));
             if (btn->on_button)
                 (void)btn->on_button(TO_OBJECT(btn), evt);
@@ -174,6 +178,7 @@ static rt_bool_t _button_event_handler(void *obj, rtgui_evt_generic_t *evt) {
             }
 
             LOG_I("btn press: %d", IS_BUTTON_FLAG(btn, PRESS));
+            rtgui_dc_list_dirty(TO_WIDGET(btn));
             rtgui_widget_update(TO_WIDGET(btn));
             if (do_call && btn->on_button)
                 btn->on_button(TO_WIDGET(btn), evt);
@@ -177,8 +177,10 @@ static void _list_draw_current_item(rtgui_dc_t *dc, void *obj,
         last_idx = 0;
 
     /* if not in same page then update all */
-    if ((last_idx / list->page_sz) != (list->current / list->page_sz))
+    if ((last_idx / list->page_sz) != (list->current / list->page_sz)) {
+        rtgui_dc_list_dirty(wgt);
         return rtgui_widget_update(wgt);
+    }
 
     rtgui_widget_get_rect(wgt, &rect);
     /* last item rect */
@@ -209,6 +211,7 @@ static rt_bool_t _list_event_handler(void *obj, rtgui_evt_generic_t *evt) {
 
     switch (evt->base.type) {
     case RTGUI_EVENT_PAINT:
+        if (rtgui_dc_list_replay(TO_WIDGET(obj))) break;
         _list_draw(obj);
         break;
 
@@ -363,6 +366,7 @@ void rtgui_list_set_items(rtgui_list_t *list, rtgui_list_item_t *items,
     rt_uint16_t count) {
     _list_set_items(list, items, count);
     list->current = -1;
+    rtgui_dc_list_dirty(TO_WIDGET(list));
     rtgui_widget_update(TO_WIDGET(list));
 }
 RTM_EXPORT(rtgui_list_set_items);
@@ -73,6 +73,7 @@ static rt_bool_t _progress_event_handler(void *obj, rtgui_evt_generic_t *evt) {
 
     switch (evt->base.type) {
     case RTGUI_EVENT_PAINT:
+        if (rtgui_dc_list_replay(TO_WIDGET(obj))) break;
         _theme_draw_progress(bar);
         break;
 
@@ -168,6 +169,7 @@ rtgui_progress_t *rtgui_create_progress(rtgui_container_t *cntr,
 void rtgui_progress_set_range(rtgui_progress_t *bar, rt_uint16_t range) {
     if (bar->range != range) {
         bar->range = range;
+        rtgui_dc_list_dirty(TO_WIDGET(bar));
         rtgui_widget_update(TO_WIDGET(bar));
     }
 }
@@ -178,6 +180,7 @@ RTGUI_MEMBER_GETTER(rtgui_progress_t, progress, rt_uint16_t, range);
 void rtgui_progress_set_value(rtgui_progress_t *bar, rt_uint16_t value) {
     if (bar->value != value) {
         bar->value = value;
+        rtgui_dc_list_dirty(TO_WIDGET(bar));
         rtgui_widget_update(TO_WIDGET(bar));
     }
 }
@@ -85,6 +85,7 @@ static rt_bool_t _title_event_handler(void *obj, rtgui_evt_generic_t *evt) {
 
     switch (evt->base.type) {
     case RTGUI_EVENT_PAINT:
+        if (rtgui_dc_list_replay(TO_WIDGET(obj))) break;
         _theme_draw_title(title_);
         break;
 
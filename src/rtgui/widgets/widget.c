@@ -82,6 +82,9 @@ static void _widget_constructor(void *obj) {
     wgt->gc.textalign = RTGUI_ALIGN_LEFT | RTGUI_ALIGN_TOP;
     wgt->gc.font = rtgui_font_default();
     rtgui_dc_client_init(wgt);
+#ifdef RTGUI_USING_DISPLAY_LIST
+    wgt->dlist = RT_NULL;
+#endif
 
     wgt->user_data = 0;
 }
@@ -98,6 +101,9 @@ static void _widget_destructor(void *obj) {
 
     /* uninit clip region */
     rtgui_region_uninit(&(wgt->clip));
+#ifdef RTGUI_USING_DISPLAY_LIST
+    rtgui_dc_list_detach(wgt);
+#endif
 }
 
 static rt_bool_t _widget_event_handler(void *obj, rtgui_evt_generic_t *evt) {
@@ -234,6 +240,7 @@ void rtgui_widget_set_rect(rtgui_widget_t *wgt, const rtgui_rect_t *rect) {
     /* reset min_width and min_height */
     wgt->min_width  = RECT_W(wgt->extent);
     wgt->min_height = RECT_H(wgt->extent);
+    rtgui_dc_list_dirty(wgt);
 
     /* reset clip */
     if (rtgui_region_not_empty(&(wgt->clip)))
@@ -471,7 +478,17 @@ RTM_EXPORT(rtgui_widget_unfocus);
 /*
  * This function updates the clip info of widget
  */
-void rtgui_widget_update_clip(rtgui_widget_t *wgt) {
+/* move the updated clips out of region arena */
+static void _widget_keep_clip(rtgui_widget_t *wgt) {
+    rt_slist_t *node;
+
+    rtgui_region_arena_keep(&(wgt->clip));
+    if (!IS_CONTAINER(wgt)) return;
+    rt_slist_for_each(node, &(TO_CONTAINER(wgt)->children))
+        _widget_keep_clip(rt_slist_entry(node, rtgui_widget_t, sibling));
+}
+
+static void _widget_update_clip(rtgui_widget_t *wgt) {
     rtgui_widget_t *parent;
     rt_slist_t *node;
 
@@ -507,10 +524,29 @@ void rtgui_widget_update_clip(rtgui_widget_t *wgt) {
         rt_slist_for_each(node, &(TO_CONTAINER(wgt)->children)) {
             rtgui_widget_t *child = \
                 rt_slist_entry(node, rtgui_widget_t, sibling);
-            rtgui_widget_update_clip(child);
+            _widget_update_clip(child);
         }
     }
 }
+
+void rtgui_widget_update_clip(rtgui_widget_t *wgt) {
+    rtgui_widget_t *parent;
+
+    if (!rtgui_region_arena_begin()) {
+        /* nested or arena in use */
+        _widget_update_clip(wgt);
+        rtgui_region_arena_end();
+        return;
+    }
+
+    _widget_update_clip(wgt);
+    if (wgt) {
+        _widget_keep_clip(wgt);
+        for (parent = wgt->parent; parent; parent = parent->parent)
+            rtgui_region_arena_keep(&(parent->clip));
+    }
+    rtgui_region_arena_end();
+}
 RTM_EXPORT(rtgui_widget_update_clip);
 
 void rtgui_widget_show(rtgui_widget_t *wgt) {
@@ -567,6 +603,23 @@ void rtgui_widget_update(rtgui_widget_t *wgt) {
         RTGUI_CREATE_EVENT(evt, PAINT, RT_WAITING_FOREVER);
         if (!evt) break;
         evt->paint.wid = RT_NULL;
+        #ifdef RTGUI_USING_BAND_BUFFER
+            /* transparent widget doesn't draw all pixels */
+            if (!IS_WIDGET_FLAG(wgt, TRANSPARENT)) {
+                /* one update for all bands, nested drawing sends none */
+                rtgui_dc_t *dc = rtgui_dc_begin_drawing(wgt);
+
+                if (dc && rtgui_gfx_band_start(&(wgt->extent))) {
+                    /* redraw for each band */
+                    do {
+                        (void)EVENT_HANDLER(wgt)(wgt, evt);
+                    } while (rtgui_gfx_band_next());
+                } else {
+                    (void)EVENT_HANDLER(wgt)(wgt, evt);
+                }
+                if (dc) rtgui_dc_end_drawing(dc, RT_TRUE);
+            } else
+        #endif
         (void)EVENT_HANDLER(wgt)(wgt, evt);
         RTGUI_FREE_EVENT(evt);
     } while (0);
@@ -216,6 +216,27 @@ static rt_bool_t _win_ondraw(rtgui_win_t *win, rtgui_evt_generic_t *evt) {
     if (SUPER_CLASS_HANDLER(win)) {
         LOG_D("ondraw, wid %p", evt->paint.wid);
         evt->paint.wid = RT_NULL;
+        #ifdef RTGUI_USING_BAND_BUFFER
+        {
+            /* one update for all bands, nested drawing sends none */
+            rtgui_dc_t *dc = rtgui_dc_begin_drawing(TO_WIDGET(win));
+
+            if (dc) {
+                rt_bool_t done;
+
+                if (rtgui_gfx_band_start(&(TO_WIDGET(win)->extent))) {
+                    /* redraw for each band */
+                    do {
+                        done = SUPER_CLASS_HANDLER(win)(win, evt);
+                    } while (rtgui_gfx_band_next());
+                } else {
+                    done = SUPER_CLASS_HANDLER(win)(win, evt);
+                }
+                rtgui_dc_end_drawing(dc, RT_TRUE);
+                return done;
+            }
+        }
+        #endif
         return SUPER_CLASS_HANDLER(win)(win, evt);
     }
     return RT_FALSE;
@@ -279,6 +300,7 @@ static rt_bool_t _win_event_handler(void *obj, rtgui_evt_generic_t *evt) {
         if (IS_WIN_FLAG(win, IN_MODAL) || !IS_WIDGET_FLAG(win, SHOWN)) break;
 
         WIN_FLAG_SET(win, ACTIVATE);
+        rtgui_dc_list_dirty(TO_WIDGET(win->_title));
         /* There are many cases where the paint event will follow this activate
          * event and just repaint the title is not a big deal. So just repaint
          * the title if there is one. If you want to update the content of the
@@ -289,6 +311,7 @@ static rt_bool_t _win_event_handler(void *obj, rtgui_evt_generic_t *evt) {
 
     case RTGUI_EVENT_WIN_DEACTIVATE:
         WIN_FLAG_CLEAR(win, ACTIVATE);
+        rtgui_dc_list_dirty(TO_WIDGET(win->_title));
         /* No paint event follow the deactive event. So we have to update
          * the title manually to reflect the change. */
         if (win->_title) rtgui_widget_update(TO_WIDGET(win->_title));
@@ -681,5 +704,7 @@ void rtgui_win_set_title(rtgui_win_t *win, const char *title) {
     if (title) {
         win->title = rt_strdup(title);
     }
+    /* the recorded title is stale */
+    if (win->_title) rtgui_dc_list_dirty(TO_WIDGET(win->_title));
 }
 RTM_EXPORT(rtgui_win_set_title);